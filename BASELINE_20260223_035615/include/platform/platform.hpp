@@ -9,6 +9,7 @@ using socket_t = SOCKET;
 constexpr socket_t INVALID_SOCKET_FD = INVALID_SOCKET;
 #else
 #include <sys/socket.h>
+#include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <unistd.h>
 #include <fcntl.h>
@@ -32,4 +33,44 @@ bool socket_shutdown(socket_t s);
 void socket_close(socket_t s);
 void sleep_us(uint64_t usec);
 uint64_t monotonic_time_us();
+
+// Name resolution and connection setup (IPv4)
+bool resolve_ipv4(const char* host, uint16_t port, sockaddr_in& out);
+int socket_connect(socket_t s, const sockaddr_in& addr);   // 0, or -1 and last_error()
+bool connect_in_progress(int err);                         // non-blocking connect pending
+bool socket_listen(socket_t s, uint16_t port, int backlog);
+socket_t socket_accept(socket_t s);
+int wait_readable(socket_t s, int timeout_ms);             // 1 ready, 0 timeout, -1 error
+int wait_writable(socket_t s, int timeout_ms);             // 1 ready, 0 timeout, -1 error
+
+// Low-latency socket options. Each returns false where the OS has no
+// equivalent or refuses it (SO_BUSY_POLL above the sysctl needs CAP_NET_ADMIN).
+bool set_quickack(socket_t s);                             // Linux clears it again; re-arm after reads
+bool set_busy_poll(socket_t s, int usec);
+bool set_rcvbuf(socket_t s, int bytes);
+bool set_sndbuf(socket_t s, int bytes);
+
+// Clocks
+uint64_t monotonic_time_ns();
+uint64_t monotonic_raw_time_ns();                          // not slewed by NTP; for intervals
+uint64_t realtime_ns();                                    // epoch
+
+// Calling thread
+bool set_thread_name(const char* name);                    // Linux keeps 15 chars
+bool pin_thread(int cpu);
+int cpu_count();
+
+// Shared read/write file mapping. The file is created, or extended, to at
+// least size bytes (sparse where the filesystem allows). Stores reach the
+// file through the page cache: they survive a process crash without any
+// flush; flush_file() only matters for power loss.
+struct mapped_file {
+    void* data = nullptr;
+    uint64_t size = 0;
+    intptr_t file = -1;                                    // fd / HANDLE
+    intptr_t mapping = 0;                                  // Windows mapping HANDLE
+};
+bool map_file(const char* path, uint64_t size, mapped_file& out);
+void unmap_file(mapped_file& m);
+bool flush_file(mapped_file& m, bool wait);                // wait: block until written
 }
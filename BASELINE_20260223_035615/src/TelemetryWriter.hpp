@@ -4,6 +4,15 @@
 #include <cstdint>
 #include <cstring>
 
+constexpr uint32_t TELEMETRY_MAX_SYMBOLS = 64;
+
+struct TelemetryQuote
+{
+    char symbol[16];
+    double bid;
+    double ask;
+};
+
 struct TelemetrySnapshot
 {
     std::atomic<uint64_t> sequence;
@@ -35,6 +44,10 @@ struct TelemetrySnapshot
 
     char hft_trigger[32];
     char strategy_trigger[32];
+
+    // Every subscribed symbol, by symbol directory handle
+    uint32_t symbol_count;
+    TelemetryQuote quotes[TELEMETRY_MAX_SYMBOLS];
 };
 
 class TelemetryWriter
@@ -43,6 +56,21 @@ private:
     HANDLE m_map;
     TelemetrySnapshot* m_snap;
 
+    // Single writer (the quote thread): sequence is odd while fields change,
+    // so a reader that sees an odd or changed sequence copies again
+    void BeginWrite()
+    {
+        uint64_t seq = m_snap->sequence.load(std::memory_order_relaxed);
+        m_snap->sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void EndWrite()
+    {
+        uint64_t seq = m_snap->sequence.load(std::memory_order_relaxed);
+        m_snap->sequence.store(seq + 1, std::memory_order_release);
+    }
+
 public:
     TelemetryWriter() : m_map(nullptr), m_snap(nullptr) {}
 
@@ -102,7 +130,7 @@ public:
     {
         if (!m_snap) return;
 
-        uint64_t seq = m_snap->sequence.load(std::memory_order_relaxed);
+        BeginWrite();
 
         m_snap->xau_bid = xau_bid;
         m_snap->xau_ask = xau_ask;
@@ -122,6 +150,35 @@ public:
         strcpy_s(m_snap->hft_trigger, hft_trigger);
         strcpy_s(m_snap->strategy_trigger, strategy_trigger);
 
-        m_snap->sequence.store(seq + 1, std::memory_order_release);
+        EndWrite();
+    }
+
+    // Names a quote slot; called once per symbol when the SecurityList is in
+    void SetSymbol(uint32_t handle, const char* symbol)
+    {
+        if (!m_snap || handle >= TELEMETRY_MAX_SYMBOLS) return;
+        BeginWrite();
+        strncpy_s(m_snap->quotes[handle].symbol, symbol, _TRUNCATE);
+        if (handle >= m_snap->symbol_count) m_snap->symbol_count = handle + 1;
+        EndWrite();
+    }
+
+    void UpdateQuote(uint32_t handle, double bid, double ask)
+    {
+        if (!m_snap || handle >= TELEMETRY_MAX_SYMBOLS) return;
+
+        BeginWrite();
+        m_snap->quotes[handle].bid = bid;
+        m_snap->quotes[handle].ask = ask;
+        EndWrite();
+    }
+
+    // Median broker-to-us feed latency in ms (SendingTime vs receive time)
+    void UpdateFeedLatency(double vps_latency_ms)
+    {
+        if (!m_snap) return;
+        BeginWrite();
+        m_snap->vps_latency = vps_latency_ms;
+        EndWrite();
     }
 };
@@ -3,6 +3,7 @@
 #include "../../engines/StopRunDetector.hpp"
 #include "../../engines/LiquidityVacuum.hpp"
 #include "../../engines/SessionBias.hpp"
+#include "../../../../include/core/FixTime.hpp"
 
 #include <iostream>
 
@@ -11,7 +12,7 @@ namespace chimera {
 ExecutionBridgeFix::ExecutionBridgeFix(double max_usd, FixAdapter* fix)
     : m_allocator(max_usd),
       m_fix(fix),
-      m_client_id_seq(1) {}
+      m_client_id_seq(static_cast<uint64_t>(fixWallClockNs() / 1000)) {}
 
 void ExecutionBridgeFix::on_latency_sample(const LatencySample& s) {
     m_latency.push(s);
@@ -34,6 +34,8 @@ private:
     SignalFusion m_fusion;
     FixAdapter* m_fix;
 
+    // ClOrdID (11); starts at the wall clock in microseconds so ids are not
+    // reused across restarts
     uint64_t m_client_id_seq;
 };
 
@@ -16,6 +16,19 @@ public:
                                 bool post_only,
                                 uint64_t client_order_id,
                                 uint64_t send_ts_ns) = 0;
+
+    // Cancels the order sent as orig_client_order_id; client_order_id
+    // identifies the cancel request itself
+    virtual void send_cancel(uint64_t orig_client_order_id,
+                             uint64_t client_order_id,
+                             uint64_t send_ts_ns) = 0;
+
+    // Replaces price and size of a live order
+    virtual void send_replace(uint64_t orig_client_order_id,
+                              uint64_t client_order_id,
+                              double price,
+                              double notional_usd,
+                              uint64_t send_ts_ns) = 0;
 };
 
 }
@@ -0,0 +1,270 @@
+#include "FixOrderEntry.hpp"
+
+#include "../../../latency/LatencyAttributionEngine.hpp"
+#include "../../../../include/core/FixNumeric.hpp"
+
+#include <cmath>
+#include <iostream>
+
+namespace chimera {
+
+FixOrderEntry::FixOrderEntry(const FixSessionIds& ids,
+                             FixOrderWire& wire,
+                             LatencyAttributionEngine* latency)
+    : m_ids(ids),
+      m_wire(wire),
+      m_latency(latency),
+      m_limit("40=2\x01" "59=1\x01"),
+      m_limit_post("40=2\x01" "59=1\x01" "18=6\x01"),
+      m_sent(0),
+      m_failures(0),
+      m_last_send_ts_ns(0),
+      m_collisions(0),
+      m_rejects(0) {}
+
+void FixOrderEntry::add_symbol(const std::string& symbol,
+                               const std::string& fix_symbol,
+                               int price_digits,
+                               int qty_digits,
+                               int64_t min_qty) {
+    Symbol s;
+    s.name = symbol;
+    int64_t fix_id = 0;
+    if (parseFixInt(fix_symbol, fix_id) == FixNumError::None && fix_id > 0 && fix_id <= UINT16_MAX)
+        s.fix_id = static_cast<uint16_t>(fix_id);
+    s.digits = price_digits;
+    s.qty_digits = qty_digits < 0 ? 0 : (qty_digits > FixOrder::QTY_DIGITS ? FixOrder::QTY_DIGITS : qty_digits);
+    s.min_qty = min_qty > 0 ? min_qty : 1;
+    for (int side = 0; side < 2; ++side) {
+        std::string body = "55=" + fix_symbol + "\x01" "54=" + (side == 0 ? "1" : "2") + "\x01";
+        s.new_order[side] = FixMsgTemplate(m_ids, "D", body);
+        s.cancel[side] = FixMsgTemplate(m_ids, "F", body);
+        s.replace[side] = FixMsgTemplate(m_ids, "G", body);
+    }
+    m_symbols.push_back(std::move(s));
+}
+
+int FixOrderEntry::find_symbol(const std::string& name) const {
+    for (size_t i = 0; i < m_symbols.size(); ++i) {
+        if (m_symbols[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+FixOrderEntry::LiveOrder& FixOrderEntry::slot(uint64_t client_order_id) {
+    return m_live[client_order_id % MAX_LIVE];
+}
+
+FixOrderEntry::LiveOrder* FixOrderEntry::find_live(uint64_t client_order_id) {
+    LiveOrder& o = slot(client_order_id);
+    return o.client_order_id == client_order_id ? &o : nullptr;
+}
+
+// The slot for a new ClOrdID, null while it holds another working order;
+// send_lock() held
+FixOrderEntry::LiveOrder* FixOrderEntry::claim(uint64_t client_order_id) {
+    LiveOrder& o = slot(client_order_id);
+    if (o.client_order_id != 0 && o.client_order_id != client_order_id) {
+        m_collisions.fetch_add(1, std::memory_order_relaxed);
+        std::cout << "[FIX] REJECT LOCAL: ClOrdID " << client_order_id
+                  << " slot held by working order " << o.client_order_id << "\n";
+        return nullptr;
+    }
+    return &o;
+}
+
+void FixOrderEntry::release(uint64_t client_order_id) {
+    std::lock_guard<std::mutex> g(m_wire.send_lock());
+    if (LiveOrder* o = find_live(client_order_id)) *o = LiveOrder();
+}
+
+void FixOrderEntry::reject(const std::string& symbol, const char* why) {
+    m_rejects.fetch_add(1, std::memory_order_relaxed);
+    std::cout << "[FIX] REJECT LOCAL: " << symbol << " " << why << "\n";
+}
+
+// Notional in qty_digits steps, rounded down so the order never exceeds it;
+// 0 below min_qty
+int64_t FixOrderEntry::to_qty(const Symbol& s, double price, double notional_usd) const {
+    if (price <= 0.0 || notional_usd <= 0.0) return 0;
+    double steps = notional_usd / price * static_cast<double>(fixPow10(s.qty_digits));
+    int64_t qty = static_cast<int64_t>(steps + 1e-9);
+    return qty >= s.min_qty ? qty : 0;
+}
+
+// Returns the wire time, 0 if the write failed
+uint64_t FixOrderEntry::write(std::string_view msg) {
+    if (msg.empty() || !m_wire.write(msg)) {
+        m_failures.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+    uint64_t wire_ts = static_cast<uint64_t>(fixWallClockNs());
+    m_sent.fetch_add(1, std::memory_order_relaxed);
+    m_last_send_ts_ns.store(wire_ts, std::memory_order_relaxed);
+    return wire_ts;
+}
+
+void FixOrderEntry::send_new_order(const std::string& symbol,
+                                   const std::string& side,
+                                   double price,
+                                   double notional_usd,
+                                   bool post_only,
+                                   uint64_t client_order_id,
+                                   uint64_t send_ts_ns) {
+    int si = find_symbol(symbol);
+    if (si < 0) {
+        reject(symbol, "unknown symbol");
+        return;
+    }
+    const Symbol& s = m_symbols[si];
+    int side_idx = side == "SELL" ? 1 : 0;
+    int64_t qty = to_qty(s, price, notional_usd);
+    if (qty == 0) {
+        reject(symbol, "size below min qty");
+        return;
+    }
+    int64_t ticks = std::llround(price * static_cast<double>(fixPow10(s.digits)));
+
+    uint64_t wire_ts = 0;
+    {
+        std::lock_guard<std::mutex> g(m_wire.send_lock());
+        LiveOrder* live = claim(client_order_id);
+        if (!live) return;
+        const FixMsgTemplate& t = s.new_order[side_idx];
+        int64_t now = fixWallClockNs();
+        std::string_view msg = m_enc.begin(t, m_wire.next_seq(), now)
+                                    .field(11, static_cast<int64_t>(client_order_id))
+                                    .body(t)
+                                    .timestamp(60, now, t.sendingTimePrecision())
+                                    .price(38, qty, s.qty_digits)
+                                    .fields(post_only ? m_limit_post : m_limit)
+                                    .price(44, ticks, s.digits)
+                                    .finish();
+        wire_ts = write(msg);
+        if (wire_ts) {
+            live->client_order_id = client_order_id;
+            live->symbol = si;
+            live->side = side_idx;
+            live->qty = qty;
+            live->price_ticks = ticks;
+            live->post_only = post_only;
+
+            FixOrderNote note;
+            note.id = client_order_id;
+            note.qty = qty * fixPow10(FixOrder::QTY_DIGITS - s.qty_digits);
+            note.price = ticks;
+            note.symbol = s.fix_id;
+            note.digits = static_cast<uint8_t>(s.digits);
+            note.side = side_idx == 0 ? '1' : '2';
+            m_wire.on_sent(note);
+        }
+    }
+
+    if (wire_ts && m_latency) {
+        m_latency->on_submit(symbol, client_order_id, send_ts_ns, wire_ts,
+                             price, static_cast<double>(qty) / fixPow10(s.qty_digits));
+    }
+}
+
+void FixOrderEntry::send_cancel(uint64_t orig_client_order_id,
+                                uint64_t client_order_id,
+                                uint64_t send_ts_ns) {
+    (void)send_ts_ns;
+    std::lock_guard<std::mutex> g(m_wire.send_lock());
+    LiveOrder* o = find_live(orig_client_order_id);
+    if (!o) {
+        std::cout << "[FIX] CANCEL: unknown ClOrdID " << orig_client_order_id << "\n";
+        return;
+    }
+    const Symbol& s = m_symbols[o->symbol];
+    const FixMsgTemplate& t = s.cancel[o->side];
+    int64_t now = fixWallClockNs();
+    std::string_view msg = m_enc.begin(t, m_wire.next_seq(), now)
+                                .field(41, static_cast<int64_t>(orig_client_order_id))
+                                .field(11, static_cast<int64_t>(client_order_id))
+                                .body(t)
+                                .timestamp(60, now, t.sendingTimePrecision())
+                                .price(38, o->qty, s.qty_digits)
+                                .finish();
+    if (write(msg)) {
+        FixOrderNote note;
+        note.id = client_order_id;
+        note.orig_id = orig_client_order_id;
+        note.qty = o->qty * fixPow10(FixOrder::QTY_DIGITS - s.qty_digits);
+        note.symbol = s.fix_id;
+        note.digits = static_cast<uint8_t>(s.digits);
+        note.side = o->side == 0 ? '1' : '2';
+        note.kind = FixOrdKind::Cancel;
+        m_wire.on_sent(note);
+    }
+}
+
+void FixOrderEntry::send_replace(uint64_t orig_client_order_id,
+                                 uint64_t client_order_id,
+                                 double price,
+                                 double notional_usd,
+                                 uint64_t send_ts_ns) {
+    std::string symbol;
+    int64_t qty = 0;
+    int qty_digits = 0;
+    uint64_t wire_ts = 0;
+    {
+        std::lock_guard<std::mutex> g(m_wire.send_lock());
+        LiveOrder* o = find_live(orig_client_order_id);
+        if (!o) {
+            std::cout << "[FIX] REPLACE: unknown ClOrdID " << orig_client_order_id << "\n";
+            return;
+        }
+        const Symbol& s = m_symbols[o->symbol];
+        qty = to_qty(s, price, notional_usd);
+        if (qty == 0) {
+            reject(s.name, "size below min qty");
+            return;
+        }
+        LiveOrder* live = claim(client_order_id);
+        if (!live) return;
+        int64_t ticks = std::llround(price * static_cast<double>(fixPow10(s.digits)));
+
+        const FixMsgTemplate& t = s.replace[o->side];
+        int64_t now = fixWallClockNs();
+        std::string_view msg = m_enc.begin(t, m_wire.next_seq(), now)
+                                    .field(41, static_cast<int64_t>(orig_client_order_id))
+                                    .field(11, static_cast<int64_t>(client_order_id))
+                                    .body(t)
+                                    .timestamp(60, now, t.sendingTimePrecision())
+                                    .price(38, qty, s.qty_digits)
+                                    .fields(o->post_only ? m_limit_post : m_limit)
+                                    .price(44, ticks, s.digits)
+                                    .finish();
+        wire_ts = write(msg);
+        if (wire_ts) {
+            // The replacement is tracked under its own ClOrdID; the
+            // original keeps its slot until the venue answers
+            LiveOrder moved = *o;
+            moved.client_order_id = client_order_id;
+            moved.qty = qty;
+            moved.price_ticks = ticks;
+            *live = moved;
+
+            FixOrderNote note;
+            note.id = client_order_id;
+            note.orig_id = orig_client_order_id;
+            note.qty = qty * fixPow10(FixOrder::QTY_DIGITS - s.qty_digits);
+            note.price = ticks;
+            note.symbol = s.fix_id;
+            note.digits = static_cast<uint8_t>(s.digits);
+            note.side = o->side == 0 ? '1' : '2';
+            note.kind = FixOrdKind::Replace;
+            m_wire.on_sent(note);
+        }
+        symbol = s.name;
+        qty_digits = s.qty_digits;
+    }
+
+    if (wire_ts && m_latency) {
+        m_latency->on_submit(symbol, client_order_id, send_ts_ns, wire_ts,
+                             price, static_cast<double>(qty) / fixPow10(qty_digits));
+    }
+}
+
+}
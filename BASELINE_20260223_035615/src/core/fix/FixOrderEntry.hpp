@@ -0,0 +1,140 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FixAdapter.hpp"
+#include "../../../../include/core/FixEncoder.hpp"
+#include "../../../../include/core/FixOrderStore.hpp"
+
+namespace chimera {
+
+class LatencyAttributionEngine;
+
+// Outbound side of the TRADE session. Orders share MsgSeqNum with the
+// session's own heartbeats, so both are encoded and written under send_lock().
+class FixOrderWire {
+public:
+    virtual ~FixOrderWire() {}
+
+    virtual std::mutex& send_lock() = 0;
+    virtual int64_t next_seq() = 0;                     // send_lock() held
+    virtual bool write(std::string_view msg) = 0;       // send_lock() held
+
+    // An order, cancel or replace is on the wire; send_lock() held. The
+    // session hands it to whoever applies ExecutionReports (FixOrderStore).
+    virtual void on_sent(const FixOrderNote& note) { (void)note; }
+};
+
+// FixAdapter on a cTrader TRADE session: NewOrderSingle (35=D),
+// OrderCancelRequest (35=F) and OrderCancelReplaceRequest (35=G) with
+// integer ClOrdIDs, encoded from templates pre-rendered per symbol and side.
+// Every order is registered with the LatencyAttributionEngine as soon as it
+// is on the wire, so decision-to-send is measured rather than assumed.
+//
+// Limit orders rest GTC (40=2|59=1); post-only adds ExecInst 18=6
+// (ParticipateDontInitiate) so the venue rejects rather than fills one that
+// would take liquidity.
+//
+// Open orders are tracked in slot ClOrdID % MAX_LIVE until release(); an
+// order whose slot still holds a working one is refused, not overwritten.
+class FixOrderEntry final : public FixAdapter {
+public:
+    static const size_t MAX_LIVE = 1024;     // open orders tracked, by ClOrdID
+
+    FixOrderEntry(const FixSessionIds& ids,
+                  FixOrderWire& wire,
+                  LatencyAttributionEngine* latency);
+
+    // symbol is the strategy name ("XAUUSD"), fix_symbol the broker's 55=
+    // value ("41"). OrderQty is sized in steps of 10^-qty_digits units (the
+    // venue's lot precision, at most FixOrder::QTY_DIGITS) and min_qty counts
+    // those steps; an order below it is a local reject. The symbol table is
+    // not locked: add every symbol before the first send.
+    void add_symbol(const std::string& symbol,
+                    const std::string& fix_symbol,
+                    int price_digits,
+                    int qty_digits,
+                    int64_t min_qty);
+
+    // send_ts_ns from the caller is its decision time; the wire time is
+    // taken here once the message is written.
+    void send_new_order(const std::string& symbol,
+                        const std::string& side,
+                        double price,
+                        double notional_usd,
+                        bool post_only,
+                        uint64_t client_order_id,
+                        uint64_t send_ts_ns) override;
+
+    void send_cancel(uint64_t orig_client_order_id,
+                     uint64_t client_order_id,
+                     uint64_t send_ts_ns) override;
+
+    void send_replace(uint64_t orig_client_order_id,
+                      uint64_t client_order_id,
+                      double price,
+                      double notional_usd,
+                      uint64_t send_ts_ns) override;
+
+    // The order is final (filled, canceled, replaced or rejected) and its
+    // slot can take a new one; any thread
+    void release(uint64_t client_order_id);
+
+    uint64_t sent() const { return m_sent.load(std::memory_order_relaxed); }
+    uint64_t send_failures() const { return m_failures.load(std::memory_order_relaxed); }
+    uint64_t last_send_ts_ns() const { return m_last_send_ts_ns.load(std::memory_order_relaxed); }
+    uint64_t collisions() const { return m_collisions.load(std::memory_order_relaxed); }   // refused: slot working
+    uint64_t local_rejects() const { return m_rejects.load(std::memory_order_relaxed); }   // not sent: symbol, size
+
+private:
+    struct Symbol {
+        std::string name;
+        uint16_t fix_id = 0;              // numeric 55=
+        int digits = 2;
+        int qty_digits = 0;               // OrderQty decimals
+        int64_t min_qty = 1;              // in qty_digits steps
+        FixMsgTemplate new_order[2];      // [0] BUY, [1] SELL
+        FixMsgTemplate cancel[2];
+        FixMsgTemplate replace[2];
+    };
+
+    struct LiveOrder {
+        uint64_t client_order_id = 0;     // 0 = free slot
+        int symbol = -1;
+        int side = 0;
+        int64_t qty = 0;                  // in the symbol's qty_digits steps
+        int64_t price_ticks = 0;
+        bool post_only = false;
+    };
+
+    int find_symbol(const std::string& name) const;
+    LiveOrder* find_live(uint64_t client_order_id);
+    LiveOrder& slot(uint64_t client_order_id);
+    LiveOrder* claim(uint64_t client_order_id);
+    void reject(const std::string& symbol, const char* why);
+    int64_t to_qty(const Symbol& s, double price, double notional_usd) const;
+    uint64_t write(std::string_view msg);
+
+    FixSessionIds m_ids;
+    FixOrderWire& m_wire;
+    LatencyAttributionEngine* m_latency;
+
+    std::vector<Symbol> m_symbols;
+    FixStaticFields m_limit;              // 40=2|59=1, may take or rest
+    FixStaticFields m_limit_post;         // 40=2|59=1|18=6, rests or is rejected
+    FixEncoder m_enc;                     // guarded by m_wire.send_lock()
+    LiveOrder m_live[MAX_LIVE];           // guarded by m_wire.send_lock()
+
+    // Written under send_lock(), read by telemetry
+    std::atomic<uint64_t> m_sent;
+    std::atomic<uint64_t> m_failures;
+    std::atomic<uint64_t> m_last_send_ts_ns;
+    std::atomic<uint64_t> m_collisions;
+    std::atomic<uint64_t> m_rejects;
+};
+
+}
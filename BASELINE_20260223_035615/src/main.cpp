@@ -8,14 +8,37 @@
 #include <thread>
 #include <atomic>
 #include <string>
-#include <sstream>
 #include <iomanip>
-#include <ctime>
 #include <fstream>
 #include <map>
+#include <mutex>
 #include <chrono>
+#include <string_view>
+#include <vector>
 
 #include "TelemetryWriter.hpp"
+#include "../include/platform/platform.hpp"
+#include "core/execution/ExecutionBridgeFix.hpp"
+#include "core/fix/FixOrderEntry.hpp"
+#include "../latency/LatencyAttributionEngine.hpp"
+#include "../latency/TelemetrySinkStdout.hpp"
+#include "../../include/core/FixBook.hpp"
+#include "../../include/core/FixConnect.hpp"
+#include "../../include/core/FixDispatch.hpp"
+#include "../../include/core/FixEncoder.hpp"
+#include "../../include/core/FixLatency.hpp"
+#include "../../include/core/FixMdDecoder.hpp"
+#include "../../include/core/FixMessageStore.hpp"
+#include "../../include/core/FixNumeric.hpp"
+#include "../../include/core/FixOrderStore.hpp"
+#include "../../include/core/FixQuoteCache.hpp"
+#include "../../include/core/FixRecvRing.hpp"
+#include "../../include/core/FixRxTimestamp.hpp"
+#include "../../include/core/FixSimd.hpp"
+#include "../../include/core/FixSpscQueue.hpp"
+#include "../../include/core/FixSymbolDirectory.hpp"
+#include "../../include/core/FixTagIndex.hpp"
+#include "../../include/core/FixTime.hpp"
 
 #pragma comment(lib, "ws2_32.lib")
 
@@ -35,24 +58,73 @@ struct Config {
     std::string username;
     std::string password;
     int heartbeat = 30;
+    chimera::FixTimePrecision quote_time_precision = chimera::FixTimePrecision::Seconds;
+    chimera::FixTimePrecision trade_time_precision = chimera::FixTimePrecision::Seconds;
+    bool ktls = false;
+    std::string trade_message_store;    // TRADE outbound history for ResendRequest
+    std::string symbols = "XAUUSD, XAGUSD";     // [symbols] subscribe, in handle order
+    bool trading = false;               // [execution] enabled: the bridge sends orders
+    double max_usd = 1000.0;            // [execution] max_usd per order
+    int qty_digits = 2;                 // [execution] qty_digits, OrderQty decimals
 };
 
 struct FixSession {
     SSL* ssl = nullptr;
     int seq = 1;
     std::string sub_id;
+    int64_t rx_ns = 0;          // receive time of the message being handled
+    std::mutex send_lock;       // seq + write, once orders share the session
+    // TRADE: orders are written from the quote thread. OpenSSL does not
+    // allow a read and a write on one SSL at once, so the socket is
+    // non-blocking and the read loop holds send_lock for every SSL call.
+    bool shared_ssl = false;
+    chimera::FixConnectTiming timing;   // stages of the last connect
+    uint64_t logon_sent_ns = 0;
+
+    // Pre-rendered per session by init_templates(), patched by enc on send
+    chimera::FixEncoder enc;
+    chimera::FixMsgTemplate logon;
+    chimera::FixMsgTemplate heartbeat;
+    chimera::FixMsgTemplate security_list_req;
+    std::vector<chimera::FixMsgTemplate> md_reqs;   // init_md_templates(), once ids are known
+    chimera::FixMsgTemplate gap_fill;
+
+    // Outbound messages by MsgSeqNum, when opened (TRADE)
+    chimera::FixMessageStore store;
+
+    // TRADE: orders as sent (strategy thread, under send_lock) reach the
+    // read thread, which owns the order store and applies every 35=8 to it
+    chimera::FixSpscQueue<chimera::FixOrderNote, 1024> order_notes;
+    chimera::FixOrderStore orders;
+    // TRADE: frees its slots as orders go final; set before the loops start
+    chimera::FixOrderEntry* order_entry = nullptr;
 };
 
 Config g_cfg;
 std::atomic<bool> g_running(true);
-std::map<std::string, double> g_bid;
-std::map<std::string, double> g_ask;
 
-// Global price state for telemetry
-double g_xau_bid = 0.0;
-double g_xau_ask = 0.0;
-double g_xag_bid = 0.0;
-double g_xag_ask = 0.0;
+// Configured symbols by handle; ids and digits arrive with the SecurityList
+chimera::FixSymbolDirectory g_symbols;
+
+// Top of book per symbol handle: written by the quote thread, read by
+// telemetry and anything else without locks
+chimera::FixQuoteCache g_quotes;
+
+// L2 book per symbol handle, quote thread only; depth_top, depth and
+// imbalance are published for the engines through g_books.depth()
+chimera::FixBookSet g_books(g_symbols);
+
+// Strategy bridge, set by main once order entry has every symbol ([execution]
+// enabled); read by the quote thread
+std::atomic<chimera::ExecutionBridgeFix*> g_bridge{nullptr};
+
+// Broker-to-us latency per session, from SendingTime (52)
+chimera::FixFeedLatency g_quote_latency;
+chimera::FixFeedLatency g_trade_latency;
+
+// Decision -> wire -> ack -> fill per ClOrdID
+chimera::TelemetrySinkStdout g_latency_sink;
+chimera::LatencyAttributionEngine g_latency_attr(g_latency_sink);
 
 // Console print throttling
 static std::chrono::steady_clock::time_point g_last_print = std::chrono::steady_clock::now();
@@ -110,14 +182,13 @@ bool load_config(const std::string& path)
     if (!f.is_open()) return false;
 
     std::string line;
-    bool in_fix = false;
+    std::string section;
 
     while (std::getline(f, line)) {
         line = trim(line);
         if (line.empty() || line[0] == '#') continue;
-        if (line == "[fix]") { in_fix = true; continue; }
-        if (line[0] == '[' && line != "[fix]") { in_fix = false; continue; }
-        if (!in_fix) continue;
+        if (line[0] == '[') { section = line; continue; }
+        if (section != "[fix]" && section != "[symbols]" && section != "[execution]") continue;
 
         size_t eq = line.find('=');
         if (eq == std::string::npos) continue;
@@ -125,6 +196,17 @@ bool load_config(const std::string& path)
         std::string key = trim(line.substr(0, eq));
         std::string val = trim(line.substr(eq + 1));
 
+        if (section == "[symbols]") {
+            if (key == "subscribe") g_cfg.symbols = val;
+            continue;
+        }
+        if (section == "[execution]") {
+            if (key == "enabled") g_cfg.trading = (val == "true" || val == "1");
+            if (key == "max_usd") g_cfg.max_usd = std::stod(val);
+            if (key == "qty_digits") g_cfg.qty_digits = std::stoi(val);
+            continue;
+        }
+
         if (key == "host") g_cfg.host = val;
         if (key == "port") g_cfg.port = std::stoi(val);
         if (key == "trade_port") g_cfg.trade_port = std::stoi(val);
@@ -133,326 +215,553 @@ bool load_config(const std::string& path)
         if (key == "username") g_cfg.username = val;
         if (key == "password") g_cfg.password = val;
         if (key == "heartbeat_interval") g_cfg.heartbeat = std::stoi(val);
+        if (key == "quote_time_precision" && !chimera::parseFixTimePrecision(val, g_cfg.quote_time_precision))
+            std::cerr << "[CONFIG] Unknown quote_time_precision '" << val << "', using seconds\n";
+        if (key == "trade_time_precision" && !chimera::parseFixTimePrecision(val, g_cfg.trade_time_precision))
+            std::cerr << "[CONFIG] Unknown trade_time_precision '" << val << "', using seconds\n";
+        if (key == "ktls") g_cfg.ktls = (val == "true" || val == "1");
+        if (key == "trade_message_store") g_cfg.trade_message_store = val;
     }
 
     return !g_cfg.host.empty() && g_cfg.port != 0;
 }
 
-std::string timestamp()
+// A blocking session writes in one call; a non-blocking one (TRADE) waits
+// until OpenSSL has taken the whole message
+bool write_fix(FixSession& session, std::string_view msg)
 {
-    std::time_t now = std::time(nullptr);
-    std::tm gmt{};
-    gmtime_s(&gmt, &now);
-    char buf[32];
-    std::strftime(buf, sizeof(buf), "%Y%m%d-%H:%M:%S", &gmt);
-    return buf;
+    if (msg.empty()) return false;
+    for (;;) {
+        int n = SSL_write(session.ssl, msg.data(), static_cast<int>(msg.size()));
+        if (n > 0) return true;
+        socket_t fd = static_cast<socket_t>(SSL_get_fd(session.ssl));
+        switch (SSL_get_error(session.ssl, n)) {
+            case SSL_ERROR_WANT_WRITE: plat::wait_writable(fd, 100); break;
+            case SSL_ERROR_WANT_READ: plat::wait_readable(fd, 100); break;
+            default: return false;
+        }
+        if (!g_running) return false;
+    }
 }
 
-int checksum(const std::string& msg)
+// Everything we originate goes through here and into the session's store
+bool send_fix(FixSession& session, std::string_view msg)
 {
-    int sum = 0;
-    for (unsigned char c : msg) sum += c;
-    return sum % 256;
+    session.store.append(msg);
+    return write_fix(session, msg);
 }
 
-std::string wrap_fix(const std::string& body)
+// ============================================================================
+// FIX MESSAGE TEMPLATES
+// ============================================================================
+
+chimera::FixSessionIds session_ids(const FixSession& session)
 {
-    std::stringstream msg;
-    msg << "8=FIX.4.4\x01" << "9=" << body.size() << "\x01" << body;
-    int cs = checksum(msg.str());
-    msg << "10=" << std::setfill('0') << std::setw(3) << cs << "\x01";
-    return msg.str();
+    chimera::FixSessionIds ids;
+    ids.sender_comp_id = g_cfg.sender;
+    ids.target_comp_id = g_cfg.target;
+    ids.sender_sub_id = session.sub_id;
+    ids.target_sub_id = session.sub_id;
+    // SendingTime is stamped by enc.begin() at this precision
+    ids.sending_time_precision = session.sub_id == "QUOTE" ? g_cfg.quote_time_precision
+                                                           : g_cfg.trade_time_precision;
+    return ids;
 }
 
-// ============================================================================
-// FIX MESSAGE BUILDERS
-// ============================================================================
+void init_templates(FixSession& session)
+{
+    chimera::FixSessionIds ids = session_ids(session);
+
+    std::string logon_body = "98=0\x01";
+    if (session.sub_id == "QUOTE") {
+        logon_body += "108=" + std::to_string(g_cfg.heartbeat) + "\x01";
+        // CRITICAL: Only reset sequence on QUOTE session
+        // TRADE session MUST NOT have 141=Y or connection drops
+        logon_body += "141=Y\x01";
+    } else {
+        logon_body += "108=30\x01";
+    }
+    logon_body += "553=" + g_cfg.username + "\x01" "554=" + g_cfg.password + "\x01";
+
+    session.logon = chimera::FixMsgTemplate(ids, "A", logon_body);
+    session.heartbeat = chimera::FixMsgTemplate(ids, "0");
+    session.security_list_req = chimera::FixMsgTemplate(ids, "x", "559=0\x01");
+    session.gap_fill = chimera::FixMessageStore::gapFillTemplate(ids);
+}
 
-std::string build_logon(int seq, const std::string& sub_id)
+// One MarketDataRequest per batch of listed symbols, by SecurityID, full
+// depth so g_books carries every level
+void init_md_templates(FixSession& session)
 {
-    std::stringstream body;
-
-    body << "35=A\x01"
-         << "49=" << g_cfg.sender << "\x01"
-         << "56=" << g_cfg.target << "\x01"
-         << "50=" << sub_id << "\x01"
-         << "57=" << sub_id << "\x01"
-         << "34=" << seq << "\x01"
-         << "52=" << timestamp() << "\x01"
-         << "98=0\x01"
-         << "108=" << g_cfg.heartbeat << "\x01";
-
-    // CRITICAL: Only reset sequence on QUOTE session
-    // TRADE session MUST NOT have 141=Y or connection drops
-    if (sub_id == "QUOTE")
-        body << "141=Y\x01";
-
-    body << "553=" << g_cfg.username << "\x01"
-         << "554=" << g_cfg.password << "\x01";
-
-    return wrap_fix(body.str());
+    chimera::FixSessionIds ids = session_ids(session);
+    session.md_reqs.clear();
+    for (size_t i = 0; i < g_symbols.requestCount(); ++i) {
+        session.md_reqs.emplace_back(ids, "V",
+            "263=1\x01" "264=0\x01" "265=1\x01"
+            "267=2\x01" "269=0\x01" "269=1\x01" + g_symbols.relatedSymbols(i, true));
+    }
 }
 
+// ============================================================================
+// FIX MESSAGE BUILDERS
+// ============================================================================
+// Each returns a view into session.enc, valid until that session's next build.
 
-std::string build_trade_logon(int seq)
+std::string_view build_logon(FixSession& session)
 {
-    std::stringstream body;
-
-    body << "35=A\x01"
-         << "49=" << g_cfg.sender << "\x01"
-         << "56=" << g_cfg.target << "\x01"
-         << "50=TRADE\x01"
-         << "57=TRADE\x01"
-         << "34=" << seq << "\x01"
-         << "52=" << timestamp() << "\x01"
-         << "98=0\x01"
-         << "108=30\x01"
-         << "553=" << g_cfg.username << "\x01"
-         << "554=" << g_cfg.password << "\x01";
-
-    return wrap_fix(body.str());
+    return session.enc.begin(session.logon, session.seq++)
+                      .body(session.logon)
+                      .finish();
 }
-std::string build_security_list_req(int seq)
+
+std::string_view build_security_list_req(FixSession& session)
 {
-    std::stringstream body;
-    body << "35=x\x01"
-         << "49=" << g_cfg.sender << "\x01"
-         << "56=" << g_cfg.target << "\x01"
-         << "50=QUOTE\x01"
-         << "57=QUOTE\x01"
-         << "34=" << seq << "\x01"
-         << "52=" << timestamp() << "\x01"
-         << "320=ListReq-" << seq << "\x01"
-         << "559=0\x01";
-
-    return wrap_fix(body.str());
+    int seq = session.seq++;
+    return session.enc.begin(session.security_list_req, seq)
+                      .field(320, "ListReq-", seq)
+                      .body(session.security_list_req)
+                      .finish();
 }
 
-std::string build_marketdata_req(int seq)
+std::string_view build_marketdata_req(FixSession& session, const chimera::FixMsgTemplate& md_req)
 {
-    std::stringstream body;
-    body << "35=V\x01"
-         << "49=" << g_cfg.sender << "\x01"
-         << "56=" << g_cfg.target << "\x01"
-         << "50=QUOTE\x01"
-         << "57=QUOTE\x01"
-         << "34=" << seq << "\x01"
-         << "52=" << timestamp() << "\x01"
-         << "262=MDReq-" << seq << "\x01"
-         << "263=1\x01"
-         << "264=1\x01"
-         << "265=1\x01"
-         << "267=2\x01"
-         << "269=0\x01"
-         << "269=1\x01"
-         << "146=2\x01"
-         << "55=41\x01"
-         << "55=42\x01";
-
-    return wrap_fix(body.str());
+    int seq = session.seq++;
+    return session.enc.begin(md_req, seq)
+                      .field(262, "MDReq-", seq)
+                      .body(md_req)
+                      .finish();
 }
 
-std::string build_heartbeat(int seq, const std::string& test_id, const std::string& sub_id)
+std::string_view build_heartbeat(FixSession& session, std::string_view test_id)
 {
-    std::stringstream body;
-    body << "35=0\x01"
-         << "49=" << g_cfg.sender << "\x01"
-         << "56=" << g_cfg.target << "\x01"
-         << "50=" << sub_id << "\x01"
-         << "57=" << sub_id << "\x01"
-         << "34=" << seq << "\x01"
-         << "52=" << timestamp() << "\x01"
-         << "112=" << test_id << "\x01";
-
-    return wrap_fix(body.str());
+    return session.enc.begin(session.heartbeat, session.seq++)
+                      .field(112, test_id)
+                      .finish();
 }
 
+// TRADE session as seen by chimera::FixOrderEntry
+struct TradeWire : chimera::FixOrderWire {
+    FixSession& session;
+
+    explicit TradeWire(FixSession& s) : session(s) {}
+
+    std::mutex& send_lock() override { return session.send_lock; }
+    int64_t next_seq() override { return session.seq++; }
+    bool write(std::string_view msg) override { return send_fix(session, msg); }
+
+    void on_sent(const chimera::FixOrderNote& note) override
+    {
+        if (!session.order_notes.push(note))
+            std::cerr << "[TRADE] order queue full, ClOrdID " << note.id << " not tracked\n";
+    }
+};
+
 // ============================================================================
 // SSL CONNECTION
 // ============================================================================
 
-SSL* connect_ssl(const std::string& host, int port)
+// One resolver and TLS context per port for the life of the process: the
+// context used to be created per connect and never freed, and keeping it lets
+// a reconnect resume the last TLS session
+struct TlsEndpoint {
+    chimera::FixResolver resolver;
+    chimera::FixTlsClient tls;
+};
+
+std::map<int, TlsEndpoint> g_endpoints;
+std::mutex g_endpoints_lock;
+
+TlsEndpoint* endpoint_for(const std::string& host, int port)
 {
+    std::lock_guard<std::mutex> lock(g_endpoints_lock);
+    auto found = g_endpoints.find(port);
+    if (found != g_endpoints.end()) return &found->second;
+
     SSL_library_init();
     SSL_load_error_strings();
 
-    const SSL_METHOD* method = TLS_client_method();
-    SSL_CTX* ctx = SSL_CTX_new(method);
-    if (!ctx) return nullptr;
+    TlsEndpoint& ep = g_endpoints.try_emplace(port).first->second;
+    if (!ep.tls.ctx()) {
+        g_endpoints.erase(port);
+        return nullptr;
+    }
+#ifdef SSL_OP_ENABLE_KTLS
+    // Only takes effect where the OS offers kernel TLS; SSL_read/SSL_write
+    // then hand records to the kernel instead of encrypting here
+    if (g_cfg.ktls) SSL_CTX_set_options(ep.tls.ctx(), SSL_OP_ENABLE_KTLS);
+#endif
+    ep.resolver.setTarget(host, static_cast<uint16_t>(port), 300LL * 1000000000LL);
+    return &ep;
+}
 
-    int sock = socket(AF_INET, SOCK_STREAM, 0);
-    if (sock < 0) return nullptr;
+int64_t elapsed_ns(uint64_t since)
+{
+    return static_cast<int64_t>(plat::monotonic_time_ns() - since);
+}
+
+SSL* connect_ssl(const std::string& host, int port, chimera::FixConnectTiming& timing)
+{
+    TlsEndpoint* ep = endpoint_for(host, port);
+    if (!ep) return nullptr;
+    timing = chimera::FixConnectTiming();
 
+    uint64_t stage = plat::monotonic_time_ns();
     sockaddr_in addr{};
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
+    if (!ep->resolver.lookup(addr, timing.dns_cached))
+        return nullptr;
+    timing.dns_ns = elapsed_ns(stage);
 
-    hostent* he = gethostbyname(host.c_str());
-    if (!he) return nullptr;
-    
-    memcpy(&addr.sin_addr, he->h_addr_list[0], he->h_length);
+    stage = plat::monotonic_time_ns();
+    socket_t sock = plat::create_tcp();
+    if (sock == INVALID_SOCKET_FD) return nullptr;
+    plat::set_nodelay(sock);
 
-    if (connect(sock, (sockaddr*)&addr, sizeof(addr)) != 0)
+    if (plat::socket_connect(sock, addr) != 0) {
+        plat::socket_close(sock);
+        ep->resolver.invalidate();
         return nullptr;
+    }
+    timing.tcp_ns = elapsed_ns(stage);
 
-    SSL* ssl = SSL_new(ctx);
-    SSL_set_fd(ssl, sock);
+    stage = plat::monotonic_time_ns();
+    SSL* ssl = SSL_new(ep->tls.ctx());
+    SSL_set_fd(ssl, static_cast<int>(sock));
+    ep->tls.prepare(ssl, host);
 
-    if (SSL_connect(ssl) <= 0)
+    if (SSL_connect(ssl) <= 0) {
+        SSL_free(ssl);
+        plat::socket_close(sock);
         return nullptr;
+    }
+    timing.tls_ns = elapsed_ns(stage);
+    timing.tls_resumed = chimera::FixTlsClient::resumed(ssl);
 
     return ssl;
 }
 
+// Called on the Logon ACK; the connect stages were filled by connect_ssl
+void print_connect_timing(FixSession& session)
+{
+    chimera::FixConnectTiming& t = session.timing;
+    t.logon_ns = elapsed_ns(session.logon_sent_ns);
+    std::cout << "[" << session.sub_id << "] CONNECT dns=" << t.dns_ns / 1000 << "us"
+              << (t.dns_cached ? " (cached)" : "")
+              << " tcp=" << t.tcp_ns / 1000 << "us"
+              << " tls=" << t.tls_ns / 1000 << "us" << (t.tls_resumed ? " (resumed)" : "")
+              << " logon=" << t.logon_ns / 1000 << "us"
+              << " total=" << t.totalNs() / 1000 << "us\n";
+}
+
 // ============================================================================
 // MESSAGE LOOPS
 // ============================================================================
 
-void quote_loop(FixSession& session)
-{
-    char buffer[8192];
+// Handlers are bound by name through chimera::fixDispatch; a MsgType with no
+// member here is skipped at the cost of one table lookup.
+struct QuoteHandler {
+    FixSession& session;
+    chimera::FixPricePrecision precision;
+    chimera::FixMdBatch batch;
     bool security_list_sent = false;
+    chimera::FixSymbolHandle xau = chimera::FIX_NO_SYMBOL;     // telemetry's fixed fields
+    chimera::FixSymbolHandle xag = chimera::FIX_NO_SYMBOL;
+
+    explicit QuoteHandler(FixSession& s) : session(s) {}
+
+    void onLogon(std::string_view, const chimera::FixTagIndex&)
+    {
+        std::cout << "[QUOTE] LOGON ACCEPTED\n";
+        print_connect_timing(session);
+        if (!security_list_sent) {
+            send_fix(session, build_security_list_req(session));
+            std::cout << "[QUOTE] SECURITY LIST REQUEST SENT\n";
+            security_list_sent = true;
+        }
+    }
 
-    while (g_running) {
-        int n = SSL_read(session.ssl, buffer, sizeof(buffer) - 1);
-        if (n <= 0) {
-            std::cout << "[QUOTE] CONNECTION CLOSED\n";
-            break;
+    void onSecurityList(std::string_view, const chimera::FixTagIndex& idx)
+    {
+        std::cout << "[QUOTE] SECURITY LIST RECEIVED ("
+                  << precision.loadSecurityList(idx) << " symbols)\n";
+        g_symbols.loadSecurityList(idx);
+        for (chimera::FixSymbolHandle h = 0; h < g_symbols.size(); ++h) {
+            const chimera::FixSymbol& s = g_symbols[h];
+            if (!s.listed) {
+                std::cout << "[QUOTE] " << s.name << " NOT IN SECURITY LIST\n";
+                continue;
+            }
+            std::cout << "[QUOTE] " << s.name << " = " << s.id << " DIGITS " << s.digits << "\n";
+            g_telemetry.SetSymbol(h, s.name.c_str());
         }
+        xau = g_symbols.byName("XAUUSD");
+        xag = g_symbols.byName("XAGUSD");
+
+        init_md_templates(session);
+        for (const chimera::FixMsgTemplate& md_req : session.md_reqs)
+            send_fix(session, build_marketdata_req(session, md_req));
+        std::cout << "[QUOTE] " << session.md_reqs.size() << " MARKET DATA REQUEST(S) SENT FOR "
+                  << g_symbols.listed() << " SYMBOLS\n";
+    }
 
-        buffer[n] = 0;
-        std::string msg(buffer, n);
+    void onMarketDataSnapshot(std::string_view, const chimera::FixTagIndex& idx)
+    {
+        onMarketData(idx);
+    }
 
-        if (msg.find("35=A") != std::string::npos) {
-            std::cout << "[QUOTE] LOGON ACCEPTED\n";
-            if (!security_list_sent) {
-                std::string req = build_security_list_req(session.seq++);
-                SSL_write(session.ssl, req.c_str(), req.size());
-                std::cout << "[QUOTE] SECURITY LIST REQUEST SENT\n";
-                security_list_sent = true;
-            }
+    void onMarketDataIncremental(std::string_view, const chimera::FixTagIndex& idx)
+    {
+        onMarketData(idx);
+    }
+
+    void onTestRequest(std::string_view, const chimera::FixTagIndex& idx)
+    {
+        if (!idx.has(112)) return;
+        send_fix(session, build_heartbeat(session, idx.get(112)));
+    }
+
+    void onReject(std::string_view, const chimera::FixTagIndex& idx)
+    {
+        if (idx.has(58))
+            std::cout << "[QUOTE ERROR] REJECT: " << idx.get(58) << "\n";
+    }
+
+    void onMarketData(const chimera::FixTagIndex& idx)
+    {
+        if (!chimera::FixMdDecoder::decode(idx, precision, batch))
+            return;
+        if (batch.errors())
+            std::cout << "[QUOTE ERROR] " << batch.errors() << " BAD MD ENTRIES DROPPED\n";
+
+        // Book first, then one quote store per symbol the message touched
+        chimera::FixSymbolHandle touched[chimera::FixSymbolDirectory::MAX_SYMBOLS];
+        size_t n = g_books.apply(batch, touched, chimera::FixSymbolDirectory::MAX_SYMBOLS);
+        int64_t exchange_ns = 0;
+        if (!chimera::parseFixUtcTimestamp(idx.get(52), exchange_ns))
+            exchange_ns = 0;
+        bool xau_touched = false;
+        for (size_t i = 0; i < n; ++i) {
+            chimera::FixSymbolHandle h = touched[i];
+            xau_touched |= h == xau;
+            g_quotes.update(h, g_books.book(h).top(), exchange_ns, session.rx_ns);
+            chimera::FixQuote q = g_quotes.load(h);
+            g_telemetry.UpdateQuote(h, q.bid, q.ask);
         }
 
-        if (msg.find("35=y") != std::string::npos) {
-            std::cout << "[QUOTE] SECURITY LIST RECEIVED\n";
-            std::string md = build_marketdata_req(session.seq++);
-            SSL_write(session.ssl, md.c_str(), md.size());
-            std::cout << "[QUOTE] MARKET DATA REQUEST SENT\n";
+        chimera::FixQuote xau_q = g_quotes.load(xau);
+        chimera::FixQuote xag_q = g_quotes.load(xag);
+
+        // Published by main once every order symbol is added; only a message
+        // that moved the XAU book is a new decision
+        chimera::ExecutionBridgeFix* bridge = g_bridge.load(std::memory_order_acquire);
+        if (bridge && xau_touched) {
+            if (xau_q.valid() && xau_q.bid > 0.0 && xau_q.ask > 0.0)
+                bridge->on_market(xau_q.mid(), xau_q.spread(), g_books.depth(xau).depth_top,
+                                  static_cast<uint64_t>(session.rx_ns));
         }
 
-        if (msg.find("35=W") != std::string::npos || msg.find("35=X") != std::string::npos) {
-            int symbolId = 0;
-            
-            size_t pos55 = msg.find("55=");
-            if (pos55 != std::string::npos) {
-                size_t end = msg.find("\x01", pos55);
-                symbolId = std::stoi(msg.substr(pos55 + 3, end - (pos55 + 3)));
+        g_telemetry.Update(xau_q.bid, xau_q.ask, xag_q.bid, xag_q.ask, 0.0, 0.0, 0.0, 0.0, 0.0, "NORMAL", "CONNECTED", "NONE", "NONE");
+
+        // Throttled console output
+        auto now = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - g_last_print).count();
+        if (elapsed >= 5) {
+            std::cout << "\n=== MARKET DATA ===\n";
+            for (chimera::FixSymbolHandle h = 0; h < g_symbols.size(); ++h) {
+                chimera::FixQuote q = g_quotes.load(h);
+                chimera::FixDepth d = g_books.depth(h);
+                std::cout << g_symbols[h].name << ": " << std::fixed << std::setprecision(g_symbols[h].digits)
+                          << q.bid << " / " << q.ask << std::setprecision(2)
+                          << "  DEPTH " << d.bid_depth << " / " << d.ask_depth
+                          << "  IMBALANCE " << d.imbalance << "\n";
             }
+            std::cout << "FEED LATENCY: p50=" << g_quote_latency.percentileMs(0.50)
+                      << "ms p99=" << g_quote_latency.percentileMs(0.99)
+                      << "ms clock offset<=" << g_quote_latency.clockOffsetNs() / 1e6 << "ms\n";
+            g_telemetry.UpdateFeedLatency(g_quote_latency.percentileMs(0.50));
+            g_last_print = now;
+        }
+    }
+};
 
-            double bid = 0.0;
-            double ask = 0.0;
-
-            size_t pos = 0;
-            while ((pos = msg.find("269=", pos)) != std::string::npos) {
-                char type = msg[pos + 4];
-                size_t pxPos = msg.find("270=", pos);
-                if (pxPos == std::string::npos) break;
-                
-                size_t pxEnd = msg.find("\x01", pxPos);
-                double price = std::stod(msg.substr(pxPos + 4, pxEnd - (pxPos + 4)));
-
-                if (type == '0') bid = price;
-                else if (type == '1') ask = price;
-                
-                pos = pxEnd;
-            }
+struct TradeHandler {
+    FixSession& session;
 
-            if (symbolId == 41) {
-                g_xau_bid = bid;
-                g_xau_ask = ask;
-                g_bid["XAUUSD"] = bid;
-                g_ask["XAUUSD"] = ask;
-            }
-            else if (symbolId == 42) {
-                g_xag_bid = bid;
-                g_xag_ask = ask;
-                g_bid["XAGUSD"] = bid;
-                g_ask["XAGUSD"] = ask;
-            }
+    explicit TradeHandler(FixSession& s) : session(s) {}
 
-            g_telemetry.Update(g_xau_bid, g_xau_ask, g_xag_bid, g_xag_ask, 0.0, 0.0, 0.0, 0.0, 0.0, "NORMAL", "CONNECTED", "NONE", "NONE");
+    void onLogon(std::string_view, const chimera::FixTagIndex&)
+    {
+        std::cout << "[TRADE] LOGON ACCEPTED\n";
+        print_connect_timing(session);
+    }
 
-            // Throttled console output
-            auto now = std::chrono::steady_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - g_last_print).count();
-            if (elapsed >= 5) {
-                std::cout << "\n=== MARKET DATA ===\n";
-                std::cout << "XAUUSD: " << std::fixed << std::setprecision(2) << g_xau_bid << " / " << g_xau_ask << "\n";
-                std::cout << "XAGUSD: " << std::fixed << std::setprecision(2) << g_xag_bid << " / " << g_xag_ask << "\n";
-                g_last_print = now;
-            }
+    // Order entry's slot for id is free again once the store has it final
+    void release_final(uint64_t id)
+    {
+        const chimera::FixOrder* o = session.orders.find(id);
+        if (session.order_entry && o && chimera::fixOrdStateFinal(o->state))
+            session.order_entry->release(id);
+    }
+
+    void drain_order_notes()
+    {
+        chimera::FixOrderNote note;
+        while (session.order_notes.pop(note)) session.orders.add(note, session.rx_ns);
+    }
+
+    void onExecutionReport(std::string_view, const chimera::FixTagIndex& idx)
+    {
+        std::cout << "[TRADE] EXECUTION REPORT"
+                  << " ClOrdID=" << idx.get(11)
+                  << " ExecType=" << idx.get(150)
+                  << " OrdStatus=" << idx.get(39)
+                  << " LastQty=" << idx.get(32)
+                  << " LastPx=" << idx.get(31) << "\n";
+
+        drain_order_notes();
+        chimera::FixOrderFill fill;
+        const chimera::FixOrder* o = session.orders.onExecutionReport(idx, session.rx_ns, fill);
+        if (o) {
+            std::cout << "[TRADE] ORDER " << o->id << " " << chimera::fixOrdStateName(o->state)
+                      << " CUM " << o->cumQtyValue() << "/" << o->qtyValue()
+                      << " AVG " << o->avg_px << "\n";
+            release_final(o->id);
+            release_final(o->orig_id);
         }
 
-        if (msg.find("35=1") != std::string::npos) {
-            size_t p = msg.find("112=");
-            if (p != std::string::npos) {
-                size_t e = msg.find("\x01", p);
-                std::string tid = msg.substr(p + 4, e - (p + 4));
-                std::string hb = build_heartbeat(session.seq++, tid, "QUOTE");
-                SSL_write(session.ssl, hb.c_str(), hb.size());
-            }
+        // ClOrdIDs are integers from FixOrderEntry; a cancel's report names
+        // the original order in 41
+        int64_t cid = 0;
+        std::string_view exec_type = idx.get(150);
+        std::string_view id = (exec_type == "4" && idx.has(41)) ? idx.get(41) : idx.get(11);
+        if (exec_type.empty() || chimera::parseFixInt(id, cid) != chimera::FixNumError::None) return;
+
+        uint64_t ts = static_cast<uint64_t>(session.rx_ns);
+        switch (exec_type[0]) {
+            case '0':
+                g_latency_attr.on_ack(static_cast<uint64_t>(cid), ts);
+                break;
+            case 'F':
+                // LastPx / LastQty as the order store parsed them
+                if (!o || fill.qty <= 0) {
+                    std::cout << "[TRADE ERROR] FILL NOT APPLIED ClOrdID=" << idx.get(11)
+                              << " LastQty=" << idx.get(32) << " LastPx=" << idx.get(31) << "\n";
+                    break;
+                }
+                g_latency_attr.on_fill(static_cast<uint64_t>(cid), ts, fill.px,
+                                       static_cast<double>(fill.qty) / chimera::fixPow10(chimera::FixOrder::QTY_DIGITS));
+                break;
+            case '4':
+                g_latency_attr.on_cancel(static_cast<uint64_t>(cid), ts);
+                break;
+            case '8':
+                g_latency_attr.on_reject(static_cast<uint64_t>(cid), ts);
+                break;
         }
+    }
 
-        if (msg.find("35=3") != std::string::npos) {
-            size_t p = msg.find("58=");
-            if (p != std::string::npos) {
-                size_t e = msg.find("\x01", p);
-                std::cout << "[QUOTE ERROR] REJECT: " << msg.substr(p + 3, e - (p + 3)) << "\n";
-            }
+    void onOrderCancelReject(std::string_view, const chimera::FixTagIndex& idx)
+    {
+        drain_order_notes();
+        const chimera::FixOrder* o = session.orders.onCancelReject(idx, session.rx_ns);
+        int64_t req = 0;
+        if (chimera::parseFixInt(idx.get(11), req) == chimera::FixNumError::None && req > 0)
+            release_final(static_cast<uint64_t>(req));
+        std::cout << "[TRADE] CANCEL REJECT ClOrdID=" << idx.get(11) << " OrigClOrdID=" << idx.get(41);
+        if (o) std::cout << " -> " << chimera::fixOrdStateName(o->state);
+        std::cout << (idx.has(58) ? " " : "") << idx.get(58) << "\n";
+    }
+
+    void onTestRequest(std::string_view, const chimera::FixTagIndex& idx)
+    {
+        if (!idx.has(112)) return;
+        std::lock_guard<std::mutex> g(session.send_lock);
+        send_fix(session, build_heartbeat(session, idx.get(112)));
+    }
+
+    void onReject(std::string_view, const chimera::FixTagIndex& idx)
+    {
+        if (idx.has(58))
+            std::cout << "[TRADE ERROR] REJECT: " << idx.get(58) << "\n";
+    }
+
+    // Orders come back as PossDup copies, admin runs as SequenceReset-GapFill
+    void onResendRequest(std::string_view, const chimera::FixTagIndex& idx)
+    {
+        int64_t begin = 0, end = 0;
+        if (chimera::parseFixInt(idx.get(7), begin) != chimera::FixNumError::None ||
+            chimera::parseFixInt(idx.get(16), end) != chimera::FixNumError::None)
+            return;
+
+        std::lock_guard<std::mutex> g(session.send_lock);
+        chimera::FixReplayStats stats;
+        if (session.store.isOpen()) {
+            stats = session.store.replay(begin, end, session.enc, session.gap_fill,
+                [this](std::string_view msg) { return write_fix(session, msg); });
+        } else if (write_fix(session, session.enc.begin(session.gap_fill, begin)
+                                                 .body(session.gap_fill)
+                                                 .field(36, static_cast<int64_t>(session.seq))
+                                                 .finish())) {
+            stats.gap_fills = 1;
         }
+        std::cout << "[TRADE] RESEND " << begin << "-" << end << ": " << stats.resent
+                  << " RESENT, " << stats.gap_fills << " GAP FILLS\n";
     }
-}
+};
 
-void trade_loop(FixSession& session)
+template <typename Handler>
+void read_loop(FixSession& session, Handler& handler, const char* name, chimera::FixFeedLatency& latency)
 {
-    char buffer[8192];
+    chimera::FixRecvRing rx;
+    chimera::FixTagIndex idx;
+    chimera::FixRxTimestamp stamp;
+    int fd = SSL_get_fd(session.ssl);
+
+    std::cout << "[" << name << "] RX TIMESTAMPS: "
+              << chimera::FixRxTimestamp::sourceName(stamp.enable(fd)) << "\n";
 
     while (g_running) {
-        int n = SSL_read(session.ssl, buffer, sizeof(buffer) - 1);
+        int n = 0;
+        int err = SSL_ERROR_NONE;
+        {
+            std::unique_lock<std::mutex> g(session.send_lock, std::defer_lock);
+            if (session.shared_ssl) g.lock();
+            if (SSL_pending(session.ssl) == 0)
+                session.rx_ns = stamp.stamp(fd);
+            n = SSL_read(session.ssl, rx.writePtr(), static_cast<int>(rx.writable()));
+            if (n <= 0) err = SSL_get_error(session.ssl, n);
+        }
+        if (n <= 0 && (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE)) {
+            // Non-blocking: wait without send_lock so orders can go out
+            plat::wait_readable(static_cast<socket_t>(fd), 100);
+            continue;
+        }
         if (n <= 0) {
-            std::cout << "[TRADE] CONNECTION CLOSED\n";
+            std::cout << "[" << name << "] CONNECTION CLOSED\n";
             break;
         }
+        rx.commit(n);
 
-        buffer[n] = 0;
-        std::string msg(buffer, n);
-
-        if (msg.find("35=A") != std::string::npos)
-            std::cout << "[TRADE] LOGON ACCEPTED\n";
-
-        if (msg.find("35=8") != std::string::npos)
-            std::cout << "[TRADE] EXECUTION REPORT\n";
-
-        if (msg.find("35=1") != std::string::npos) {
-            size_t p = msg.find("112=");
-            if (p != std::string::npos) {
-                size_t e = msg.find("\x01", p);
-                std::string tid = msg.substr(p + 4, e - (p + 4));
-                std::string hb = build_heartbeat(session.seq++, tid, "TRADE");
-                SSL_write(session.ssl, hb.c_str(), hb.size());
-            }
-        }
-
-        if (msg.find("35=3") != std::string::npos) {
-            size_t p = msg.find("58=");
-            if (p != std::string::npos) {
-                size_t e = msg.find("\x01", p);
-                std::cout << "[TRADE ERROR] REJECT: " << msg.substr(p + 3, e - (p + 3)) << "\n";
-            }
+        std::string_view msg;
+        while (rx.next(msg) == chimera::FixRecvRing::Frame::Complete) {
+            if (!idx.parse(msg)) continue;
+            latency.record(idx.get(52), session.rx_ns);
+            chimera::fixDispatch(handler, msg, idx);
         }
     }
 }
 
+void quote_loop(FixSession& session)
+{
+    QuoteHandler handler(session);
+    read_loop(session, handler, "QUOTE", g_quote_latency);
+}
+
+void trade_loop(FixSession& session)
+{
+    TradeHandler handler(session);
+    read_loop(session, handler, "TRADE", g_trade_latency);
+}
+
 // ============================================================================
 // MAIN
 // ============================================================================
@@ -488,10 +797,13 @@ int main(int argc, char* argv[])
     std::cout << "[OK] Config loaded\n";
     std::cout << "[CONFIG] quote_port=" << g_cfg.port << "\n";
     std::cout << "[CONFIG] trade_port=" << g_cfg.trade_port << "\n";
+    std::cout << "[CONFIG] symbols=" << g_cfg.symbols << " ("
+              << g_symbols.configure(g_cfg.symbols) << ")\n";
+    std::cout << "[CONFIG] execution=" << (g_cfg.trading ? "enabled" : "disabled")
+              << " max_usd=" << g_cfg.max_usd << " qty_digits=" << g_cfg.qty_digits << "\n";
     std::cout << "[OK] Connecting to: " << g_cfg.host << ":" << g_cfg.port << "\n\n";
 
-    WSADATA wsa;
-    WSAStartup(MAKEWORD(2, 2), &wsa);
+    plat::init();
 
     // ========================================================================
     // DUAL SESSION SETUP
@@ -502,33 +814,63 @@ int main(int argc, char* argv[])
 
     quote.sub_id = "QUOTE";
     trade.sub_id = "TRADE";
+    init_templates(quote);
+    init_templates(trade);
 
     // QUOTE SESSION
-    quote.ssl = connect_ssl(g_cfg.host, g_cfg.port);
+    quote.ssl = connect_ssl(g_cfg.host, g_cfg.port, quote.timing);
     if (!quote.ssl) {
         std::cout << "[ERROR] QUOTE SSL FAILED\n";
         return 1;
     }
     std::cout << "[QUOTE] SSL CONNECTED\n";
 
-    std::string qlogon = build_logon(quote.seq++, "QUOTE");
-    SSL_write(quote.ssl, qlogon.c_str(), qlogon.size());
+    quote.logon_sent_ns = plat::monotonic_time_ns();
+    send_fix(quote, build_logon(quote));
     std::cout << "[QUOTE] LOGON SENT\n\n";
 
-    // TRADE SESSION
+    // TRADE SESSION (never resets its sequence: it carries over in the store)
+    if (!g_cfg.trade_message_store.empty()) {
+        if (trade.store.open(g_cfg.trade_message_store)) {
+            trade.seq = static_cast<int>(trade.store.nextOutSeq());
+            std::cout << "[TRADE] MESSAGE STORE " << g_cfg.trade_message_store
+                      << " NEXT SEQ " << trade.seq << "\n";
+        } else {
+            std::cout << "[WARN] CANNOT OPEN " << g_cfg.trade_message_store << "\n";
+        }
+    }
     std::cout << "[TRADE] Connecting to: " << g_cfg.host << ":" << g_cfg.trade_port << "\n";
-    trade.ssl = connect_ssl(g_cfg.host, g_cfg.trade_port);
+    trade.ssl = connect_ssl(g_cfg.host, g_cfg.trade_port, trade.timing);
     if (!trade.ssl) {
         std::cout << "[ERROR] TRADE SSL FAILED\n";
         return 1;
     }
     std::cout << "[TRADE] SSL CONNECTED\n";
 
-    std::string tlogon = build_trade_logon(trade.seq++);
-    std::cout << "[DEBUG] TRADE LOGON: " << tlogon << "\n";
-    SSL_write(trade.ssl, tlogon.c_str(), tlogon.size());
+    std::string_view tlogon = build_logon(trade);
+    trade.logon_sent_ns = plat::monotonic_time_ns();
+    send_fix(trade, tlogon);
     std::cout << "[TRADE] LOGON SENT\n\n";
 
+    // From here the quote thread writes orders on trade.ssl while the
+    // trade thread reads it
+    trade.shared_ssl = true;
+    SSL_set_mode(trade.ssl, SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+    if (!plat::set_nonblocking(static_cast<socket_t>(SSL_get_fd(trade.ssl)), true)) {
+        std::cout << "[ERROR] TRADE SOCKET NOT NON-BLOCKING\n";
+        return 1;
+    }
+
+    // Order entry on the TRADE session; symbols are cTrader SecurityIDs,
+    // added from the directory once the QUOTE session's SecurityList is in
+    TradeWire trade_wire(trade);
+    chimera::FixOrderEntry orders(session_ids(trade), trade_wire, &g_latency_attr);
+    trade.order_entry = &orders;
+    bool order_symbols = false;
+
+    // Strategy to orders; runs on the quote thread once published below
+    chimera::ExecutionBridgeFix bridge(g_cfg.max_usd, &orders);
+
     std::cout << ">>> Dashboard: http://localhost:8080\n";
     std::cout << "========================================\n\n";
 
@@ -539,10 +881,23 @@ int main(int argc, char* argv[])
     qthread.detach();
     tthread.detach();
 
-    while (g_running)
-        Sleep(1000);
+    while (g_running) {
+        if (!order_symbols && g_symbols.ready()) {
+            for (chimera::FixSymbolHandle h = 0; h < g_symbols.size(); ++h) {
+                const chimera::FixSymbol& s = g_symbols[h];
+                if (s.listed) orders.add_symbol(s.name, std::to_string(s.id), s.digits, g_cfg.qty_digits, 1);
+            }
+            order_symbols = true;
+            // Symbols are complete before the quote thread can send
+            if (g_cfg.trading) {
+                g_bridge.store(&bridge, std::memory_order_release);
+                std::cout << "[EXECUTION] BRIDGE ENABLED, MAX USD " << g_cfg.max_usd << "\n";
+            }
+        }
+        plat::sleep_us(1000000);
+    }
 
-    WSACleanup();
+    plat::cleanup();
 
     if (g_singleton_mutex) {
         ReleaseMutex(g_singleton_mutex);
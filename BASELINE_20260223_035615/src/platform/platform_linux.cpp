@@ -0,0 +1,237 @@
+#ifndef _WIN32
+
+#include "../../include/platform/platform.hpp"
+#include <netdb.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <cstring>
+
+namespace plat {
+
+namespace {
+
+bool set_int_opt(socket_t s, int level, int name, int value) {
+    return setsockopt(s, level, name, &value, sizeof(value)) == 0;
+}
+
+uint64_t clock_ns(clockid_t id) {
+    timespec ts;
+    clock_gettime(id, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull +
+           static_cast<uint64_t>(ts.tv_nsec);
+}
+
+}
+
+bool init() {
+    // SSL_write on a connection the peer reset must fail, not kill the process
+    signal(SIGPIPE, SIG_IGN);
+    return true;
+}
+
+void cleanup() {
+}
+
+int last_error() {
+    return errno;
+}
+
+bool would_block(int e) {
+    return e == EAGAIN || e == EWOULDBLOCK;
+}
+
+socket_t create_tcp() {
+    return socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, IPPROTO_TCP);
+}
+
+bool set_nonblocking(socket_t s, bool enable) {
+    int flags = fcntl(s, F_GETFL, 0);
+    if (flags < 0) return false;
+    flags = enable ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+    return fcntl(s, F_SETFL, flags) == 0;
+}
+
+bool set_nodelay(socket_t s) {
+    return set_int_opt(s, IPPROTO_TCP, TCP_NODELAY, 1);
+}
+
+bool set_reuseaddr(socket_t s) {
+    return set_int_opt(s, SOL_SOCKET, SO_REUSEADDR, 1);
+}
+
+int socket_send(socket_t s, const void* buf, int len) {
+    return static_cast<int>(send(s, buf, static_cast<size_t>(len), MSG_NOSIGNAL));
+}
+
+int socket_recv(socket_t s, void* buf, int len) {
+    return static_cast<int>(recv(s, buf, static_cast<size_t>(len), 0));
+}
+
+bool socket_shutdown(socket_t s) {
+    return shutdown(s, SHUT_RDWR) == 0;
+}
+
+void socket_close(socket_t s) {
+    close(s);
+}
+
+void sleep_us(uint64_t usec) {
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(usec / 1000000);
+    ts.tv_nsec = static_cast<long>((usec % 1000000) * 1000);
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {}
+}
+
+uint64_t monotonic_time_us() {
+    return clock_ns(CLOCK_MONOTONIC) / 1000;
+}
+
+bool resolve_ipv4(const char* host, uint16_t port, sockaddr_in& out) {
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* res = nullptr;
+    if (getaddrinfo(host, nullptr, &hints, &res) != 0 || !res) return false;
+    std::memcpy(&out, res->ai_addr, sizeof(out));
+    out.sin_port = htons(port);
+    freeaddrinfo(res);
+    return true;
+}
+
+int socket_connect(socket_t s, const sockaddr_in& addr) {
+    return connect(s, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0 ? 0 : -1;
+}
+
+bool connect_in_progress(int e) {
+    return e == EINPROGRESS;
+}
+
+bool socket_listen(socket_t s, uint16_t port, int backlog) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(port);
+    if (bind(s, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) return false;
+    return listen(s, backlog) == 0;
+}
+
+socket_t socket_accept(socket_t s) {
+    return accept4(s, nullptr, nullptr, SOCK_CLOEXEC);
+}
+
+int wait_readable(socket_t s, int timeout_ms) {
+    pollfd p{};
+    p.fd = s;
+    p.events = POLLIN;
+    int rc = poll(&p, 1, timeout_ms);
+    if (rc < 0) return errno == EINTR ? 0 : -1;
+    return rc > 0 ? 1 : 0;
+}
+
+int wait_writable(socket_t s, int timeout_ms) {
+    pollfd p{};
+    p.fd = s;
+    p.events = POLLOUT;
+    int rc = poll(&p, 1, timeout_ms);
+    if (rc < 0) return errno == EINTR ? 0 : -1;
+    return rc > 0 ? 1 : 0;
+}
+
+bool set_quickack(socket_t s) {
+    return set_int_opt(s, IPPROTO_TCP, TCP_QUICKACK, 1);
+}
+
+bool set_busy_poll(socket_t s, int usec) {
+#ifdef SO_BUSY_POLL
+    return set_int_opt(s, SOL_SOCKET, SO_BUSY_POLL, usec);
+#else
+    (void)s;
+    (void)usec;
+    return false;
+#endif
+}
+
+bool set_rcvbuf(socket_t s, int bytes) {
+    return set_int_opt(s, SOL_SOCKET, SO_RCVBUF, bytes);
+}
+
+bool set_sndbuf(socket_t s, int bytes) {
+    return set_int_opt(s, SOL_SOCKET, SO_SNDBUF, bytes);
+}
+
+uint64_t monotonic_time_ns() {
+    return clock_ns(CLOCK_MONOTONIC);
+}
+
+uint64_t monotonic_raw_time_ns() {
+#ifdef CLOCK_MONOTONIC_RAW
+    return clock_ns(CLOCK_MONOTONIC_RAW);
+#else
+    return clock_ns(CLOCK_MONOTONIC);
+#endif
+}
+
+uint64_t realtime_ns() {
+    return clock_ns(CLOCK_REALTIME);
+}
+
+bool set_thread_name(const char* name) {
+    char buf[16];
+    std::strncpy(buf, name, sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = '\0';
+    return pthread_setname_np(pthread_self(), buf) == 0;
+}
+
+bool pin_thread(int cpu) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+int cpu_count() {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? static_cast<int>(n) : 1;
+}
+
+bool map_file(const char* path, uint64_t size, mapped_file& out) {
+    int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        (static_cast<uint64_t>(st.st_size) < size && ftruncate(fd, static_cast<off_t>(size)) != 0)) {
+        close(fd);
+        return false;
+    }
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    out.data = p;
+    out.size = size;
+    out.file = fd;
+    out.mapping = 0;
+    return true;
+}
+
+void unmap_file(mapped_file& m) {
+    if (m.data) munmap(m.data, m.size);
+    if (m.file >= 0) close(static_cast<int>(m.file));
+    m = mapped_file();
+}
+
+bool flush_file(mapped_file& m, bool wait) {
+    if (!m.data) return false;
+    return msync(m.data, m.size, wait ? MS_SYNC : MS_ASYNC) == 0;
+}
+
+}
+
+#endif
@@ -1,7 +1,10 @@
 #ifdef _WIN32
 
 #include "../../include/platform/platform.hpp"
+#include <windows.h>
+#include <winioctl.h>
 #include <chrono>
+#include <cstring>
 #include <thread>
 
 namespace plat {
@@ -71,7 +74,153 @@ uint64_t monotonic_time_us() {
     ).count();
 }
 
+bool resolve_ipv4(const char* host, uint16_t port, sockaddr_in& out) {
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* res = nullptr;
+    if (getaddrinfo(host, nullptr, &hints, &res) != 0 || !res) return false;
+    memcpy(&out, res->ai_addr, sizeof(out));
+    out.sin_port = htons(port);
+    freeaddrinfo(res);
+    return true;
 }
 
-#endif
+int socket_connect(socket_t s, const sockaddr_in& addr) {
+    return connect(s, (const sockaddr*)&addr, sizeof(addr)) == 0 ? 0 : -1;
+}
+
+bool connect_in_progress(int e) {
+    return e == WSAEWOULDBLOCK;
+}
+
+bool socket_listen(socket_t s, uint16_t port, int backlog) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(port);
+    if (bind(s, (const sockaddr*)&addr, sizeof(addr)) != 0) return false;
+    return listen(s, backlog) == 0;
+}
+
+socket_t socket_accept(socket_t s) {
+    return accept(s, nullptr, nullptr);
+}
+
+int wait_readable(socket_t s, int timeout_ms) {
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(s, &fds);
+    timeval tv{timeout_ms / 1000, (timeout_ms % 1000) * 1000};
+    int rc = select(0, &fds, nullptr, nullptr, timeout_ms < 0 ? nullptr : &tv);
+    if (rc == SOCKET_ERROR) return -1;
+    return rc > 0 ? 1 : 0;
+}
+
+int wait_writable(socket_t s, int timeout_ms) {
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(s, &fds);
+    timeval tv{timeout_ms / 1000, (timeout_ms % 1000) * 1000};
+    int rc = select(0, nullptr, &fds, nullptr, timeout_ms < 0 ? nullptr : &tv);
+    if (rc == SOCKET_ERROR) return -1;
+    return rc > 0 ? 1 : 0;
+}
+
+// No per-socket quick-ACK or busy-poll on Windows
+bool set_quickack(socket_t) {
+    return false;
+}
+
+bool set_busy_poll(socket_t, int) {
+    return false;
+}
+
+bool set_rcvbuf(socket_t s, int bytes) {
+    return setsockopt(s, SOL_SOCKET, SO_RCVBUF,
+        (const char*)&bytes, sizeof(bytes)) == 0;
+}
+
+bool set_sndbuf(socket_t s, int bytes) {
+    return setsockopt(s, SOL_SOCKET, SO_SNDBUF,
+        (const char*)&bytes, sizeof(bytes)) == 0;
+}
 
+uint64_t monotonic_time_ns() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(
+        steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+// QueryPerformanceCounter is never slewed
+uint64_t monotonic_raw_time_ns() {
+    return monotonic_time_ns();
+}
+
+uint64_t realtime_ns() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(
+        system_clock::now().time_since_epoch()
+    ).count();
+}
+
+bool set_thread_name(const char* name) {
+    wchar_t wname[64];
+    if (MultiByteToWideChar(CP_UTF8, 0, name, -1, wname, 64) == 0) return false;
+    return SUCCEEDED(SetThreadDescription(GetCurrentThread(), wname));
+}
+
+bool pin_thread(int cpu) {
+    if (cpu < 0 || cpu >= 64) return false;
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+}
+
+int cpu_count() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n > 0 ? static_cast<int>(n) : 1;
+}
+
+bool map_file(const char* path, uint64_t size, mapped_file& out) {
+    HANDLE f = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                           OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (f == INVALID_HANDLE_VALUE) return false;
+    DWORD ignored = 0;
+    DeviceIoControl(f, FSCTL_SET_SPARSE, nullptr, 0, nullptr, 0, &ignored, nullptr);
+
+    // The mapping extends the file to size if it is shorter
+    HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READWRITE,
+                                  static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), nullptr);
+    if (!m) {
+        CloseHandle(f);
+        return false;
+    }
+    void* p = MapViewOfFile(m, FILE_MAP_ALL_ACCESS, 0, 0, static_cast<SIZE_T>(size));
+    if (!p) {
+        CloseHandle(m);
+        CloseHandle(f);
+        return false;
+    }
+    out.data = p;
+    out.size = size;
+    out.file = reinterpret_cast<intptr_t>(f);
+    out.mapping = reinterpret_cast<intptr_t>(m);
+    return true;
+}
+
+void unmap_file(mapped_file& m) {
+    if (m.data) UnmapViewOfFile(m.data);
+    if (m.mapping) CloseHandle(reinterpret_cast<HANDLE>(m.mapping));
+    if (m.file != -1) CloseHandle(reinterpret_cast<HANDLE>(m.file));
+    m = mapped_file();
+}
+
+bool flush_file(mapped_file& m, bool wait) {
+    if (!m.data) return false;
+    if (!FlushViewOfFile(m.data, 0)) return false;
+    return !wait || FlushFileBuffers(reinterpret_cast<HANDLE>(m.file));
+}
+
+}
+
+#endif
@@ -18,6 +18,15 @@
 // SHARED MEMORY STRUCTURE (must match TelemetrySnapshot.hpp)
 // ═══════════════════════════════════════════════════════════════════════════
 
+constexpr uint32_t TELEMETRY_MAX_SYMBOLS = 64;
+
+struct TelemetryQuote
+{
+    char symbol[16];
+    double bid;
+    double ask;
+};
+
 struct TelemetrySnapshot
 {
     std::atomic<uint64_t> sequence;
@@ -49,6 +58,10 @@ struct TelemetrySnapshot
 
     char hft_trigger[32];
     char strategy_trigger[32];
+
+    // Every subscribed symbol, by symbol directory handle
+    uint32_t symbol_count;
+    TelemetryQuote quotes[TELEMETRY_MAX_SYMBOLS];
 };
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -73,13 +86,15 @@ bool SnapshotRead(TelemetrySnapshot& out)
     uint64_t seq1;
     uint64_t seq2;
 
+    // Odd while the writer is mid-update
     do
     {
         seq1 = g_snapshot->sequence.load(std::memory_order_acquire);
         std::memcpy(&out, g_snapshot, sizeof(TelemetrySnapshot));
-        seq2 = g_snapshot->sequence.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        seq2 = g_snapshot->sequence.load(std::memory_order_relaxed);
 
-    } while (seq1 != seq2);
+    } while ((seq1 & 1) || seq1 != seq2);
 
     return true;
 }
@@ -168,7 +183,7 @@ void send_text_frame(SOCKET s,const std::string& msg){
 
 void websocket_loop(SOCKET s){
     TelemetrySnapshot snap;
-    char json_buffer[1024];
+    char json_buffer[8192];
     
     while(true){
         // Read from shared memory
@@ -176,8 +191,8 @@ void websocket_loop(SOCKET s){
         
         if(hasData){
             // Build JSON from REAL data
-            snprintf(json_buffer, sizeof(json_buffer),
-                R"({"xau_bid":%.2f,"xau_ask":%.2f,"xag_bid":%.2f,"xag_ask":%.2f,"hft_pnl":%.2f,"strategy_pnl":%.2f,"rtt_last":%.2f,"rtt_p50":%.2f,"rtt_p95":%.2f,"risk_mode":"%s","regime":"%s","hft_signal":"%s","structure_signal":"%s"})",
+            int len = snprintf(json_buffer, sizeof(json_buffer),
+                R"({"xau_bid":%.2f,"xau_ask":%.2f,"xag_bid":%.2f,"xag_ask":%.2f,"hft_pnl":%.2f,"strategy_pnl":%.2f,"rtt_last":%.2f,"rtt_p50":%.2f,"rtt_p95":%.2f,"vps_latency":%.2f,"risk_mode":"%s","regime":"%s","hft_signal":"%s","structure_signal":"%s","quotes":[)",
                 snap.xau_bid,
                 snap.xau_ask,
                 snap.xag_bid,
@@ -187,15 +202,30 @@ void websocket_loop(SOCKET s){
                 snap.fix_rtt_last,
                 snap.fix_rtt_p50,
                 snap.fix_rtt_p95,
+                snap.vps_latency,
                 snap.hft_regime,
                 snap.strategy_regime,
                 snap.hft_trigger,
                 snap.strategy_trigger
             );
+
+            // Per-handle quotes, in directory order; unnamed slots are skipped
+            uint32_t count = snap.symbol_count < TELEMETRY_MAX_SYMBOLS ? snap.symbol_count : TELEMETRY_MAX_SYMBOLS;
+            const char* sep = "";
+            for(uint32_t h=0; h<count && len>0 && len<(int)sizeof(json_buffer); ++h){
+                const TelemetryQuote& q = snap.quotes[h];
+                if(q.symbol[0]==0) continue;
+                len += snprintf(json_buffer+len, sizeof(json_buffer)-len,
+                    R"(%s{"handle":%u,"symbol":"%.*s","bid":%.5f,"ask":%.5f})",
+                    sep, h, (int)sizeof(q.symbol), q.symbol, q.bid, q.ask);
+                sep = ",";
+            }
+            if(len>0 && len<(int)sizeof(json_buffer))
+                snprintf(json_buffer+len, sizeof(json_buffer)-len, "]}");
         }else{
             // Fallback to dummy data if shared memory not available
             snprintf(json_buffer, sizeof(json_buffer),
-                R"({"xau_bid":0,"xau_ask":0,"xag_bid":0,"xag_ask":0,"hft_pnl":0,"strategy_pnl":0,"rtt_last":0,"rtt_p50":0,"rtt_p95":0,"risk_mode":"WAITING","regime":"DISCONNECTED","hft_signal":"NONE","structure_signal":"NONE"})"
+                R"({"xau_bid":0,"xau_ask":0,"xag_bid":0,"xag_ask":0,"hft_pnl":0,"strategy_pnl":0,"rtt_last":0,"rtt_p50":0,"rtt_p95":0,"vps_latency":0,"risk_mode":"WAITING","regime":"DISCONNECTED","hft_signal":"NONE","structure_signal":"NONE","quotes":[]})"
             );
         }
         
@@ -0,0 +1,114 @@
+#pragma once
+
+// ChimeraMetals benchmarks
+// BenchCommon.hpp - Allocation counter, timer and FIX payload generator
+//
+// Replaces global operator new/delete to count heap allocations, so include it
+// from exactly one translation unit per benchmark binary.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+inline std::atomic<uint64_t> g_allocs{0};
+
+inline uint64_t allocs() {
+    return g_allocs.load(std::memory_order_relaxed);
+}
+
+inline uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Keeps the optimiser from discarding benchmark results
+template <typename T>
+inline void doNotOptimize(const T& v) {
+    static volatile T sink;
+    sink = v;
+    (void)sink;
+}
+
+inline std::string wrapFix(const std::string& body) {
+    std::string msg = "8=FIX.4.4\x01" "9=" + std::to_string(body.size()) + "\x01" + body;
+    unsigned sum = 0;
+    for (unsigned char c : msg) sum += c;
+    char cs[8];
+    std::snprintf(cs, sizeof(cs), "10=%03u\x01", sum % 256);
+    return msg + cs;
+}
+
+// cTrader-shaped 35=X incremental refresh with `entries` bid/offer updates
+inline std::string makeIncremental(int seq, int entries, int symbol = 41) {
+    std::string body = "35=X\x01" "49=cServer\x01" "56=demo.blackbull.2067070\x01"
+                       "50=QUOTE\x01" "57=QUOTE\x01"
+                       "34=" + std::to_string(seq) + "\x01"
+                       "52=20260223-03:56:15.123\x01"
+                       "268=" + std::to_string(entries) + "\x01";
+    for (int i = 0; i < entries; ++i) {
+        body += "279=0\x01" "269=" + std::string(i % 2 ? "1" : "0") + "\x01"
+                "278=" + std::to_string(100000 + seq * 8 + i) + "\x01"
+                "55=" + std::to_string(symbol) + "\x01"
+                "270=" + std::to_string(5173 + i) + ".3" + std::to_string(i % 10) + "\x01"
+                "271=" + std::to_string(100000 * (i + 1)) + "\x01";
+    }
+    return wrapFix(body);
+}
+
+// 35=W full snapshot with `levels` levels per side
+inline std::string makeSnapshot(int seq, int levels, int symbol = 41) {
+    std::string body = "35=W\x01" "49=cServer\x01" "56=demo.blackbull.2067070\x01"
+                       "50=QUOTE\x01" "57=QUOTE\x01"
+                       "34=" + std::to_string(seq) + "\x01"
+                       "52=20260223-03:56:15.123\x01"
+                       "55=" + std::to_string(symbol) + "\x01"
+                       "268=" + std::to_string(levels * 2) + "\x01";
+    for (int i = 0; i < levels; ++i) {
+        body += "269=0\x01" "270=" + std::to_string(5173 - i) + ".34\x01" "271=500000\x01";
+        body += "269=1\x01" "270=" + std::to_string(5175 + i) + ".86\x01" "271=500000\x01";
+    }
+    return wrapFix(body);
+}
+
+inline void report(const char* name, uint64_t msgs, uint64_t bytes, uint64_t ns, uint64_t allocs) {
+    double sec = static_cast<double>(ns) / 1e9;
+    std::printf("%-34s %12.0f msgs/s %9.1f MB/s %8.3f allocs/msg\n",
+                name,
+                msgs / sec,
+                bytes / sec / 1e6,
+                msgs ? static_cast<double>(allocs) / msgs : 0.0);
+}
+
+} // namespace bench
+
+// Not inlined, so GCC does not pair an inlined free() with new at the call
+// site and warn (-Wmismatched-new-delete)
+#if defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+BENCH_NOINLINE void* operator new(std::size_t n) {
+    bench::g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+
+BENCH_NOINLINE void* operator new[](std::size_t n) {
+    bench::g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+
+BENCH_NOINLINE void operator delete(void* p) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete[](void* p) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+BENCH_NOINLINE void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
@@ -0,0 +1,213 @@
+// ChimeraMetals benchmarks
+// bench_fix_book.cpp - L2 book apply: ordered maps vs flat-array FixBook
+//
+// "maps" is the obvious book: a std::map of price -> size per side and an
+// unordered_map of MDEntryID -> entry so Deletes can find their level.
+// "flat" is FixBook: tick-offset arrays, a bitmap per side, cached best
+// prices and a fixed open-addressed entry table.
+//
+// The stream is cTrader-shaped: each update adds an entry near a drifting
+// mid and deletes an older one by 278 alone. After every update both books
+// are read the way an engine would (depth_top, depth over 5 levels,
+// imbalance). Before timing, FixBook is walked through entry and
+// price-level updates, size-only changes, a recenter and a table drain.
+
+#include "BenchCommon.hpp"
+#include "core/FixBook.hpp"
+
+#include <cmath>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+chimera::FixMdEntry entry(const char* id, chimera::FixMdAction action, char type, int64_t ticks = -1,
+                          int64_t size = -1) {
+    chimera::FixMdEntry e{};
+    e.symbol_id = 41;
+    e.entry_id = id;
+    e.action = action;
+    e.type = type;
+    e.has_price = ticks >= 0;
+    e.has_size = size >= 0;
+    e.price = chimera::FixPrice{ticks < 0 ? 0 : ticks, 2};
+    e.size = size < 0 ? 0 : size;
+    return e;
+}
+
+bool near(double a, double b) {
+    return std::fabs(a - b) < 1e-9;
+}
+
+bool checkBook() {
+    using A = chimera::FixMdAction;
+    static chimera::FixBook b(2);
+
+    b.apply(entry("1", A::New, '0', 265000, 100));
+    b.apply(entry("2", A::New, '0', 264999, 200));
+    b.apply(entry("3", A::New, '1', 265005, 150));
+    b.apply(entry("4", A::New, '1', 265005, 50));
+    if (b.bidTicks() != 265000 || b.bidSize() != 100 || b.askTicks() != 265005 || b.askSize() != 200) return false;
+    if (!near(b.depthTop(), 3.0) || !near(b.bidDepth(5), 3.0) || !near(b.askDepth(5), 2.0) ||
+        !near(b.imbalance(5), 0.2))
+        return false;
+
+    // Delete by 278 alone, without 269; a size-only Change keeps the level
+    b.apply(entry("1", A::Delete, '\0'));
+    if (b.bidTicks() != 264999 || b.bidSize() != 200) return false;
+    b.apply(entry("3", A::Change, '\0', -1, 25));
+    if (b.askTicks() != 265005 || b.askSize() != 75) return false;
+    if (b.apply(entry("9", A::New, '\0', 265001, 10))) return false;
+    b.apply(entry("3", A::Delete, '\0'));
+    b.apply(entry("4", A::Delete, '1'));
+    if (b.hasAsk() || b.levels(false) != 0) return false;
+
+    // 50 dollars away: the window moves and the old bid falls off
+    b.apply(entry("5", A::New, '0', 270000, 100));
+    if (b.recenters() != 1 || b.dropped() != 1 || b.bidTicks() != 270000 || b.levels(true) != 1) return false;
+    b.apply(entry("2", A::Delete, '0'));
+    if (b.bidTicks() != 270000) return false;
+
+    // Price-level updates (no 278) set and clear
+    b.apply(entry("", A::New, '1', 270010, 300));
+    b.apply(entry("", A::Change, '1', 270010, 100));
+    if (b.askTicks() != 270010 || b.askSize() != 100) return false;
+    b.apply(entry("", A::Delete, '1', 270010));
+    if (b.hasAsk()) return false;
+
+    // Fill and drain the entry table; every level must empty again
+    std::vector<std::string> ids;
+    for (int i = 0; i < 3000; ++i) {
+        std::string id = std::to_string(i * 7919);
+        id.insert(0, 1, 'E');
+        ids.push_back(id);
+    }
+    for (int i = 0; i < 3000; ++i) b.apply(entry(ids[i].c_str(), A::New, i & 1 ? '1' : '0', 270000 + (i & 1 ? 1 : -1) * (i / 2 % 50 + 1), 10));
+    if (b.entries() != 3001 || b.levels(true) != 51 || b.levels(false) != 50) return false;
+    for (int i = 2999; i >= 0; i -= 2) b.apply(entry(ids[i].c_str(), A::Delete, '1'));
+    for (int i = 0; i < 3000; i += 2) b.apply(entry(ids[i].c_str(), A::Delete, '0'));
+    if (b.entries() != 1 || b.levels(false) != 0 || b.levels(true) != 1 || b.bidSize() != 100) return false;
+
+    // Snapshot through FixBookSet clears first
+    chimera::FixSymbolDirectory dir;
+    dir.configure("41");
+    chimera::FixBookSet books(dir);
+    chimera::FixPricePrecision precision;
+    precision.set(41, 2);
+    chimera::FixMdBatch batch;
+    static chimera::FixTagIndex idx;
+    chimera::FixSymbolHandle touched[4];
+    idx.parse(bench::makeIncremental(1, 4));
+    chimera::FixMdDecoder::decode(idx, precision, batch);
+    books.apply(batch, touched, 4);
+    idx.parse(bench::makeSnapshot(2, 3));
+    chimera::FixMdDecoder::decode(idx, precision, batch);
+    if (books.apply(batch, touched, 4) != 1 || touched[0] != 0) return false;
+    chimera::FixDepth d = books.depth(0);
+    return books.book(0).levels(true) == 3 && near(d.depth_top, 1000000.0) && d.updates == 2 && near(d.imbalance, 0.0);
+}
+
+// The book as a pair of ordered maps and an entry hash
+class MapBook {
+public:
+    void apply(const chimera::FixMdEntry& e) {
+        std::map<int64_t, int64_t>* side = e.type == '0' ? &bids_ : &asks_;
+        std::string id(e.entry_id);
+        auto it = entries_.find(id);
+        if (it != entries_.end()) {
+            std::map<int64_t, int64_t>& s = it->second.bid ? bids_ : asks_;
+            auto lv = s.find(it->second.ticks);
+            if (lv != s.end() && (lv->second -= it->second.size) <= 0) s.erase(lv);
+            entries_.erase(it);
+        }
+        if (e.action == chimera::FixMdAction::Delete || !e.has_price) return;
+        (*side)[e.price.ticks] += e.size;
+        entries_[id] = Entry{e.price.ticks, e.size, e.type == '0'};
+    }
+
+    double depthTop() const {
+        int64_t b = bids_.empty() ? 0 : bids_.rbegin()->second;
+        int64_t a = asks_.empty() ? 0 : asks_.begin()->second;
+        return static_cast<double>(b + a) / 100.0;
+    }
+
+    double imbalance(size_t n) const {
+        int64_t b = 0, a = 0;
+        size_t k = 0;
+        for (auto it = bids_.rbegin(); it != bids_.rend() && k < n; ++it, ++k) b += it->second;
+        k = 0;
+        for (auto it = asks_.begin(); it != asks_.end() && k < n; ++it, ++k) a += it->second;
+        return b + a > 0 ? static_cast<double>(b - a) / static_cast<double>(b + a) : 0.0;
+    }
+
+private:
+    struct Entry {
+        int64_t ticks;
+        int64_t size;
+        bool bid;
+    };
+    std::map<int64_t, int64_t> bids_, asks_;
+    std::unordered_map<std::string, Entry> entries_;
+};
+
+} // namespace
+
+int main() {
+    if (!checkBook()) {
+        std::fprintf(stderr, "book check failed\n");
+        return 1;
+    }
+
+    // Adds around a drifting mid; each add deletes the entry 64 adds older
+    const size_t UPDATES = 1000000;
+    std::vector<std::string> ids(UPDATES);
+    std::vector<chimera::FixMdEntry> stream;
+    stream.reserve(UPDATES * 2);
+    uint64_t rng = 0x9E3779B97F4A7C15ull;
+    int64_t mid = 265000;
+    for (size_t i = 0; i < UPDATES; ++i) {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        if (rng % 16 == 0) mid += (rng >> 8) % 3 - 1;
+        bool bid = (rng >> 16) & 1;
+        int64_t px = bid ? mid - 1 - static_cast<int64_t>((rng >> 20) % 20) : mid + 1 + static_cast<int64_t>((rng >> 20) % 20);
+        ids[i] = std::to_string(100000000 + i);
+        stream.push_back(entry(ids[i].c_str(), chimera::FixMdAction::New, bid ? '0' : '1', px,
+                               static_cast<int64_t>(100 * (1 + (rng >> 28) % 50))));
+        if (i >= 64) stream.push_back(entry(ids[i - 64].c_str(), chimera::FixMdAction::Delete, '0'));
+    }
+
+    for (int pass = 0; pass < 3; ++pass) {
+        double sink = 0;
+        {
+            MapBook book;
+            uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+            for (const chimera::FixMdEntry& e : stream) {
+                book.apply(e);
+                sink += book.depthTop() + book.imbalance(5);
+            }
+            uint64_t t1 = bench::nowNs();
+            bench::report("apply + read maps", stream.size(), 0, t1 - t0, bench::allocs() - a0);
+        }
+        {
+            static chimera::FixBook book(2);
+            book.clear();
+            uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+            for (const chimera::FixMdEntry& e : stream) {
+                book.apply(e);
+                sink += book.depthTop() + book.imbalance(5);
+            }
+            uint64_t t1 = bench::nowNs();
+            bench::report("apply + read flat", stream.size(), 0, t1 - t0, bench::allocs() - a0);
+            if (book.dropped()) {
+                std::fprintf(stderr, "flat: %llu dropped\n", static_cast<unsigned long long>(book.dropped()));
+                return 1;
+            }
+        }
+        bench::doNotOptimize(sink);
+    }
+    return 0;
+}
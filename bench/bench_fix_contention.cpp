@@ -0,0 +1,275 @@
+// ChimeraMetals benchmarks
+// bench_fix_contention.cpp - Receive path under concurrent order registration
+//
+// "locked" is the FixSession receive path as it was: every read took mtx_,
+// and sequencing, ExecID dedup, known orders and fill history all shared
+// buffer_mtx_ with registerOrder() on the order thread, and orders and
+// fills were string-keyed maps. "owned" is the current FixSession: the I/O
+// thread touches that state without locks, orders arrive through an SPSC
+// queue into the FixOrderStore and fills leave through another.
+//
+// Both feed the same stream (incremental refreshes, one execution report
+// in sixteen for one of the first 256 orders) in 4 KB reads and time each
+// read: frame, parse, sequence, dedup the ExecID, look up the ClOrdID,
+// record the fill. Each runs alone and then with an order thread
+// registering orders in bursts and draining fills, yielding between bursts. When the order thread is descheduled
+// while holding buffer_mtx_, or the two contend for its cache line on
+// separate cores, the locked I/O thread waits; the owned one never does.
+
+#include "BenchCommon.hpp"
+#include "core/FixSession.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+const int MESSAGES = 400000;
+const int EXEC_EVERY = 16;
+const size_t READ_BYTES = 4096;
+
+const uint64_t FIRST_CL_ORD_ID = 1771818975000000ull;
+
+std::string makeExec(int seq, int order) {
+    std::string body = "35=8\x01" "49=cServer\x01" "56=demo.blackbull.2067070\x01"
+                       "50=TRADE\x01" "57=TRADE\x01"
+                       "34=" + std::to_string(seq) + "\x01"
+                       "52=20260223-03:56:15.123\x01"
+                       "11=" + std::to_string(FIRST_CL_ORD_ID + order) + "\x01"
+                       "17=EXE" + std::to_string(900000000 + seq) + "\x01"
+                       "150=F\x01" "39=2\x01" "55=41\x01" "54=1\x01"
+                       "32=1\x01" "31=5173.34\x01";
+    return bench::wrapFix(body);
+}
+
+std::string buildStream() {
+    std::string wire;
+    for (int seq = 1; seq <= MESSAGES; ++seq) {
+        if (seq % EXEC_EVERY == 0) wire += makeExec(seq, (seq / EXEC_EVERY) % 256 + 1);
+        else wire += bench::makeIncremental(seq, 2);
+    }
+    return wire;
+}
+
+// The pre-ownership FixSession receive path, reduced to what it locked
+class LockedSession {
+public:
+    void read(const char* data, size_t size) {
+        std::lock_guard<std::mutex> lg(mtx_);      // sslRead
+        ring_.append(data, size);
+    }
+
+    template <typename Fn>
+    void forEachMessage(Fn&& fn) {
+        std::string_view msg;
+        while (ring_.next(msg) == chimera::FixRecvRing::Frame::Complete) {
+            if (!idx_.parse(msg)) continue;
+            const chimera::FixTagIndex::Field& cs = idx_.field(idx_.fieldCount() - 1);
+            bench::doNotOptimize(chimera::fixChecksum(msg.data(), cs.offset - 3));
+            last_inbound_ns_.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                                   std::memory_order_release);
+            fn(msg, static_cast<const chimera::FixTagIndex&>(idx_));
+        }
+    }
+
+    bool sequence(int64_t seq) {
+        std::lock_guard<std::mutex> lg(buffer_mtx_);
+        if (seq != expected_) return false;
+        ++expected_;
+        return true;
+    }
+
+    bool markExecProcessed(std::string_view id) {
+        std::lock_guard<std::mutex> lg(buffer_mtx_);
+        return exec_ids_.insert(id, 0);
+    }
+
+    bool registerOrder(uint64_t id) {
+        std::string key = std::to_string(id);
+        std::lock_guard<std::mutex> lg(buffer_mtx_);
+        known_orders_[key] = true;
+        return true;
+    }
+
+    // True if the order is known; the fill is recorded either way
+    bool onExecution(const chimera::FixTagIndex& idx) {
+        bool known = isKnownOrder(std::string(idx.get(11)));
+        recordFill(std::string(idx.get(17)), 1.0, 5173.34, true);
+        return known;
+    }
+
+    bool isKnownOrder(const std::string& id) {
+        std::lock_guard<std::mutex> lg(buffer_mtx_);
+        return known_orders_.count(id) > 0;
+    }
+
+    void recordFill(const std::string& id, double qty, double price, bool is_buy) {
+        std::lock_guard<std::mutex> lg(buffer_mtx_);
+        fills_[id] = std::make_tuple(qty, price, is_buy);
+    }
+
+    // The order thread polled fills the same way
+    size_t fillCount() {
+        std::lock_guard<std::mutex> lg(buffer_mtx_);
+        return fills_.size();
+    }
+
+private:
+    std::mutex mtx_;
+    std::mutex buffer_mtx_;
+    chimera::FixRecvRing ring_;
+    chimera::FixTagIndex idx_;
+    std::atomic<long long> last_inbound_ns_{0};
+    int64_t expected_ = 1;
+    chimera::FixExecIdWindow exec_ids_;
+    std::unordered_map<std::string, bool> known_orders_;
+    std::unordered_map<std::string, std::tuple<double, double, bool>> fills_;
+};
+
+// Adapts chimera::FixSession to the same calls
+struct OwnedSession {
+    chimera::FixSession s;
+
+    void read(const char* data, size_t size) { s.appendToBuffer(data, static_cast<int>(size)); }
+
+    template <typename Fn>
+    void forEachMessage(Fn&& fn) { s.forEachCompleteMessage(fn); }
+
+    bool sequence(int64_t seq) {
+        chimera::FixResendRange resend;
+        return s.sequenceInbound(seq, std::string_view(), resend, false) == chimera::FixSeqAction::Process;
+    }
+
+    bool markExecProcessed(std::string_view id) { return s.markExecProcessed(id); }
+
+    bool registerOrder(uint64_t id) {
+        chimera::FixOrderNote note;
+        note.id = id;
+        note.qty = 100;
+        note.price = 517334;
+        note.symbol = 41;
+        note.digits = 2;
+        return s.registerOrder(note);
+    }
+
+    bool onExecution(const chimera::FixTagIndex& idx) { return s.applyExecutionReport(idx) != nullptr; }
+};
+
+struct Result {
+    uint64_t ns = 0;
+    uint64_t messages = 0;
+    uint64_t fills = 0;
+    uint64_t known = 0;
+    uint64_t registered = 0;
+    bool in_order = true;
+    std::vector<uint64_t> read_ns;
+};
+
+template <typename Session, typename Drain>
+Result run(Session& session, const std::string& wire, bool with_orders, Drain drain) {
+    Result r;
+    r.read_ns.reserve(wire.size() / READ_BYTES + 1);
+    std::atomic<bool> done{false};
+
+    std::thread orders;
+    if (with_orders) {
+        orders = std::thread([&] {
+            uint64_t i = 1;
+            while (!done.load(std::memory_order_acquire)) {
+                // Bursts of eight, as a strategy reacting to a tick would
+                for (int k = 0; k < 8; ++k) {
+                    if (!session.registerOrder(FIRST_CL_ORD_ID + i)) break;
+                    ++i;
+                    ++r.registered;
+                }
+                drain();
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    uint64_t t0 = bench::nowNs();
+    for (size_t pos = 0; pos < wire.size(); pos += READ_BYTES) {
+        size_t n = std::min(READ_BYTES, wire.size() - pos);
+        uint64_t a = bench::nowNs();
+        session.read(wire.data() + pos, n);
+        session.forEachMessage([&](std::string_view, const chimera::FixTagIndex& idx) {
+            int64_t seq = 0;
+            chimera::parseFixInt(idx.get(34), seq);
+            if (!session.sequence(seq)) r.in_order = false;
+            ++r.messages;
+            if (idx.getChar(35) != '8') return;
+            std::string_view exec_id = idx.get(17);
+            if (!session.markExecProcessed(exec_id)) return;
+            if (session.onExecution(idx)) ++r.known;
+            ++r.fills;
+        });
+        r.read_ns.push_back(bench::nowNs() - a);
+    }
+    r.ns = bench::nowNs() - t0;
+
+    done.store(true, std::memory_order_release);
+    if (orders.joinable()) orders.join();
+    std::sort(r.read_ns.begin(), r.read_ns.end());
+    return r;
+}
+
+void print(const char* name, const Result& r) {
+    auto pct = [&r](double p) {
+        size_t i = static_cast<size_t>(p * (r.read_ns.size() - 1));
+        return r.read_ns[i] / 1000.0;
+    };
+    std::printf("%-22s %10.0f msgs/s  read p50 %7.2f us  p99 %8.2f us  p99.9 %9.2f us  max %9.2f us"
+                "  orders %8llu  known %6llu\n",
+                name, r.messages / (r.ns / 1e9), pct(0.5), pct(0.99), pct(0.999), pct(1.0),
+                static_cast<unsigned long long>(r.registered), static_cast<unsigned long long>(r.known));
+}
+
+// fills_seen: what the consumer got, expected_seen: what it should have
+bool check(const char* name, const Result& r, uint64_t fills_seen, uint64_t expected_seen) {
+    uint64_t execs = MESSAGES / EXEC_EVERY;
+    if (r.in_order && r.messages == MESSAGES && r.fills == execs && fills_seen == expected_seen) return true;
+    std::fprintf(stderr, "%s: %llu msgs, %llu fills recorded, %llu seen, in order %d\n", name,
+                 static_cast<unsigned long long>(r.messages), static_cast<unsigned long long>(r.fills),
+                 static_cast<unsigned long long>(fills_seen), r.in_order ? 1 : 0);
+    return false;
+}
+
+} // namespace
+
+int main() {
+    const std::string wire = buildStream();
+    std::printf("%d messages, %zu bytes in %zu-byte reads, %u cpus online\n\n", MESSAGES, wire.size(),
+                READ_BYTES, std::thread::hardware_concurrency());
+
+    bool ok = true;
+    for (int with_orders = 0; with_orders < 2; ++with_orders) {
+        {
+            LockedSession session;
+            Result r = run(session, wire, with_orders, [&] { bench::doNotOptimize(session.fillCount()); });
+            print(with_orders ? "locked + order thread" : "locked", r);
+            ok &= check("locked", r, session.fillCount(), r.fills);
+        }
+        {
+            std::unique_ptr<OwnedSession> session(new OwnedSession);
+            uint64_t seen = 0;
+            chimera::FixFillEvent ev;
+            auto drain = [&] {
+                while (session->s.nextFill(ev)) ++seen;
+            };
+            Result r = run(*session, wire, with_orders, drain);
+            drain();
+            print(with_orders ? "owned + order thread" : "owned", r);
+            // Only fills of registered orders are queued
+            ok &= check("owned", r, seen, r.known);
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+// ChimeraMetals benchmarks
+// bench_fix_encode.cpp - Outbound encoding: stringstream builders vs FixEncoder templates
+//
+// "legacy" mirrors the old build_heartbeat / wrap_fix path: two stringstreams
+// and a separate checksum pass. "template" patches MsgSeqNum, SendingTime and
+// the variable fields into a pre-rendered FixMsgTemplate. Both produce a
+// Heartbeat (35=0 with 112) and a NewOrderSingle (35=D). The "now" cases add
+// a clock read per message: formatting 52 from scratch vs the per-thread
+// FixTimestampCache behind begin(tmpl, seq).
+
+#include "BenchCommon.hpp"
+#include "core/FixEncoder.hpp"
+#include "core/FixRecvRing.hpp"
+#include "core/FixTagIndex.hpp"
+#include "core/FixTime.hpp"
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace {
+
+const char* SENDER = "demo.blackbull.2067070";
+const char* TARGET = "cServer";
+
+std::string legacyWrap(const std::string& body) {
+    std::stringstream msg;
+    msg << "8=FIX.4.4\x01" << "9=" << body.size() << "\x01" << body;
+    std::string s = msg.str();
+    unsigned sum = 0;
+    for (unsigned char c : s) sum += c;
+    msg << "10=" << std::setfill('0') << std::setw(3) << (sum % 256) << "\x01";
+    return msg.str();
+}
+
+std::string legacyHeartbeat(int seq, const std::string& ts, const std::string& test_id) {
+    std::stringstream body;
+    body << "35=0\x01" << "49=" << SENDER << "\x01" << "56=" << TARGET << "\x01"
+         << "50=TRADE\x01" << "57=TRADE\x01"
+         << "34=" << seq << "\x01" << "52=" << ts << "\x01"
+         << "112=" << test_id << "\x01";
+    return legacyWrap(body.str());
+}
+
+std::string legacyOrder(int seq, const std::string& ts, int64_t cl_ord_id, double px, int qty) {
+    std::stringstream body;
+    body << "35=D\x01" << "49=" << SENDER << "\x01" << "56=" << TARGET << "\x01"
+         << "50=TRADE\x01" << "57=TRADE\x01"
+         << "34=" << seq << "\x01" << "52=" << ts << "\x01"
+         << "11=" << cl_ord_id << "\x01" << "55=41\x01" << "54=1\x01"
+         << "60=" << ts << "\x01" << "38=" << qty << "\x01" << "40=2\x01"
+         << "44=" << std::fixed << std::setprecision(2) << px << "\x01"
+         << "59=3\x01";
+    return legacyWrap(body.str());
+}
+
+// Framing + checksum must accept what the encoder produced
+bool valid(std::string_view msg) {
+    chimera::FixRecvRing ring(4096);
+    ring.append(msg.data(), msg.size());
+    std::string_view framed;
+    if (ring.next(framed) != chimera::FixRecvRing::Frame::Complete || framed.size() != msg.size()) return false;
+    chimera::FixTagIndex idx;
+    if (!idx.parse(framed)) return false;
+    const chimera::FixTagIndex::Field& cs = idx.field(idx.fieldCount() - 1);
+    unsigned want = 0;
+    for (int i = 0; i < 3; ++i) want = want * 10 + (framed[cs.offset + i] - '0');
+    return cs.tag == 10 && chimera::fixChecksum(framed.data(), cs.offset - 3) == want;
+}
+
+} // namespace
+
+int main() {
+    chimera::FixSessionIds ids;
+    ids.sender_comp_id = SENDER;
+    ids.target_comp_id = TARGET;
+    ids.sender_sub_id = "TRADE";
+    ids.target_sub_id = "TRADE";
+    chimera::FixMsgTemplate hb(ids, "0");
+    chimera::FixMsgTemplate nos(ids, "D", "55=41\x01" "54=1\x01");
+    chimera::FixStaticFields limit("40=2\x01");
+    chimera::FixSessionIds ids_ms = ids;
+    ids_ms.sending_time_precision = chimera::FixTimePrecision::Millis;
+    chimera::FixMsgTemplate hb_ms(ids_ms, "0");
+    chimera::FixEncoder enc;
+
+    char ts_buf[chimera::FIX_TIMESTAMP_MAX];
+    std::string_view ts(ts_buf, chimera::formatFixUtcTimestamp(ts_buf, chimera::fixWallClockNs(), 3));
+    std::string ts_str(ts);
+
+    // Identical bytes from both paths before anything is timed
+    std::string want_hb = legacyHeartbeat(7, ts_str, "TEST");
+    std::string_view got_hb = enc.begin(hb, 7, ts).field(112, std::string_view("TEST")).finish();
+    if (got_hb != want_hb || !valid(got_hb)) {
+        std::fprintf(stderr, "heartbeat mismatch\n%s\n%.*s\n", want_hb.c_str(), (int)got_hb.size(), got_hb.data());
+        return 1;
+    }
+    std::string want_nos = legacyOrder(8, ts_str, 1001, 5173.34, 100);
+    std::string_view got_nos = enc.begin(nos, 8, ts).field(11, int64_t{1001}).body(nos).field(60, ts)
+                                  .field(38, 100).fields(limit).price(44, 517334, 2).field(59, '3').finish();
+    if (got_nos != want_nos || !valid(got_nos)) {
+        std::fprintf(stderr, "order mismatch\n%s\n%.*s\n", want_nos.c_str(), (int)got_nos.size(), got_nos.data());
+        return 1;
+    }
+    // Cached SendingTime must match a fresh format of the same instant
+    int64_t now_ns = chimera::fixWallClockNs();
+    std::string want_ts(ts_buf, chimera::formatFixUtcTimestamp(ts_buf, now_ns, 3));
+    std::string want_cached = legacyHeartbeat(9, want_ts, "TEST");
+    std::string_view got_cached = enc.begin(hb_ms, 9, now_ns).field(112, std::string_view("TEST")).finish();
+    if (got_cached != want_cached || !valid(got_cached)) {
+        std::fprintf(stderr, "cached SendingTime mismatch\n%s\n%.*s\n", want_cached.c_str(),
+                     (int)got_cached.size(), got_cached.data());
+        return 1;
+    }
+    ts = std::string_view(ts_buf, chimera::formatFixUtcTimestamp(ts_buf, now_ns, 3));
+
+    const int N = 500000;
+    for (int pass = 0; pass < 3; ++pass) {
+        {
+            uint64_t bytes = 0, a0 = bench::allocs(), t0 = bench::nowNs();
+            for (int i = 0; i < N; ++i) bytes += legacyHeartbeat(i, ts_str, "TEST").size();
+            uint64_t t1 = bench::nowNs();
+            bench::report("heartbeat stringstream", N, bytes, t1 - t0, bench::allocs() - a0);
+        }
+        {
+            uint64_t bytes = 0, a0 = bench::allocs(), t0 = bench::nowNs();
+            for (int i = 0; i < N; ++i) bytes += enc.begin(hb, i, ts).field(112, std::string_view("TEST")).finish().size();
+            uint64_t t1 = bench::nowNs();
+            bench::report("heartbeat FixEncoder", N, bytes, t1 - t0, bench::allocs() - a0);
+        }
+        {
+            // Clock read + full UTCTimestamp format per message
+            char now_buf[chimera::FIX_TIMESTAMP_MAX];
+            uint64_t bytes = 0, a0 = bench::allocs(), t0 = bench::nowNs();
+            for (int i = 0; i < N; ++i) {
+                std::string_view now(now_buf, chimera::formatFixUtcTimestamp(now_buf, chimera::fixWallClockNs(), 3));
+                bytes += enc.begin(hb, i, now).field(112, std::string_view("TEST")).finish().size();
+            }
+            uint64_t t1 = bench::nowNs();
+            bench::report("heartbeat now, formatted", N, bytes, t1 - t0, bench::allocs() - a0);
+        }
+        {
+            // Clock read + per-thread cached second, fraction only
+            uint64_t bytes = 0, a0 = bench::allocs(), t0 = bench::nowNs();
+            for (int i = 0; i < N; ++i) bytes += enc.begin(hb_ms, i).field(112, std::string_view("TEST")).finish().size();
+            uint64_t t1 = bench::nowNs();
+            bench::report("heartbeat now, cached", N, bytes, t1 - t0, bench::allocs() - a0);
+        }
+        {
+            uint64_t bytes = 0, a0 = bench::allocs(), t0 = bench::nowNs();
+            for (int i = 0; i < N; ++i) bytes += legacyOrder(i, ts_str, 1000 + i, 5173.34, 100).size();
+            uint64_t t1 = bench::nowNs();
+            bench::report("new order stringstream", N, bytes, t1 - t0, bench::allocs() - a0);
+        }
+        {
+            uint64_t bytes = 0, a0 = bench::allocs(), t0 = bench::nowNs();
+            for (int i = 0; i < N; ++i) {
+                bytes += enc.begin(nos, i, ts).field(11, int64_t{1000} + i).body(nos).field(60, ts)
+                            .field(38, 100).fields(limit).price(44, 517334, 2).field(59, '3').finish().size();
+            }
+            uint64_t t1 = bench::nowNs();
+            bench::report("new order FixEncoder", N, bytes, t1 - t0, bench::allocs() - a0);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
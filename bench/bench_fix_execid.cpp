@@ -0,0 +1,89 @@
+// ChimeraMetals benchmarks
+// bench_fix_execid.cpp - ExecID dedup: unordered_set<string> vs FixExecIdWindow
+//
+// A day of fills: every ExecID is checked and then marked, as the execution
+// report path does, with one in 16 a duplicate (a PossDup resend). The set
+// grows for the whole run; the window keeps its startup footprint.
+//
+// Before timing, the window is checked against an exact set: nothing inside
+// the window may be missed and nothing never inserted may be reported.
+
+#include "BenchCommon.hpp"
+#include "core/FixExecIdWindow.hpp"
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+std::string execId(uint64_t i) {
+    return "EXE" + std::to_string(900000000ull + i * 7919);
+}
+
+bool checkWindow() {
+    const size_t CAPACITY = 1024;
+    chimera::FixExecIdWindow w(CAPACITY, 0);
+    for (uint64_t i = 0; i < 100000; ++i) {
+        std::string id = execId(i);
+        if (w.contains(id, 0) || !w.insert(id, 0)) return false;
+        // The last CAPACITY ids are remembered, barring forced evictions
+        std::string recent = execId(i - (i < CAPACITY / 2 ? i : CAPACITY / 2));
+        if (!w.contains(recent, 0) && w.forcedEvictions() == 0) return false;
+        if (w.contains(execId(i + 1), 0)) return false;
+    }
+    std::string id = execId(99999);
+    return w.erase(id) && !w.contains(id, 0);
+}
+
+} // namespace
+
+int main() {
+    if (!checkWindow()) {
+        std::fprintf(stderr, "FixExecIdWindow check failed\n");
+        return 1;
+    }
+
+    const uint64_t N = 2000000;
+    std::vector<std::string> ids;
+    ids.reserve(N);
+    for (uint64_t i = 0; i < N; ++i) ids.push_back(execId(i % 16 == 15 ? i - 3 : i));
+
+    for (int pass = 0; pass < 3; ++pass) {
+        {
+            std::unordered_set<std::string> seen;
+            uint64_t dups = 0, a0 = bench::allocs(), t0 = bench::nowNs();
+            for (const std::string& id : ids) {
+                if (seen.count(id)) {
+                    ++dups;
+                    continue;
+                }
+                seen.insert(id);
+            }
+            uint64_t t1 = bench::nowNs();
+            bench::report("unordered_set<string>", N, 0, t1 - t0, bench::allocs() - a0);
+            std::printf("%-34s %12llu dups %12zu entries at end\n", "",
+                        static_cast<unsigned long long>(dups), seen.size());
+        }
+        {
+            static chimera::FixExecIdWindow window;
+            window.clear();
+            uint64_t dups = 0, a0 = bench::allocs(), t0 = bench::nowNs();
+            for (const std::string& id : ids) {
+                int64_t now = static_cast<int64_t>(t0);
+                if (window.contains(id, now)) {
+                    ++dups;
+                    continue;
+                }
+                window.insert(id, now);
+            }
+            uint64_t t1 = bench::nowNs();
+            bench::report("FixExecIdWindow", N, 0, t1 - t0, bench::allocs() - a0);
+            std::printf("%-34s %12llu dups %12zu capacity %8llu forced evictions\n", "",
+                        static_cast<unsigned long long>(dups), window.capacity(),
+                        static_cast<unsigned long long>(window.forcedEvictions()));
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
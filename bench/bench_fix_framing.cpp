@@ -0,0 +1,140 @@
+// ChimeraMetals benchmarks
+// bench_fix_framing.cpp - Inbound FIX framing: legacy string buffer vs FixRecvRing
+//
+// Replays a burst of 35=X refreshes in 4 KiB reads (typical SSL record size)
+// through the pre-ring extractCompleteMessages() logic and through the
+// zero-copy ring, reporting msgs/s and heap allocations per message.
+
+#include "BenchCommon.hpp"
+#include "core/FixRecvRing.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+bool checksumOk(std::string_view msg) {
+    size_t cs_pos = msg.size() - 7;
+    unsigned sum = 0;
+    for (size_t i = 0; i < cs_pos; ++i) sum += static_cast<unsigned char>(msg[i]);
+    unsigned expected = (msg[cs_pos + 3] - '0') * 100 + (msg[cs_pos + 4] - '0') * 10 + (msg[cs_pos + 5] - '0');
+    return sum % 256 == expected;
+}
+
+// Verbatim shape of FixSession::extractCompleteMessages before the ring
+struct LegacyFramer {
+    std::string inbound_buffer_;
+
+    void appendToBuffer(const char* data, int size) {
+        inbound_buffer_.append(data, size);
+    }
+
+    std::vector<std::string> extractCompleteMessages() {
+        std::vector<std::string> messages;
+        const size_t MAX_FIX_MESSAGE_SIZE = 65536;
+
+        while (true) {
+            size_t start = inbound_buffer_.find("8=FIX");
+            if (start == std::string::npos) {
+                inbound_buffer_.clear();
+                break;
+            }
+            if (start > 0) inbound_buffer_.erase(0, start);
+
+            size_t body_len_pos = inbound_buffer_.find("9=");
+            if (body_len_pos == std::string::npos) break;
+            size_t body_len_end = inbound_buffer_.find("\x01", body_len_pos);
+            if (body_len_end == std::string::npos) break;
+
+            int body_length = 0;
+            try {
+                body_length = std::stoi(inbound_buffer_.substr(body_len_pos + 2, body_len_end - (body_len_pos + 2)));
+                if (body_length < 0 || body_length > static_cast<int>(MAX_FIX_MESSAGE_SIZE)) {
+                    inbound_buffer_.clear();
+                    return messages;
+                }
+            } catch (...) {
+                inbound_buffer_.erase(0, body_len_end + 1);
+                continue;
+            }
+
+            size_t expected_total = body_len_end + 1 + static_cast<size_t>(body_length) + 7;
+            if (inbound_buffer_.size() < expected_total) break;
+
+            std::string msg = inbound_buffer_.substr(0, expected_total);
+            if (!checksumOk(msg)) {
+                inbound_buffer_.clear();
+                return messages;
+            }
+            messages.push_back(msg);
+            inbound_buffer_.erase(0, expected_total);
+        }
+        return messages;
+    }
+};
+
+} // namespace
+
+int main() {
+    const int MESSAGES = 200000;
+    const size_t READ_SIZE = 4096;
+    const int ROUNDS = 5;
+
+    std::string stream;
+    for (int i = 0; i < MESSAGES; ++i) {
+        stream += bench::makeIncremental(i + 1, 2 + (i % 4) * 2);
+    }
+    std::printf("stream: %d msgs, %zu bytes, avg %zu bytes/msg, %zu-byte reads\n\n",
+                MESSAGES, stream.size(), stream.size() / MESSAGES, READ_SIZE);
+
+    for (int round = 0; round < ROUNDS; ++round) {
+        // Legacy
+        {
+            LegacyFramer legacy;
+            uint64_t delivered = 0;
+            uint64_t bytes = 0;
+            uint64_t a0 = bench::allocs();
+            uint64_t t0 = bench::nowNs();
+            for (size_t off = 0; off < stream.size(); off += READ_SIZE) {
+                size_t n = std::min(READ_SIZE, stream.size() - off);
+                legacy.appendToBuffer(stream.data() + off, static_cast<int>(n));
+                for (const std::string& m : legacy.extractCompleteMessages()) {
+                    bytes += m.size();
+                    ++delivered;
+                }
+            }
+            uint64_t t1 = bench::nowNs();
+            bench::report("legacy string+substr+erase", delivered, bytes, t1 - t0, bench::allocs() - a0);
+        }
+
+        // Ring: copy into writePtr() stands in for SSL_read
+        {
+            chimera::FixRecvRing ring;
+            uint64_t delivered = 0;
+            uint64_t bytes = 0;
+            uint64_t a0 = bench::allocs();
+            uint64_t t0 = bench::nowNs();
+            for (size_t off = 0; off < stream.size();) {
+                char* dst = ring.writePtr();
+                size_t n = std::min({READ_SIZE, stream.size() - off, ring.writable()});
+                std::memcpy(dst, stream.data() + off, n);
+                ring.commit(n);
+                off += n;
+
+                std::string_view msg;
+                while (ring.next(msg) == chimera::FixRecvRing::Frame::Complete) {
+                    if (!checksumOk(msg)) return 1;
+                    bytes += msg.size();
+                    ++delivered;
+                }
+            }
+            uint64_t t1 = bench::nowNs();
+            bench::report("FixRecvRing string_view", delivered, bytes, t1 - t0, bench::allocs() - a0);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+// ChimeraMetals benchmarks
+// bench_fix_md.cpp - 35=X handling: per-entry stores vs one FixMdBatch per message
+//
+// "per-entry" is the previous quote loop: walk 269/270 pairs and store every
+// price into the shared quote as it is parsed. "batch" decodes the 268 group
+// with FixMdDecoder, collapses it with tops() and stores once per symbol.
+// The decoder also parses 279/271/278 and the per-entry 55, so single-threaded
+// it does more work per message; what it saves is stores into quote state
+// that other threads read.
+
+#include "BenchCommon.hpp"
+#include "core/FixMdDecoder.hpp"
+#include "core/FixTagIndex.hpp"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<double> g_bid{0.0};
+std::atomic<double> g_ask{0.0};
+uint64_t g_stores = 0;
+
+void perEntry(const chimera::FixTagIndex& idx, int digits) {
+    char entry_type = 0;
+    for (size_t i = 0; i < idx.fieldCount(); ++i) {
+        uint32_t tag = idx.field(i).tag;
+        if (tag == 269) {
+            entry_type = idx.value(i).empty() ? 0 : idx.value(i)[0];
+        } else if (tag == 270 && entry_type) {
+            chimera::FixPrice px;
+            if (chimera::parseFixPrice(idx.value(i), digits, px) == chimera::FixNumError::None) {
+                if (entry_type == '0') g_bid.store(px.toDouble());
+                else if (entry_type == '1') g_ask.store(px.toDouble());
+                ++g_stores;
+            }
+            entry_type = 0;
+        }
+    }
+}
+
+void batched(const chimera::FixTagIndex& idx, const chimera::FixPricePrecision& precision,
+             chimera::FixMdBatch& batch) {
+    if (!chimera::FixMdDecoder::decode(idx, precision, batch)) return;
+    chimera::FixMdTop tops[4];
+    size_t n = batch.tops(tops, 4);
+    for (size_t i = 0; i < n; ++i) {
+        if (tops[i].has_bid) g_bid.store(tops[i].bid.toDouble());
+        if (tops[i].has_ask) g_ask.store(tops[i].ask.toDouble());
+        g_stores += tops[i].has_bid + tops[i].has_ask;
+    }
+}
+
+} // namespace
+
+int main() {
+    chimera::FixPricePrecision precision;
+    precision.set(41, 2);
+    chimera::FixTagIndex idx;
+    chimera::FixMdBatch batch;
+
+    // Decoder must see every entry before anything is timed
+    std::string check = bench::makeIncremental(1, 6);
+    if (!idx.parse(check) || !chimera::FixMdDecoder::decode(idx, precision, batch)) return 1;
+    if (batch.size() != 6 || batch.declared() != 6 || batch.errors() != 0) return 1;
+    if (batch[5].type != '1' || batch[5].price.ticks != 517835 || batch[5].symbol_id != 41) return 1;
+
+    const int entry_counts[] = {1, 4, 16};
+    for (int pass = 0; pass < 3; ++pass) {
+        for (int entries : entry_counts) {
+            std::vector<std::string> msgs;
+            size_t bytes = 0;
+            for (int i = 0; i < 256; ++i) {
+                msgs.push_back(bench::makeIncremental(i + 1, entries));
+                bytes += msgs.back().size();
+            }
+            const int ROUNDS = 2000;
+            const uint64_t N = static_cast<uint64_t>(ROUNDS) * msgs.size();
+            char name[64];
+
+            {
+                g_stores = 0;
+                uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+                for (int r = 0; r < ROUNDS; ++r)
+                    for (const std::string& m : msgs) {
+                        idx.parse(m);
+                        perEntry(idx, 2);
+                    }
+                uint64_t t1 = bench::nowNs();
+                std::snprintf(name, sizeof(name), "per-entry  %2d entries/msg", entries);
+                bench::report(name, N, bytes * ROUNDS, t1 - t0, bench::allocs() - a0);
+                std::printf("%-34s %12.2f quote stores/msg\n", "", static_cast<double>(g_stores) / N);
+            }
+            {
+                g_stores = 0;
+                uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+                for (int r = 0; r < ROUNDS; ++r)
+                    for (const std::string& m : msgs) {
+                        idx.parse(m);
+                        batched(idx, precision, batch);
+                    }
+                uint64_t t1 = bench::nowNs();
+                std::snprintf(name, sizeof(name), "batch      %2d entries/msg", entries);
+                bench::report(name, N, bytes * ROUNDS, t1 - t0, bench::allocs() - a0);
+                std::printf("%-34s %12.2f quote stores/msg\n", "", static_cast<double>(g_stores) / N);
+            }
+        }
+        bench::doNotOptimize(g_bid.load() + g_ask.load());
+        std::printf("\n");
+    }
+    return 0;
+}
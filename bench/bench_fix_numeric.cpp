@@ -0,0 +1,125 @@
+// ChimeraMetals benchmarks
+// bench_fix_numeric.cpp - MDEntryPx / Symbol parsing: std::stod vs std::from_chars vs parseFixPrice
+//
+// Each case parses the same set of wire-format values taken in place from a
+// FIX buffer (string_view, no terminator), the way the quote loop sees them.
+
+#include "BenchCommon.hpp"
+#include "core/FixNumeric.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <vector>
+
+int main() {
+    std::vector<std::string> prices;
+    for (int i = 0; i < 4096; ++i) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%d.%02d", 5100 + (i * 7) % 200, (i * 13) % 100);
+        prices.push_back(buf);
+    }
+    std::vector<std::string> ints;
+    for (int i = 0; i < 4096; ++i) ints.push_back(std::to_string(41 + i % 3) + (i % 2 ? "" : "7"));
+
+    // Embed in one SOH-separated buffer and keep views, as FixTagIndex does
+    std::string wire;
+    std::vector<std::pair<size_t, size_t>> px_at, int_at;
+    for (const std::string& p : prices) {
+        wire += "270=";
+        px_at.push_back({wire.size(), p.size()});
+        wire += p + "\x01";
+    }
+    for (const std::string& v : ints) {
+        wire += "55=";
+        int_at.push_back({wire.size(), v.size()});
+        wire += v + "\x01";
+    }
+
+    // Results must agree before anything is timed
+    for (auto [off, len] : px_at) {
+        std::string_view v(wire.data() + off, len);
+        chimera::FixPrice fp;
+        if (chimera::parseFixPrice(v, 2, fp) != chimera::FixNumError::None) return 1;
+        if (std::fabs(fp.toDouble() - std::stod(std::string(v))) > 1e-9) return 1;
+    }
+
+    const int ROUNDS = 500;
+    const uint64_t N = static_cast<uint64_t>(ROUNDS) * px_at.size();
+
+    for (int pass = 0; pass < 3; ++pass) {
+        {
+            double acc = 0;
+            uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+            for (int r = 0; r < ROUNDS; ++r)
+                for (auto [off, len] : px_at) acc += std::stod(wire.substr(off, len));
+            uint64_t t1 = bench::nowNs();
+            bench::doNotOptimize(acc);
+            bench::report("price std::stod(substr)", N, 0, t1 - t0, bench::allocs() - a0);
+        }
+        {
+            double acc = 0;
+            uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+            for (int r = 0; r < ROUNDS; ++r)
+                for (auto [off, len] : px_at) {
+                    double d = 0;
+                    std::from_chars(wire.data() + off, wire.data() + off + len, d);
+                    acc += d;
+                }
+            uint64_t t1 = bench::nowNs();
+            bench::doNotOptimize(acc);
+            bench::report("price std::from_chars<double>", N, 0, t1 - t0, bench::allocs() - a0);
+        }
+        {
+            int64_t acc = 0;
+            uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+            for (int r = 0; r < ROUNDS; ++r)
+                for (auto [off, len] : px_at) {
+                    int64_t ticks = 0;
+                    chimera::parseFixPrice(std::string_view(wire.data() + off, len), 2, ticks);
+                    acc += ticks;
+                }
+            uint64_t t1 = bench::nowNs();
+            bench::doNotOptimize(acc);
+            bench::report("price parseFixPrice -> ticks", N, 0, t1 - t0, bench::allocs() - a0);
+        }
+        {
+            int64_t acc = 0;
+            uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+            for (int r = 0; r < ROUNDS; ++r)
+                for (auto [off, len] : int_at) acc += std::stoi(wire.substr(off, len));
+            uint64_t t1 = bench::nowNs();
+            bench::doNotOptimize(acc);
+            bench::report("symbol std::stoi(substr)", N, 0, t1 - t0, bench::allocs() - a0);
+        }
+        {
+            int64_t acc = 0;
+            uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+            for (int r = 0; r < ROUNDS; ++r)
+                for (auto [off, len] : int_at) {
+                    int v = 0;
+                    std::from_chars(wire.data() + off, wire.data() + off + len, v);
+                    acc += v;
+                }
+            uint64_t t1 = bench::nowNs();
+            bench::doNotOptimize(acc);
+            bench::report("symbol std::from_chars<int>", N, 0, t1 - t0, bench::allocs() - a0);
+        }
+        {
+            int64_t acc = 0;
+            uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+            for (int r = 0; r < ROUNDS; ++r)
+                for (auto [off, len] : int_at) {
+                    int v = 0;
+                    chimera::parseFixInt(std::string_view(wire.data() + off, len), v);
+                    acc += v;
+                }
+            uint64_t t1 = bench::nowNs();
+            bench::doNotOptimize(acc);
+            bench::report("symbol parseFixInt", N, 0, t1 - t0, bench::allocs() - a0);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,215 @@
+// ChimeraMetals benchmarks
+// bench_fix_orders.cpp - ExecutionReport apply: string maps vs FixOrderStore
+//
+// "maps" is what FixSession kept before: known_orders_ and fill_history_,
+// unordered_maps keyed by the ClOrdID and ExecID strings, with no order
+// state. "slab" is FixOrderStore: 11 parsed as an integer, one slot
+// access, state, cumulative quantity and average price updated in place.
+//
+// Every order gets an ack, a partial fill and a final fill (one in eight
+// is cancelled after the partial instead). Each report is tokenized and
+// then applied; the "parse only" row is the tokenizing alone, so the
+// difference is the apply. Before timing, the state machine is walked
+// through fills, a replace, a rejected and an accepted cancel, and a
+// rejected order.
+
+#include "BenchCommon.hpp"
+#include "core/FixOrderStore.hpp"
+#include "core/FixTagIndex.hpp"
+
+#include <cmath>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+const uint64_t FIRST_ID = 1771818975000000ull;
+
+std::string execReport(uint64_t id, uint64_t orig, char exec_type, char ord_status,
+                       const char* last_qty = nullptr, const char* last_px = nullptr) {
+    static uint64_t exec_seq = 0;
+    std::string body = "35=8\x01" "49=cServer\x01" "56=demo.blackbull.2067070\x01" "34=1\x01"
+                       "52=20260223-03:56:15.123\x01"
+                       "11=" + std::to_string(id) + "\x01";
+    if (orig) body += "41=" + std::to_string(orig) + "\x01";
+    body += "17=EXE" + std::to_string(900000000 + ++exec_seq) + "\x01"
+            "150=" + std::string(1, exec_type) + "\x01"
+            "39=" + std::string(1, ord_status) + "\x01"
+            "55=41\x01" "54=1\x01";
+    if (last_qty) body += std::string("32=") + last_qty + "\x01" "31=" + last_px + "\x01";
+    return bench::wrapFix(body);
+}
+
+std::string cancelReject(uint64_t id, uint64_t orig, char ord_status) {
+    std::string body = "35=9\x01" "49=cServer\x01" "56=demo.blackbull.2067070\x01" "34=1\x01"
+                       "52=20260223-03:56:15.123\x01"
+                       "11=" + std::to_string(id) + "\x01" "41=" + std::to_string(orig) + "\x01"
+                       "39=" + std::string(1, ord_status) + "\x01" "434=1\x01" "58=TOO LATE\x01";
+    return bench::wrapFix(body);
+}
+
+chimera::FixOrderNote note(uint64_t id, uint64_t orig = 0, chimera::FixOrdKind kind = chimera::FixOrdKind::Order) {
+    chimera::FixOrderNote n;
+    n.id = id;
+    n.orig_id = orig;
+    n.qty = 100 * 100;
+    n.price = 517334;
+    n.symbol = 41;
+    n.digits = 2;
+    n.kind = kind;
+    return n;
+}
+
+struct Walk {
+    chimera::FixOrderStore store;
+    chimera::FixTagIndex idx;
+    chimera::FixOrderFill fill;
+
+    Walk() : store(64) {}
+
+    const chimera::FixOrder* exec(const std::string& msg) {
+        idx.parse(msg);
+        return store.onExecutionReport(idx, 0, fill);
+    }
+
+    const chimera::FixOrder* reject(const std::string& msg) {
+        idx.parse(msg);
+        return store.onCancelReject(idx, 0);
+    }
+
+    bool is(uint64_t id, chimera::FixOrdState s) {
+        const chimera::FixOrder* o = store.find(id);
+        return o && o->state == s;
+    }
+};
+
+bool checkStateMachine() {
+    using S = chimera::FixOrdState;
+    using K = chimera::FixOrdKind;
+    Walk w;
+
+    // New -> partial -> filled, average over both fills
+    w.store.add(note(1), 0);
+    if (!w.is(1, S::PendingNew)) return false;
+    w.exec(execReport(1, 0, '0', '0'));
+    if (!w.is(1, S::New)) return false;
+    const chimera::FixOrder* o = w.exec(execReport(1, 0, 'F', '1', "40", "5173.00"));
+    if (!o || o->state != S::PartiallyFilled || w.fill.qty != 4000) return false;
+    o = w.exec(execReport(1, 0, 'F', '2', "60", "5174.00"));
+    if (!o || o->state != S::Filled || o->cumQtyValue() != 100.0 || std::fabs(o->avg_px - 5173.6) > 1e-9)
+        return false;
+
+    // Replace 2 by 3: 2 pending, then replaced; 3 inherits the fill
+    w.store.add(note(2), 0);
+    w.exec(execReport(2, 0, 'F', '1', "10", "5173.00"));
+    w.store.add(note(3, 2, K::Replace), 0);
+    if (!w.is(2, S::PendingReplace) || !w.is(3, S::PendingNew)) return false;
+    w.exec(execReport(3, 2, '5', '1'));
+    if (!w.is(2, S::Replaced) || !w.is(3, S::PartiallyFilled) || w.store.find(3)->cumQtyValue() != 10.0)
+        return false;
+
+    // Cancel 4 refused (4 back to New), a fill while the next cancel is
+    // pending keeps it pending, then the cancel goes through
+    w.store.add(note(4), 0);
+    w.exec(execReport(4, 0, '0', '0'));
+    w.store.add(note(5, 4, K::Cancel), 0);
+    if (!w.is(4, S::PendingCancel)) return false;
+    w.reject(cancelReject(5, 4, '0'));
+    if (!w.is(4, S::New) || !w.is(5, S::Rejected)) return false;
+    w.store.add(note(6, 4, K::Cancel), 0);
+    w.exec(execReport(4, 0, 'F', '1', "5", "5173.00"));
+    if (!w.is(4, S::PendingCancel)) return false;
+    w.exec(execReport(6, 4, '4', '4'));
+    if (!w.is(4, S::Canceled) || !w.is(6, S::Canceled) || w.store.find(4)->cumQtyValue() != 5.0) return false;
+
+    // Rejected on entry; final states do not move
+    w.store.add(note(7), 0);
+    w.exec(execReport(7, 0, '8', '8'));
+    w.exec(execReport(7, 0, '0', '0'));
+    if (!w.is(7, S::Rejected)) return false;
+
+    // A working order is not overwritten by an id 64 later; a final one is
+    w.store.add(note(8), 0);
+    if (w.store.add(note(8 + 64), 0) || w.store.collisions() != 1) return false;
+    return w.store.add(note(1 + 64), 0) && !w.store.find(1) && w.store.find(1 + 64);
+}
+
+} // namespace
+
+int main() {
+    if (!checkStateMachine()) {
+        std::fprintf(stderr, "order state machine check failed\n");
+        return 1;
+    }
+
+    const uint64_t ORDERS = 100000;
+    std::vector<std::string> wire;
+    wire.reserve(ORDERS * 3);
+    for (uint64_t i = 0; i < ORDERS; ++i) {
+        uint64_t id = FIRST_ID + i;
+        wire.push_back(execReport(id, 0, '0', '0'));
+        wire.push_back(execReport(id, 0, 'F', '1', "40", "5173.34"));
+        if (i % 8 == 7) wire.push_back(execReport(id, 0, '4', '4'));
+        else wire.push_back(execReport(id, 0, 'F', '2', "60", "5173.36"));
+    }
+    uint64_t bytes = 0;
+    for (const std::string& m : wire) bytes += m.size();
+    static chimera::FixTagIndex tag_index;
+    chimera::FixTagIndex* idx = &tag_index;
+
+    for (int pass = 0; pass < 3; ++pass) {
+        {
+            uint64_t fields = 0;
+            uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+            for (const std::string& m : wire) {
+                idx->parse(m);
+                fields += idx->fieldCount();
+            }
+            uint64_t t1 = bench::nowNs();
+            bench::report("parse only", wire.size(), bytes, t1 - t0, bench::allocs() - a0);
+            bench::doNotOptimize(fields);
+        }
+        {
+            std::unordered_map<std::string, bool> known;
+            std::unordered_map<std::string, std::tuple<double, double, bool>> fills;
+            for (uint64_t i = 0; i < ORDERS; ++i) known[std::to_string(FIRST_ID + i)] = true;
+            uint64_t hits = 0;
+            uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+            for (const std::string& msg : wire) {
+                idx->parse(msg);
+                const chimera::FixTagIndex& m = *idx;
+                if (known.count(std::string(m.get(11)))) ++hits;
+                if (m.getChar(150) == 'F') fills[std::string(m.get(17))] = std::make_tuple(1.0, 5173.34, true);
+            }
+            uint64_t t1 = bench::nowNs();
+            bench::report("parse + maps", wire.size(), bytes, t1 - t0, bench::allocs() - a0);
+            bench::doNotOptimize(hits);
+        }
+        {
+            chimera::FixOrderStore store(ORDERS * 2);
+            for (uint64_t i = 0; i < ORDERS; ++i) store.add(note(FIRST_ID + i), 0);
+            chimera::FixOrderFill fill;
+            uint64_t filled = 0, canceled = 0;
+            uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+            for (const std::string& msg : wire) {
+                idx->parse(msg);
+                store.onExecutionReport(*idx, 0, fill);
+            }
+            uint64_t t1 = bench::nowNs();
+            bench::report("parse + slab", wire.size(), bytes, t1 - t0, bench::allocs() - a0);
+            for (uint64_t i = 0; i < ORDERS; ++i) {
+                chimera::FixOrdState s = store.find(FIRST_ID + i)->state;
+                filled += s == chimera::FixOrdState::Filled;
+                canceled += s == chimera::FixOrdState::Canceled;
+            }
+            if (filled != ORDERS - ORDERS / 8 || canceled != ORDERS / 8) {
+                std::fprintf(stderr, "slab: %llu filled, %llu canceled\n",
+                             static_cast<unsigned long long>(filled), static_cast<unsigned long long>(canceled));
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,131 @@
+// ChimeraMetals benchmarks
+// bench_fix_outbound.cpp - Outbound writes: one write per message vs FixOutboundQueue
+//
+// "per-message" is the old sslWrite path: every message is its own write().
+// "coalesced" pushes a burst (orders, cancels, a heartbeat reply) without
+// flushing and then flushes once, as the read loop does before blocking.
+// The writer is write(2) to /dev/null, so the difference is the syscall per
+// message; through OpenSSL each write is additionally one TLS record.
+//
+// Before timing, several producer threads push tagged messages concurrently
+// and the drained stream is checked for loss and per-producer order.
+
+#include "BenchCommon.hpp"
+#include "core/FixOutboundQueue.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct FdWriter {
+    int fd;
+    bool operator()(const char* data, size_t size) const {
+        return ::write(fd, data, size) == static_cast<ssize_t>(size);
+    }
+};
+
+struct CaptureWriter {
+    std::string* out;
+    bool operator()(const char* data, size_t size) const {
+        out->append(data, size);
+        return true;
+    }
+};
+
+// N producers x M messages "P<p>:<i>;" must all arrive, in order per producer
+bool checkMpsc(chimera::FixOutboundQueue& q) {
+    const int PRODUCERS = 3;
+    const int MESSAGES = 20000;
+    std::string wire;
+    CaptureWriter writer{&wire};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        threads.emplace_back([&q, &writer, p] {
+            char msg[32];
+            for (int i = 0; i < MESSAGES; ++i) {
+                int n = std::snprintf(msg, sizeof(msg), "P%d:%d;", p, i);
+                q.push(msg, static_cast<size_t>(n), writer, i % 64 == 0);
+            }
+        });
+    }
+    for (std::thread& t : threads) t.join();
+    q.flush(writer);
+
+    int next[PRODUCERS] = {};
+    size_t pos = 0;
+    while (pos < wire.size()) {
+        size_t end = wire.find(';', pos);
+        if (end == std::string::npos || wire[pos] != 'P') return false;
+        int p = wire[pos + 1] - '0';
+        int i = std::atoi(wire.c_str() + pos + 3);
+        if (p < 0 || p >= PRODUCERS || i != next[p]) return false;
+        ++next[p];
+        pos = end + 1;
+    }
+    for (int p = 0; p < PRODUCERS; ++p) {
+        if (next[p] != MESSAGES) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    static chimera::FixOutboundQueue q;
+    if (!checkMpsc(q)) {
+        std::fprintf(stderr, "MPSC check failed: lost or reordered messages\n");
+        return 1;
+    }
+
+    int fd = ::open("/dev/null", O_WRONLY);
+    if (fd < 0) return 1;
+    FdWriter writer{fd};
+
+    std::string order = bench::wrapFix(
+        "35=D\x01" "49=SENDER\x01" "56=cServer\x01" "34=1234\x01" "52=20260223-10:00:00.000\x01"
+        "11=1001\x01" "55=41\x01" "54=1\x01" "60=20260223-10:00:00.000\x01" "38=100\x01"
+        "40=2\x01" "44=5173.34\x01" "59=3\x01");
+
+    const int bursts[] = {1, 4, 16};
+    for (int pass = 0; pass < 3; ++pass) {
+        for (int burst : bursts) {
+            const int ROUNDS = 200000 / burst;
+            const uint64_t N = static_cast<uint64_t>(ROUNDS) * burst;
+            char name[64];
+
+            {
+                uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+                for (int r = 0; r < ROUNDS; ++r)
+                    for (int i = 0; i < burst; ++i) writer(order.data(), order.size());
+                uint64_t t1 = bench::nowNs();
+                std::snprintf(name, sizeof(name), "per-message  burst %2d", burst);
+                bench::report(name, N, N * order.size(), t1 - t0, bench::allocs() - a0);
+                std::printf("%-34s %12.3f writes/msg\n", "", 1.0);
+            }
+            {
+                chimera::FixOutboundStats s0 = q.stats();
+                uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+                for (int r = 0; r < ROUNDS; ++r) {
+                    for (int i = 0; i < burst; ++i) q.push(order.data(), order.size(), writer);
+                    q.flush(writer);
+                }
+                uint64_t t1 = bench::nowNs();
+                chimera::FixOutboundRates rates =
+                    chimera::FixOutboundRates::between(s0, q.stats(), static_cast<double>(t1 - t0) / 1e9);
+                std::snprintf(name, sizeof(name), "coalesced    burst %2d", burst);
+                bench::report(name, N, N * order.size(), t1 - t0, bench::allocs() - a0);
+                std::printf("%-34s %12.3f writes/msg %12.0f records/s\n", "",
+                            rates.writes_per_message, rates.records_per_sec);
+            }
+        }
+        std::printf("\n");
+    }
+    ::close(fd);
+    return 0;
+}
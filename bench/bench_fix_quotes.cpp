@@ -0,0 +1,203 @@
+// ChimeraMetals benchmarks
+// bench_fix_quotes.cpp - Quote publication: maps and atomics vs FixQuoteCache
+//
+// "maps" is what the baseline quote thread did: std::map<std::string,
+// double> bid and ask written by name with no synchronization. "atomics" is
+// one std::atomic<double> per field, as main.cpp had for gold. "cache" is
+// FixQuoteCache: one seqlocked cache line per FixSymbolDirectory handle.
+//
+// Before timing, a SecurityList is loaded into a directory and the handles,
+// venue fields and batched NoRelatedSym groups are checked. Then the writer
+// alone, one quote per update cycling over two symbols.
+// Then a writer and two reader threads: tick i publishes bid i, ask i + 0.5
+// and sizes i, so a reader holding fields from two different ticks sees
+// ask != bid + 0.5 or a size that does not match. The cache must never tear;
+// the atomics tear whenever a reader lands between two of the stores.
+
+#include "BenchCommon.hpp"
+#include "core/FixQuoteCache.hpp"
+#include "core/FixSymbolDirectory.hpp"
+#include "core/FixTagIndex.hpp"
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const uint64_t UPDATES = 4000000;
+const int READERS = 2;
+chimera::FixMdTop top(int64_t symbol, uint64_t tick) {
+    chimera::FixMdTop t{};
+    t.symbol_id = symbol;
+    t.has_bid = t.has_ask = true;
+    t.bid = chimera::FixPrice{static_cast<int64_t>(tick) * 100, 2};
+    t.ask = chimera::FixPrice{static_cast<int64_t>(tick) * 100 + 50, 2};
+    t.bid_size = t.ask_size = static_cast<int64_t>(tick) * 100;
+    return t;
+}
+
+bool consistent(double bid, double ask, double bid_size, double ask_size) {
+    return ask == bid + 0.5 && bid_size == bid && ask_size == bid;
+}
+
+bool checkDirectory() {
+    chimera::FixSymbolDirectory dir;
+    if (dir.configure("XAUUSD, XAGUSD,XPTUSD  XAUUSD 1000") != 4 || dir.size() != 4) return false;
+    if (dir.byName("XPTUSD") != 2 || dir.byId(1000) != 3 || dir.byId(41) != chimera::FIX_NO_SYMBOL) return false;
+
+    static chimera::FixTagIndex idx;
+    idx.parse(bench::wrapFix("35=y\x01" "49=cServer\x01" "56=demo.blackbull.2067070\x01" "34=2\x01"
+                             "52=20260223-03:56:15\x01" "320=1\x01" "322=1\x01" "560=0\x01" "146=4\x01"
+                             "55=1\x01" "1007=EURUSD\x01" "1008=5\x01"
+                             "55=41\x01" "1007=XAUUSD\x01" "1008=2\x01"
+                             "55=42\x01" "1007=XAGUSD\x01" "1008=3\x01" "969=0.005\x01" "231=5000\x01"
+                             "55=1000\x01" "1007=XPDUSD\x01" "1008=2\x01"));
+    if (dir.loadSecurityList(idx) != 3 || dir.listed() != 3 || !dir.ready()) return false;
+
+    const chimera::FixSymbol& xau = dir[dir.byId(41)];
+    const chimera::FixSymbol& xag = dir[dir.byId(42)];
+    if (dir.byId(41) != 0 || xau.digits != 2 || xau.tick_size != 0.01 || xau.contract_size != 1.0) return false;
+    if (dir.byId(42) != 1 || xag.digits != 3 || xag.tick_size != 0.005 || xag.contract_size != 5000.0) return false;
+    if (dir[3].name != "XPDUSD" || dir[2].listed || dir.byId(1) != chimera::FIX_NO_SYMBOL) return false;
+
+    chimera::FixMdTop by_name{};
+    by_name.symbol_id = -1;
+    by_name.symbol = "XPTUSD";
+    if (dir.handleOf(by_name) != 2) return false;
+
+    // Unlisted XPTUSD is left out by id, kept by name
+    if (dir.requestCount() != 1 || dir.relatedSymbols(0, true) != "146=3\x01" "55=41\x01" "55=42\x01" "55=1000\x01" ||
+        dir.relatedSymbols(0, false) != "146=4\x01" "55=XAUUSD\x01" "55=XAGUSD\x01" "55=XPTUSD\x01" "55=XPDUSD\x01")
+        return false;
+
+    chimera::FixSymbolDirectory big;
+    for (int i = 0; i < 70; ++i) big.add("S" + std::to_string(i));
+    return big.size() == chimera::FixSymbolDirectory::MAX_SYMBOLS && big.requestCount() == 2 &&
+           big.relatedSymbols(1, false).compare(0, 6, "146=32") == 0;
+}
+
+struct AtomicQuote {
+    std::atomic<double> bid{0}, ask{0}, bid_size{0}, ask_size{0};
+};
+
+struct Result {
+    uint64_t write_ns = 0;
+    uint64_t reads = 0;
+    uint64_t torn = 0;
+};
+
+// One writer publishing UPDATES ticks of one symbol, READERS readers polling it
+template <typename Write, typename Read>
+Result race(Write write, Read read) {
+    Result r;
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> reads{0}, torn{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < READERS; ++i) {
+        readers.emplace_back([&] {
+            uint64_t n = 0, bad = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                bad += !read();
+                ++n;
+            }
+            reads += n;
+            torn += bad;
+        });
+    }
+    uint64_t t0 = bench::nowNs();
+    for (uint64_t i = 1; i <= UPDATES; ++i) write(i);
+    r.write_ns = bench::nowNs() - t0;
+    done.store(true, std::memory_order_release);
+    for (std::thread& t : readers) t.join();
+    r.reads = reads.load();
+    r.torn = torn.load();
+    return r;
+}
+
+void print(const char* name, const Result& r) {
+    std::printf("%-22s writer %12.0f updates/s  readers %12.0f loads/s  torn %8llu\n", name,
+                UPDATES / (r.write_ns / 1e9), r.reads / (r.write_ns / 1e9),
+                static_cast<unsigned long long>(r.torn));
+}
+
+} // namespace
+
+int main() {
+    if (!checkDirectory()) {
+        std::fprintf(stderr, "symbol directory check failed\n");
+        return 1;
+    }
+
+    for (int pass = 0; pass < 3; ++pass) {
+        {
+            std::map<std::string, double> bid, ask;
+            uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+            for (uint64_t i = 0; i < UPDATES; ++i) {
+                const char* name = (i & 1) ? "XAGUSD" : "XAUUSD";
+                bid[name] = static_cast<double>(i);
+                ask[name] = static_cast<double>(i) + 0.5;
+            }
+            uint64_t t1 = bench::nowNs();
+            bench::report("write maps", UPDATES, 0, t1 - t0, bench::allocs() - a0);
+            bench::doNotOptimize(bid["XAUUSD"]);
+        }
+        {
+            static AtomicQuote quotes[2];
+            uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+            for (uint64_t i = 0; i < UPDATES; ++i) {
+                AtomicQuote& q = quotes[i & 1];
+                q.bid.store(static_cast<double>(i));
+                q.ask.store(static_cast<double>(i) + 0.5);
+                q.bid_size.store(static_cast<double>(i));
+                q.ask_size.store(static_cast<double>(i));
+            }
+            uint64_t t1 = bench::nowNs();
+            bench::report("write atomics", UPDATES, 0, t1 - t0, bench::allocs() - a0);
+        }
+        {
+            chimera::FixQuoteCache cache;
+            uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+            for (uint64_t i = 0; i < UPDATES; ++i) cache.update(i & 1, top(41, i), 0, 0);
+            uint64_t t1 = bench::nowNs();
+            bench::report("write cache", UPDATES, 0, t1 - t0, bench::allocs() - a0);
+            chimera::FixQuote q = cache.load(0);
+            if (q.updates != UPDATES / 2 || !consistent(q.bid, q.ask, q.bid_size, q.ask_size)) {
+                std::fprintf(stderr, "cache: last quote wrong\n");
+                return 1;
+            }
+        }
+    }
+    std::printf("\n%d readers, %u cpus online\n", READERS, std::thread::hardware_concurrency());
+
+    AtomicQuote aq;
+    aq.ask.store(0.5);
+    Result ra = race(
+        [&](uint64_t i) {
+            double v = static_cast<double>(i);
+            aq.bid.store(v);
+            aq.ask.store(v + 0.5);
+            aq.bid_size.store(v);
+            aq.ask_size.store(v);
+        },
+        [&] { return consistent(aq.bid.load(), aq.ask.load(), aq.bid_size.load(), aq.ask_size.load()); });
+    print("atomics", ra);
+
+    chimera::FixQuoteCache cache;
+    cache.update(0, top(41, 0), 0, 0);
+    Result rc = race(
+        [&](uint64_t i) { cache.update(0, top(41, i), 0, 0); },
+        [&] {
+            chimera::FixQuote q = cache.load(0);
+            return consistent(q.bid, q.ask, q.bid_size, q.ask_size);
+        });
+    print("cache", rc);
+
+    if (rc.torn) {
+        std::fprintf(stderr, "cache: %llu torn quotes\n", static_cast<unsigned long long>(rc.torn));
+        return 1;
+    }
+    return 0;
+}
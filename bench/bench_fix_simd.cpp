@@ -0,0 +1,102 @@
+// ChimeraMetals benchmarks
+// bench_fix_simd.cpp - CheckSum and SOH/'=' tokenizing kernels per SIMD level
+//
+// Builds realistic 35=W/35=X payloads from ~100 to ~2000 bytes, checks every
+// level against the scalar kernels bit for bit, then reports checksum GB/s
+// and FixTagIndex::parse msgs/s for each level the CPU supports.
+
+#include "BenchCommon.hpp"
+#include "core/FixSimd.hpp"
+#include "core/FixTagIndex.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Payload {
+    const char* label;
+    std::string msg;
+};
+
+std::vector<Payload> makePayloads() {
+    std::vector<Payload> p;
+    p.push_back({"35=X  1 entry ", bench::makeIncremental(1, 1)});
+    p.push_back({"35=X  4 entries", bench::makeIncremental(2, 4)});
+    p.push_back({"35=W  5 levels", bench::makeSnapshot(3, 5)});
+    p.push_back({"35=X 16 entries", bench::makeIncremental(4, 16)});
+    p.push_back({"35=W 30 levels", bench::makeSnapshot(5, 30)});
+    return p;
+}
+
+bool verify(const std::vector<Payload>& payloads, const chimera::FixSimdKernels& k) {
+    chimera::FixSimdKernels ref = chimera::fixSimdKernels(chimera::SimdLevel::Scalar);
+    for (const Payload& p : payloads) {
+        for (size_t off = 0; off < 64 && off < p.msg.size(); ++off) {
+            const char* s = p.msg.data() + off;
+            size_t n = p.msg.size() - off;
+            if (k.byteSum(s, n) != ref.byteSum(s, n)) return false;
+            if (n >= 64) {
+                uint64_t s1, e1, s2, e2;
+                k.delimMask(s, s1, e1);
+                ref.delimMask(s, s2, e2);
+                if (s1 != s2 || e1 != e2) return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    std::vector<Payload> payloads = makePayloads();
+    const chimera::SimdLevel levels[] = {
+        chimera::SimdLevel::Scalar,
+        chimera::SimdLevel::SSE2,
+        chimera::SimdLevel::AVX2,
+        chimera::SimdLevel::AVX512BW
+    };
+
+    std::printf("runtime dispatch selected: %s\n\n", chimera::simdLevelName(chimera::fixSimd().level));
+
+    for (const Payload& p : payloads) {
+        std::printf("%s (%zu bytes)\n", p.label, p.msg.size());
+        const int ITER = static_cast<int>(200000000 / p.msg.size());
+
+        for (chimera::SimdLevel want : levels) {
+            chimera::FixSimdKernels k = chimera::fixSimdKernels(want);
+            if (k.level != want) continue;
+            if (!verify(payloads, k)) {
+                std::printf("  %-10s MISMATCH against scalar\n", chimera::simdLevelName(k.level));
+                return 1;
+            }
+
+            uint32_t acc = 0;
+            uint64_t t0 = bench::nowNs();
+            for (int i = 0; i < ITER; ++i) {
+                acc += k.byteSum(p.msg.data(), p.msg.size() - 7);
+            }
+            uint64_t t1 = bench::nowNs();
+            bench::doNotOptimize(acc);
+            double cs_gbs = static_cast<double>(ITER) * p.msg.size() / (t1 - t0);
+
+            chimera::FixTagIndex idx;
+            size_t fields = 0;
+            const int PARSE_ITER = ITER / 4;
+            t0 = bench::nowNs();
+            for (int i = 0; i < PARSE_ITER; ++i) {
+                idx.parse(p.msg, k);
+                fields += idx.fieldCount();
+            }
+            t1 = bench::nowNs();
+            bench::doNotOptimize(fields);
+            double parse_mps = PARSE_ITER / ((t1 - t0) / 1e9);
+
+            std::printf("  %-10s checksum %7.2f GB/s   tokenize %10.0f msgs/s\n",
+                        chimera::simdLevelName(k.level), cs_gbs, parse_mps);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
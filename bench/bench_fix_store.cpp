@@ -0,0 +1,171 @@
+// ChimeraMetals benchmarks
+// bench_fix_store.cpp - FixMessageStore: append, ResendRequest replay, recovery
+//
+// A trading day of outbound traffic, one heartbeat in eight: every message
+// is appended as the send path does, then the whole range is replayed as a
+// ResendRequest 1-0 would, then the file is closed and reopened as after a
+// restart. The replayed stream is checked first: PossDup copies carry 43=Y
+// and the original 52 as 122, every heartbeat run became one GapFill, and
+// every message frames and checksums correctly.
+
+#include "BenchCommon.hpp"
+#include "core/FixMessageStore.hpp"
+#include "core/FixTagIndex.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* STORE_PATH = "bench_fix_store.dat";
+
+struct Templates {
+    chimera::FixSessionIds ids;
+    chimera::FixMsgTemplate order;
+    chimera::FixMsgTemplate heartbeat;
+    chimera::FixMsgTemplate gap_fill;
+
+    Templates() {
+        ids.sender_comp_id = "demo.blackbull.2067070";
+        ids.target_comp_id = "cServer";
+        ids.sender_sub_id = "TRADE";
+        ids.target_sub_id = "TRADE";
+        ids.sending_time_precision = chimera::FixTimePrecision::Millis;
+        order = chimera::FixMsgTemplate(ids, "D", "55=41\x01" "54=1\x01" "40=2\x01" "59=1\x01");
+        heartbeat = chimera::FixMsgTemplate(ids, "0");
+        gap_fill = chimera::FixMessageStore::gapFillTemplate(ids);
+    }
+};
+
+bool isHeartbeat(int64_t seq) {
+    return seq % 8 == 0;
+}
+
+std::string_view build(chimera::FixEncoder& enc, const Templates& t, int64_t seq) {
+    if (isHeartbeat(seq)) return enc.begin(t.heartbeat, seq).finish();
+    return enc.begin(t.order, seq).field(11, "ORD-", seq).body(t.order).price(44, 517334 + seq % 100, 2)
+              .field(38, int64_t(100)).finish();
+}
+
+bool framed(std::string_view msg, chimera::FixTagIndex& idx) {
+    if (!idx.parse(msg) || !idx.has(9) || !idx.has(10)) return false;
+    size_t body = msg.find('\x01', msg.find("\x01" "9=") + 1) + 1;
+    int64_t len = 0;
+    if (chimera::parseFixInt(idx.get(9), len) != chimera::FixNumError::None) return false;
+    if (static_cast<size_t>(len) != msg.size() - 7 - body) return false;
+    int64_t cs = 0;
+    chimera::parseFixInt(idx.get(10), cs);
+    return static_cast<unsigned>(cs) == chimera::fixChecksum(msg.data(), msg.size() - 7);
+}
+
+// Every message as sent, back to back; ends[seq - 1] is where seq stops
+struct Sent {
+    std::string wire;
+    std::vector<uint32_t> ends;
+
+    std::string_view get(int64_t seq) const {
+        size_t from = seq > 1 ? ends[seq - 2] : 0;
+        return std::string_view(wire.data() + from, ends[seq - 1] - from);
+    }
+};
+
+// Replays [begin, end] and walks the result against what was sent
+bool checkReplay(chimera::FixMessageStore& store, const Templates& t, const Sent& sent,
+                 int64_t begin, int64_t end) {
+    chimera::FixEncoder gap_enc;
+    chimera::FixTagIndex idx;
+    int64_t expect = begin;
+    bool ok = true;
+    store.replay(begin, end, gap_enc, t.gap_fill, [&](std::string_view msg) {
+        if (!framed(msg, idx)) return ok = false;
+        int64_t seq = 0;
+        chimera::parseFixInt(idx.get(34), seq);
+        if (seq != expect) return ok = false;
+        if (idx.get(35) == "4") {
+            int64_t next = 0;
+            chimera::parseFixInt(idx.get(36), next);
+            if (idx.get(123) != "Y" || idx.get(43) != "Y" || next <= seq) return ok = false;
+            for (int64_t s = seq; s < next; ++s) {
+                if (!isHeartbeat(s)) return ok = false;
+            }
+            expect = next;
+            return true;
+        }
+        chimera::FixTagIndex orig_idx;
+        orig_idx.parse(sent.get(seq));
+        if (isHeartbeat(seq) || idx.get(43) != "Y" || idx.get(122) != orig_idx.get(52) ||
+            idx.get(11) != orig_idx.get(11) || idx.get(44) != orig_idx.get(44)) {
+            return ok = false;
+        }
+        ++expect;
+        return true;
+    });
+    return ok && expect == end + 1;
+}
+
+} // namespace
+
+int main() {
+    const int64_t N = 1000000;
+    Templates t;
+    std::remove(STORE_PATH);
+
+    chimera::FixMessageStore store;
+    if (!store.open(STORE_PATH)) {
+        std::fprintf(stderr, "cannot map %s\n", STORE_PATH);
+        return 1;
+    }
+
+    // Messages encoded up front so only the append is timed
+    Sent sent;
+    sent.ends.reserve(N);
+    {
+        chimera::FixEncoder enc;
+        for (int64_t seq = 1; seq <= N; ++seq) {
+            sent.wire.append(build(enc, t, seq));
+            sent.ends.push_back(static_cast<uint32_t>(sent.wire.size()));
+        }
+    }
+
+    uint64_t a0 = bench::allocs(), t0 = bench::nowNs();
+    for (int64_t seq = 1; seq <= N; ++seq) store.append(sent.get(seq));
+    uint64_t t1 = bench::nowNs();
+    bench::report("append", N, sent.wire.size(), t1 - t0, bench::allocs() - a0);
+
+    if (!checkReplay(store, t, sent, N - 5000, N) || !checkReplay(store, t, sent, N - 9, N - 7)) {
+        std::fprintf(stderr, "replay check failed\n");
+        return 1;
+    }
+
+    for (int pass = 0; pass < 3; ++pass) {
+        chimera::FixEncoder enc;
+        uint64_t bytes = 0;
+        a0 = bench::allocs();
+        t0 = bench::nowNs();
+        chimera::FixReplayStats stats = store.replay(1, 0, enc, t.gap_fill, [&](std::string_view msg) {
+            bytes += msg.size();
+            return true;
+        });
+        t1 = bench::nowNs();
+        bench::report("replay 1-0", N, bytes, t1 - t0, bench::allocs() - a0);
+        std::printf("%-34s %12u resent %10u gap fills (index keeps the newest %llu seqs)\n", "",
+                    stats.resent, stats.gap_fills,
+                    static_cast<unsigned long long>(chimera::FixMessageStore::DEFAULT_INDEX_SLOTS));
+    }
+
+    store.close();
+    t0 = bench::nowNs();
+    bool reopened = store.open(STORE_PATH);
+    t1 = bench::nowNs();
+    std::printf("%-34s %12.3f ms, next seq %lld\n", "recovery (reopen)", (t1 - t0) / 1e6,
+                static_cast<long long>(store.nextOutSeq()));
+    if (!reopened || store.nextOutSeq() != N + 1 || !checkReplay(store, t, sent, N - 100, N)) {
+        std::fprintf(stderr, "recovery check failed\n");
+        return 1;
+    }
+
+    store.close();
+    std::remove(STORE_PATH);
+    return 0;
+}
@@ -0,0 +1,169 @@
+// ChimeraMetals benchmarks
+// bench_fix_wakeup.cpp - Receive wakeup latency and CPU cost: blocking vs spin
+//
+// A sender thread writes its steady-clock time to a loopback TCP socket at a
+// fixed tick rate; the receiver waits the way FixReactor does and records
+// arrival minus send time.
+//   blocking   epoll_wait(-1), the thread sleeps between ticks
+//   spin       epoll_wait(0) with FixSpinBackoff, the thread never sleeps
+// CPU is the receiver thread's CPU time over wall time (100% = one core).
+//
+// Usage: bench_fix_wakeup [receiver_cpu [sender_cpu]]
+// Pin the two threads to different cores; on a single core the spinner and
+// the sender share time slices and spin latency is meaningless.
+
+#include "BenchCommon.hpp"
+#include "core/FixSpin.hpp"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+
+bool pin(int cpu) {
+    if (cpu < 0) return true;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+uint64_t threadCpuNs() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+void sleepNs(uint64_t ns) {
+    timespec ts{static_cast<time_t>(ns / 1000000000ull), static_cast<long>(ns % 1000000000ull)};
+    nanosleep(&ts, nullptr);
+}
+
+// Connected loopback TCP pair, TCP_NODELAY both ways
+bool tcpPair(int& tx, int& rx) {
+    int lfd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    if (bind(lfd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(lfd, 1) != 0 ||
+        getsockname(lfd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+        close(lfd);
+        return false;
+    }
+    tx = socket(AF_INET, SOCK_STREAM, 0);
+    if (connect(tx, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(lfd);
+        return false;
+    }
+    rx = accept(lfd, nullptr, nullptr);
+    close(lfd);
+    int one = 1;
+    setsockopt(tx, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    setsockopt(rx, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return rx >= 0;
+}
+
+struct Result {
+    std::vector<uint64_t> lat;
+    double cpu = 0.0;
+};
+
+Result runMode(bool spin, uint64_t interval_ns, int ticks, int rx_cpu, int tx_cpu) {
+    Result r;
+    int tx = -1, rx = -1;
+    if (!tcpPair(tx, rx)) return r;
+    fcntl(rx, F_SETFL, fcntl(rx, F_GETFL, 0) | O_NONBLOCK);
+
+    int ep = epoll_create1(0);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    epoll_ctl(ep, EPOLL_CTL_ADD, rx, &ev);
+
+    std::thread sender([&] {
+        pin(tx_cpu);
+        sleepNs(10000000);
+        for (int i = 0; i < ticks; ++i) {
+            uint64_t t = bench::nowNs();
+            ssize_t n = send(tx, &t, sizeof(t), 0);
+            (void)n;
+            sleepNs(interval_ns);
+        }
+    });
+
+    pin(rx_cpu);
+    r.lat.reserve(static_cast<size_t>(ticks));
+    chimera::FixSpinBackoff backoff;
+    uint64_t wall0 = bench::nowNs(), cpu0 = threadCpuNs();
+    while (static_cast<int>(r.lat.size()) < ticks) {
+        epoll_event out;
+        int n = epoll_wait(ep, &out, 1, spin ? 0 : -1);
+        if (n <= 0) {
+            backoff.pause();
+            continue;
+        }
+        backoff.reset();
+        uint64_t buf[64];
+        ssize_t got;
+        while ((got = recv(rx, buf, sizeof(buf), 0)) > 0) {
+            uint64_t now = bench::nowNs();
+            for (ssize_t i = 0; i < got / static_cast<ssize_t>(sizeof(uint64_t)); ++i) {
+                r.lat.push_back(now - buf[i]);
+            }
+        }
+    }
+    uint64_t wall = bench::nowNs() - wall0, cpu = threadCpuNs() - cpu0;
+    r.cpu = 100.0 * static_cast<double>(cpu) / static_cast<double>(wall);
+
+    sender.join();
+    close(ep);
+    close(tx);
+    close(rx);
+    return r;
+}
+
+void print(const char* name, uint64_t interval_ns, Result& r) {
+    if (r.lat.empty()) {
+        std::printf("%-10s setup failed\n", name);
+        return;
+    }
+    std::sort(r.lat.begin(), r.lat.end());
+    auto pct = [&r](double p) {
+        return static_cast<double>(r.lat[static_cast<size_t>(p * static_cast<double>(r.lat.size() - 1))]) / 1000.0;
+    };
+    std::printf("%-10s %6llu us/tick  p50 %8.2f us  p99 %8.2f us  max %9.2f us  cpu %6.1f%%\n",
+                name, static_cast<unsigned long long>(interval_ns / 1000),
+                pct(0.50), pct(0.99), pct(1.0), r.cpu);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int rx_cpu = argc > 1 ? std::atoi(argv[1]) : -1;
+    int tx_cpu = argc > 2 ? std::atoi(argv[2]) : -1;
+    std::printf("receiver cpu %d, sender cpu %d, %u cpus online\n\n",
+                rx_cpu, tx_cpu, std::thread::hardware_concurrency());
+
+    const uint64_t intervals[] = {100000, 1000000};     // 10k and 1k ticks/s
+    for (uint64_t interval : intervals) {
+        int ticks = static_cast<int>(1000000000ull / interval);
+        Result blocking = runMode(false, interval, ticks, rx_cpu, tx_cpu);
+        print("blocking", interval, blocking);
+        Result spin = runMode(true, interval, ticks, rx_cpu, tx_cpu);
+        print("spin", interval, spin);
+    }
+    return 0;
+}
@@ -0,0 +1,422 @@
+#pragma once
+
+// ChimeraMetals
+// FixBook.hpp - Flat-array L2 price-level book per symbol
+//
+// Each side is an array of LEVELS sizes addressed by tick offset from an
+// anchor price, plus a bitmap of the non-empty levels. A level update is one
+// array write and one bit; the best bid and offer are cached and, when the
+// best level empties, found again by scanning the bitmap 64 levels per word.
+// When a price falls outside the window the anchor moves so the price sits
+// in the middle, levels that fall off the far end are dropped (counted).
+//
+// Entries are applied as 35=W / 35=X send them:
+//   with MDEntryID (278, cTrader): New adds its size at its price, Change
+//     moves it, Delete removes it; live entries are tracked in a fixed
+//     open-addressed table, so only New needs 269 and 270 (a Change or
+//     Delete is found by 278 and keeps the tracked side)
+//   without 278 (price-level feeds): New and Change set the level's size,
+//     Delete clears the level
+// A 35=W snapshot clears the book first. Trades (269=2) are ignored.
+//
+// Quote thread only. Other threads read FixBookSet::depth(), published
+// through a seqlock after every message.
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+
+#include "FixMdDecoder.hpp"
+#include "FixNumeric.hpp"
+#include "FixSeqlock.hpp"
+#include "FixSymbolDirectory.hpp"
+
+namespace chimera {
+
+class FixBook {
+public:
+    static const uint32_t LEVELS = 4096;        // window, in ticks of digits()
+    static const uint32_t ENTRIES = 4096;       // 278 entries tracked at once
+
+    explicit FixBook(int digits = FixPricePrecision::DEFAULT_DIGITS)
+        : digits_(digits),
+          entries_(new Entry[ENTRIES]),
+          recenters_(0),
+          dropped_(0)
+    {
+        clear();
+    }
+
+    FixBook(const FixBook&) = delete;
+    FixBook& operator=(const FixBook&) = delete;
+
+    // Empties both sides and forgets every entry; the next price anchors
+    void clear() {
+        std::memset(sizes_, 0, sizeof(sizes_));
+        std::memset(bits_, 0, sizeof(bits_));
+        std::memset(static_cast<void*>(entries_.get()), 0, sizeof(Entry) * ENTRIES);
+        live_ = 0;
+        anchor_ = 0;
+        anchored_ = false;
+        best_[BID] = NONE;
+        best_[ASK] = NONE;
+    }
+
+    // False if the entry was ignored: a trade, a New without a side, a
+    // Change or Delete of an entry not tracked and without side and price,
+    // or the entry table is full
+    bool apply(const FixMdEntry& e) {
+        bool sided = e.type == '0' || e.type == '1';
+        if (e.type != '\0' && !sided) return false;
+        int side = e.type == '1' ? ASK : BID;
+        int64_t size = e.has_size ? e.size : 0;
+        // An empty book counts ticks in the feed's own digits
+        if (e.has_price && !anchored_) digits_ = e.price.digits;
+
+        if (e.entry_id.empty()) {
+            if (!sided || !e.has_price) return false;
+            setLevel(side, ticksOf(e.price), e.action == FixMdAction::Delete ? 0 : size);
+            return true;
+        }
+        if (e.action == FixMdAction::New && !sided) return false;
+
+        uint64_t key = keyOf(e.entry_id);
+        Entry prev{};
+        if (Entry* found = findEntry(key)) {
+            prev = *found;
+            addLevel(prev.side, prev.ticks, -prev.size);
+            removeEntry(found);
+        }
+        bool located = sided && e.has_price;
+        if (e.action == FixMdAction::Delete) {
+            if (!prev.key && located) setLevel(side, ticksOf(e.price), 0);
+            return prev.key || located;
+        }
+        if (!prev.key && !located) return false;
+
+        // A Change may carry only 278 and the new size
+        int64_t ticks = e.has_price ? ticksOf(e.price) : prev.ticks;
+        if (prev.key && e.action == FixMdAction::Change) side = prev.side;
+        // An entry the table cannot hold would never leave its level
+        if (!insertEntry(key, side, ticks, size)) {
+            ++dropped_;
+            return false;
+        }
+        addLevel(side, ticks, size);
+        return true;
+    }
+
+    int digits() const { return digits_; }
+    bool hasBid() const { return best_[BID] != NONE; }
+    bool hasAsk() const { return best_[ASK] != NONE; }
+    int64_t bidTicks() const { return anchor_ + best_[BID]; }
+    int64_t askTicks() const { return anchor_ + best_[ASK]; }
+    int64_t bidSize() const { return hasBid() ? sizes_[BID][best_[BID]] : 0; }   // FIX_SIZE_DIGITS
+    int64_t askSize() const { return hasAsk() ? sizes_[ASK][best_[ASK]] : 0; }
+
+    // Best bid and offer, for FixQuoteCache
+    FixMdTop top(int64_t symbol_id = -1) const {
+        FixMdTop t{};
+        t.symbol_id = symbol_id;
+        t.has_bid = hasBid();
+        t.has_ask = hasAsk();
+        if (t.has_bid) t.bid = FixPrice{bidTicks(), digits_};
+        if (t.has_ask) t.ask = FixPrice{askTicks(), digits_};
+        t.bid_size = bidSize();
+        t.ask_size = askSize();
+        return t;
+    }
+
+    // Units at the best bid plus the best offer
+    double depthTop() const {
+        return static_cast<double>(bidSize() + askSize()) / fixPow10(FIX_SIZE_DIGITS);
+    }
+
+    // Units over the best n non-empty levels of a side
+    double bidDepth(size_t n) const { return units(sideDepth(BID, n)); }
+    double askDepth(size_t n) const { return units(sideDepth(ASK, n)); }
+
+    // (bid - ask) / (bid + ask) over the best n levels; 0 when both are empty
+    double imbalance(size_t n) const {
+        int64_t b = sideDepth(BID, n), a = sideDepth(ASK, n);
+        return b + a > 0 ? static_cast<double>(b - a) / static_cast<double>(b + a) : 0.0;
+    }
+
+    size_t levels(bool bid) const {
+        int side = bid ? BID : ASK;
+        size_t n = 0;
+        for (uint32_t w = 0; w < WORDS; ++w) n += static_cast<size_t>(std::popcount(bits_[side][w]));
+        return n;
+    }
+
+    size_t entries() const { return live_; }
+    uint64_t recenters() const { return recenters_; }   // the anchor moved
+    uint64_t dropped() const { return dropped_; }       // levels off the window, entries not tracked
+
+private:
+    static const int BID = 0;
+    static const int ASK = 1;
+    static const uint32_t WORDS = LEVELS / 64;
+    static const int32_t NONE = -1;
+
+    struct Entry {
+        uint64_t key;               // 0 = free
+        int64_t ticks;
+        int64_t size;
+        int side;
+    };
+
+    static double units(int64_t size) {
+        return static_cast<double>(size) / fixPow10(FIX_SIZE_DIGITS);
+    }
+
+    int64_t ticksOf(const FixPrice& p) const {
+        if (p.digits == digits_) return p.ticks;
+        if (p.digits > digits_) return p.ticks / fixPow10(p.digits - digits_);
+        return p.ticks * fixPow10(digits_ - p.digits);
+    }
+
+    // Offset of ticks in the window, moving the anchor if it falls outside
+    int32_t offset(int64_t ticks) {
+        if (!anchored_) {
+            anchor_ = ticks - LEVELS / 2;
+            anchored_ = true;
+        }
+        int64_t off = ticks - anchor_;
+        if (off < 0 || off >= LEVELS) {
+            recenter(ticks - LEVELS / 2);
+            off = ticks - anchor_;
+        }
+        return static_cast<int32_t>(off);
+    }
+
+    void recenter(int64_t anchor) {
+        ++recenters_;
+        int64_t shift = anchor - anchor_;
+        for (int side = 0; side < 2; ++side) {
+            int64_t* s = sizes_[side];
+            if (shift >= LEVELS || shift <= -static_cast<int64_t>(LEVELS)) {
+                for (uint32_t i = 0; i < LEVELS; ++i) dropped_ += s[i] != 0;
+                std::memset(s, 0, sizeof(sizes_[side]));
+            } else if (shift > 0) {
+                for (int64_t i = 0; i < shift; ++i) dropped_ += s[i] != 0;
+                std::memmove(s, s + shift, sizeof(int64_t) * (LEVELS - shift));
+                std::memset(s + LEVELS - shift, 0, sizeof(int64_t) * shift);
+            } else if (shift < 0) {
+                for (int64_t i = LEVELS + shift; i < LEVELS; ++i) dropped_ += s[i] != 0;
+                std::memmove(s - shift, s, sizeof(int64_t) * (LEVELS + shift));
+                std::memset(s, 0, sizeof(int64_t) * -shift);
+            }
+            std::memset(bits_[side], 0, sizeof(bits_[side]));
+            for (uint32_t i = 0; i < LEVELS; ++i) {
+                if (s[i]) bits_[side][i / 64] |= 1ull << (i % 64);
+            }
+        }
+        anchor_ = anchor;
+        best_[BID] = scanDown(BID, LEVELS - 1);
+        best_[ASK] = scanUp(ASK, 0);
+    }
+
+    void setLevel(int side, int64_t ticks, int64_t size) {
+        if (size <= 0 && (!anchored_ || ticks < anchor_ || ticks - anchor_ >= LEVELS)) return;
+        int32_t i = offset(ticks);
+        update(side, i, size > 0 ? size : 0);
+    }
+
+    void addLevel(int side, int64_t ticks, int64_t delta) {
+        if (delta == 0) return;
+        if (delta < 0 && (!anchored_ || ticks < anchor_ || ticks - anchor_ >= LEVELS)) return;   // already dropped
+        int32_t i = offset(ticks);
+        int64_t size = sizes_[side][i] + delta;
+        update(side, i, size > 0 ? size : 0);
+    }
+
+    void update(int side, int32_t i, int64_t size) {
+        sizes_[side][i] = size;
+        uint64_t bit = 1ull << (i % 64);
+        if (size) {
+            bits_[side][i / 64] |= bit;
+            if (best_[side] == NONE || (side == BID ? i > best_[side] : i < best_[side])) best_[side] = i;
+        } else {
+            bits_[side][i / 64] &= ~bit;
+            if (i == best_[side]) best_[side] = side == BID ? scanDown(BID, i) : scanUp(ASK, i);
+        }
+    }
+
+    // Highest non-empty level at or below from, NONE if none
+    int32_t scanDown(int side, int32_t from) const {
+        int32_t w = from / 64;
+        uint64_t m = bits_[side][w] & (~0ull >> (63 - from % 64));
+        while (!m) {
+            if (--w < 0) return NONE;
+            m = bits_[side][w];
+        }
+        return w * 64 + 63 - std::countl_zero(m);
+    }
+
+    // Lowest non-empty level at or above from, NONE if none
+    int32_t scanUp(int side, int32_t from) const {
+        int32_t w = from / 64;
+        uint64_t m = bits_[side][w] & (~0ull << (from % 64));
+        while (!m) {
+            if (++w == static_cast<int32_t>(WORDS)) return NONE;
+            m = bits_[side][w];
+        }
+        return w * 64 + std::countr_zero(m);
+    }
+
+    int64_t sideDepth(int side, size_t n) const {
+        int64_t total = 0;
+        int32_t i = best_[side];
+        for (size_t k = 0; k < n && i != NONE; ++k) {
+            total += sizes_[side][i];
+            if (side == BID) i = i == 0 ? NONE : scanDown(BID, i - 1);
+            else i = i == static_cast<int32_t>(LEVELS) - 1 ? NONE : scanUp(ASK, i + 1);
+        }
+        return total;
+    }
+
+    // 278 as an integer when numeric (cTrader), else a hash of the text
+    static uint64_t keyOf(std::string_view id) {
+        int64_t n = 0;
+        uint64_t key;
+        if (parseFixInt(id, n) == FixNumError::None && n > 0) {
+            key = static_cast<uint64_t>(n);
+        } else {
+            key = 14695981039346656037ull;
+            for (char c : id) key = (key ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        }
+        return key ? key : 1;
+    }
+
+    static uint32_t slotOf(uint64_t key) {
+        return static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ull) >> 52) & (ENTRIES - 1);
+    }
+
+    Entry* findEntry(uint64_t key) {
+        for (uint32_t i = slotOf(key);; i = (i + 1) & (ENTRIES - 1)) {
+            Entry& e = entries_[i];
+            if (e.key == key) return &e;
+            if (e.key == 0) return nullptr;
+        }
+    }
+
+    // Kept under 3/4 full so probes stay short; false when it is
+    bool insertEntry(uint64_t key, int side, int64_t ticks, int64_t size) {
+        if (live_ >= ENTRIES / 4 * 3) return false;
+        uint32_t i = slotOf(key);
+        while (entries_[i].key != 0) i = (i + 1) & (ENTRIES - 1);
+        entries_[i] = Entry{key, ticks, size, side};
+        ++live_;
+        return true;
+    }
+
+    // Backward-shift delete: no tombstones, probe chains stay intact
+    void removeEntry(Entry* e) {
+        uint32_t hole = static_cast<uint32_t>(e - entries_.get());
+        uint32_t i = hole;
+        for (;;) {
+            i = (i + 1) & (ENTRIES - 1);
+            if (entries_[i].key == 0) break;
+            uint32_t home = slotOf(entries_[i].key);
+            // Move it back if its home is not in (hole, i]
+            if (((i - home) & (ENTRIES - 1)) >= ((i - hole) & (ENTRIES - 1))) {
+                entries_[hole] = entries_[i];
+                hole = i;
+            }
+        }
+        entries_[hole].key = 0;
+        --live_;
+    }
+
+    int digits_;
+    int64_t anchor_;
+    bool anchored_;
+    int32_t best_[2];
+    int64_t sizes_[2][LEVELS];
+    uint64_t bits_[2][WORDS];
+    std::unique_ptr<Entry[]> entries_;
+    size_t live_;
+    uint64_t recenters_;
+    uint64_t dropped_;
+};
+
+// What engines and the dashboard read per symbol after each message
+struct FixDepth {
+    double depth_top;               // units at best bid + best offer
+    double bid_depth;               // units over DEPTH_LEVELS levels
+    double ask_depth;
+    double imbalance;               // (bid - ask) / (bid + ask) over the same
+    uint64_t updates;
+};
+
+// One FixBook per directory handle, allocated on the symbol's first entry
+class FixBookSet {
+public:
+    static const size_t DEPTH_LEVELS = 5;
+
+    explicit FixBookSet(const FixSymbolDirectory& symbols)
+        : symbols_(symbols),
+          depth_(new FixSeqlock<FixDepth>[FixSymbolDirectory::MAX_SYMBOLS]),
+          batch_(0),
+          seen_{}
+    {}
+
+    FixBookSet(const FixBookSet&) = delete;
+    FixBookSet& operator=(const FixBookSet&) = delete;
+
+    // Quote thread. Applies a decoded 35=W / 35=X and publishes the depth
+    // of every symbol it touched; their handles go to touched (up to max).
+    // Every entry is applied; a symbol past max is only left unpublished.
+    size_t apply(const FixMdBatch& batch, FixSymbolHandle* touched, size_t max) {
+        size_t n = 0;
+        ++batch_;
+        for (const FixMdEntry& e : batch) {
+            FixSymbolHandle h = e.symbol_id >= 0 ? symbols_.byId(e.symbol_id) : symbols_.byName(e.symbol);
+            if (h >= FixSymbolDirectory::MAX_SYMBOLS) continue;
+
+            if (seen_[h] != batch_) {
+                seen_[h] = batch_;
+                if (n < max) touched[n++] = h;
+                if (batch.snapshot()) book(h).clear();
+            }
+            book(h).apply(e);
+        }
+        for (size_t t = 0; t < n; ++t) publish(touched[t]);
+        return n;
+    }
+
+    // Quote thread
+    FixBook& book(FixSymbolHandle h) {
+        if (!books_[h]) books_[h].reset(new FixBook(symbols_[h].digits));
+        return *books_[h];
+    }
+
+    // Any thread; all zero until the symbol's first message
+    FixDepth depth(FixSymbolHandle h) const {
+        if (h >= FixSymbolDirectory::MAX_SYMBOLS) return FixDepth();
+        return depth_[h].load();
+    }
+
+private:
+    void publish(FixSymbolHandle h) {
+        const FixBook& b = *books_[h];
+        FixDepth d = depth_[h].load();
+        d.depth_top = b.depthTop();
+        d.bid_depth = b.bidDepth(DEPTH_LEVELS);
+        d.ask_depth = b.askDepth(DEPTH_LEVELS);
+        d.imbalance = b.imbalance(DEPTH_LEVELS);
+        ++d.updates;
+        depth_[h].store(d);
+    }
+
+    const FixSymbolDirectory& symbols_;
+    std::unique_ptr<FixBook> books_[FixSymbolDirectory::MAX_SYMBOLS];
+    std::unique_ptr<FixSeqlock<FixDepth>[]> depth_;
+    uint64_t batch_;                                        // apply() calls so far
+    uint64_t seen_[FixSymbolDirectory::MAX_SYMBOLS];        // batch_ at each symbol's last touch
+};
+
+} // namespace chimera
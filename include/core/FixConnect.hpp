@@ -0,0 +1,214 @@
+#pragma once
+
+// ChimeraMetals
+// FixConnect.hpp - Reconnect fast path: cached resolver, reusable TLS client
+// context with session resumption, per-stage connect timing
+//
+// After a broker drop the time to a Logon ACK is DNS + TCP + TLS + Logon.
+// FixResolver answers from its cache and refreshes in the background, so DNS
+// costs nothing on reconnect. FixTlsClient keeps one SSL_CTX per endpoint for
+// the life of the process and offers the last session ticket, turning the
+// full handshake into an abbreviated one when the server accepts it.
+// FixConnectTiming records each stage so the saving can be measured.
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <openssl/ssl.h>
+
+#include "platform/platform.hpp"
+
+namespace chimera {
+
+// Durations of the last connect, ns; 0 = stage skipped (cached DNS still
+// records its lookup time, a promoted standby skips DNS, TCP and TLS)
+struct FixConnectTiming {
+    int64_t dns_ns = 0;
+    int64_t tcp_ns = 0;
+    int64_t tls_ns = 0;
+    int64_t logon_ns = 0;
+    bool dns_cached = false;
+    bool tls_resumed = false;
+    bool standby = false;           // logon went out on a pre-connected socket
+
+    int64_t totalNs() const {
+        return dns_ns + tcp_ns + tls_ns + logon_ns;
+    }
+};
+
+// IPv4 address cache for one host:port. The first lookup resolves inline;
+// later ones return the cached address at once and, when it is older than
+// the TTL, refresh it on a background thread. A failed refresh keeps the old
+// address. invalidate() forces the next lookup to resolve inline.
+class FixResolver {
+public:
+    FixResolver()
+        : port_(0),
+          ttl_ns_(300LL * 1000000000LL),
+          have_(false),
+          resolved_ns_(0),
+          refreshing_(false)
+    {}
+
+    ~FixResolver() {
+        if (worker_.joinable()) worker_.join();
+    }
+
+    FixResolver(const FixResolver&) = delete;
+    FixResolver& operator=(const FixResolver&) = delete;
+
+    void setTarget(const std::string& host, uint16_t port, int64_t ttl_ns) {
+        std::lock_guard<std::mutex> lg(mtx_);
+        host_ = host;
+        port_ = port;
+        ttl_ns_ = ttl_ns;
+        have_ = false;
+    }
+
+    bool lookup(sockaddr_in& out, bool& cached) {
+        {
+            std::lock_guard<std::mutex> lg(mtx_);
+            if (have_) {
+                out = addr_;
+                cached = true;
+                if (nowNs() - resolved_ns_ >= ttl_ns_) startRefresh();
+                return true;
+            }
+        }
+        cached = false;
+        return resolveInto(out);
+    }
+
+    // Warms the cache without waiting, e.g. at startup
+    void prefetch() {
+        std::lock_guard<std::mutex> lg(mtx_);
+        startRefresh();
+    }
+
+    void invalidate() {
+        std::lock_guard<std::mutex> lg(mtx_);
+        have_ = false;
+    }
+
+private:
+    static int64_t nowNs() {
+        return static_cast<int64_t>(plat::monotonic_time_ns());
+    }
+
+    bool resolveInto(sockaddr_in& out) {
+        std::string host;
+        uint16_t port;
+        {
+            std::lock_guard<std::mutex> lg(mtx_);
+            host = host_;
+            port = port_;
+        }
+        sockaddr_in addr{};
+        if (!plat::resolve_ipv4(host.c_str(), port, addr)) return false;
+
+        std::lock_guard<std::mutex> lg(mtx_);
+        if (host == host_ && port == port_) {
+            addr_ = addr;
+            have_ = true;
+            resolved_ns_ = nowNs();
+        }
+        out = addr;
+        return true;
+    }
+
+    // mtx_ held
+    void startRefresh() {
+        if (refreshing_.exchange(true)) return;
+        if (worker_.joinable()) worker_.join();     // the previous refresh has finished
+        worker_ = std::thread([this]() {
+            sockaddr_in ignored;
+            resolveInto(ignored);
+            refreshing_.store(false);
+        });
+    }
+
+    std::mutex mtx_;
+    std::string host_;
+    uint16_t port_;
+    int64_t ttl_ns_;
+    sockaddr_in addr_{};
+    bool have_;
+    int64_t resolved_ns_;
+    std::atomic<bool> refreshing_;
+    std::thread worker_;
+};
+
+// One client SSL_CTX per endpoint, kept across reconnects. Session tickets
+// from the server (TLS 1.2 tickets, TLS 1.3 NewSessionTicket) are captured
+// by the new-session callback and offered on the next connection.
+class FixTlsClient {
+public:
+    FixTlsClient()
+        : ctx_(SSL_CTX_new(TLS_client_method())),
+          session_(nullptr)
+    {
+        if (!ctx_) return;
+        SSL_CTX_set_app_data(ctx_, this);
+        SSL_CTX_set_session_cache_mode(ctx_, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(ctx_, &FixTlsClient::onNewSession);
+    }
+
+    ~FixTlsClient() {
+        if (session_) SSL_SESSION_free(session_);
+        if (ctx_) SSL_CTX_free(ctx_);
+    }
+
+    FixTlsClient(const FixTlsClient&) = delete;
+    FixTlsClient& operator=(const FixTlsClient&) = delete;
+
+    SSL_CTX* ctx() const {
+        return ctx_;
+    }
+
+    // Before the handshake: SNI plus the last ticket, if any
+    void prepare(SSL* ssl, const std::string& host) {
+        if (!host.empty()) SSL_set_tlsext_host_name(ssl, host.c_str());
+        std::lock_guard<std::mutex> lg(mtx_);
+        if (session_) SSL_set_session(ssl, session_);
+    }
+
+    // After the handshake
+    static bool resumed(SSL* ssl) {
+        return SSL_session_reused(ssl) == 1;
+    }
+
+    bool hasSession() const {
+        std::lock_guard<std::mutex> lg(mtx_);
+        return session_ != nullptr;
+    }
+
+    void forgetSession() {
+        std::lock_guard<std::mutex> lg(mtx_);
+        if (session_) SSL_SESSION_free(session_);
+        session_ = nullptr;
+    }
+
+private:
+    // Keeps a copy: OpenSSL marks the connection's own session not resumable
+    // when that connection dies without close_notify, which is exactly how
+    // broker drops look
+    static int onNewSession(SSL* ssl, SSL_SESSION* sess) {
+        FixTlsClient* self = static_cast<FixTlsClient*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+        if (!self) return 0;
+        SSL_SESSION* copy = SSL_SESSION_dup(sess);
+        if (!copy) return 0;
+        std::lock_guard<std::mutex> lg(self->mtx_);
+        if (self->session_) SSL_SESSION_free(self->session_);
+        self->session_ = copy;
+        return 0;
+    }
+
+    SSL_CTX* ctx_;
+    SSL_SESSION* session_;
+    mutable std::mutex mtx_;
+};
+
+} // namespace chimera
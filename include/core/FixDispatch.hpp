@@ -0,0 +1,135 @@
+#pragma once
+
+// ChimeraMetals
+// FixDispatch.hpp - Compile-time MsgType (35) dispatch to typed handlers
+//
+// A handler is any type exposing some of:
+//   onLogon, onLogout, onHeartbeat, onTestRequest, onResendRequest, onReject,
+//   onSequenceReset, onSecurityList, onMarketDataSnapshot,
+//   onMarketDataIncremental, onExecutionReport, onOrderCancelReject
+// and, for the acceptor side (tools/fix_acceptor_sim.cpp):
+//   onSecurityListRequest, onMarketDataRequest, onNewOrderSingle
+// each taking (std::string_view msg, const FixTagIndex& idx). fixDispatch()
+// reads 35= once and jumps through a constexpr table built per handler type,
+// so adding a handler never adds a branch to the others and an unknown or
+// unhandled MsgType is one table load. Handler members must be public:
+// a private one is simply not bound.
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "FixTagIndex.hpp"
+
+namespace chimera {
+
+enum class FixMsgType : uint8_t {
+    Unknown = 0,
+    Heartbeat,              // 0
+    TestRequest,            // 1
+    ResendRequest,          // 2
+    Reject,                 // 3
+    SequenceReset,          // 4
+    Logout,                 // 5
+    ExecutionReport,        // 8
+    OrderCancelReject,      // 9
+    Logon,                  // A
+    MarketDataSnapshot,     // W
+    MarketDataIncremental,  // X
+    SecurityList,           // y
+    SecurityListRequest,    // x
+    MarketDataRequest,      // V
+    NewOrderSingle          // D
+};
+
+// Single-byte MsgType -> FixMsgType, built at compile time
+constexpr std::array<FixMsgType, 128> FIX_MSG_TYPES = [] {
+    std::array<FixMsgType, 128> t{};
+    t['0'] = FixMsgType::Heartbeat;
+    t['1'] = FixMsgType::TestRequest;
+    t['2'] = FixMsgType::ResendRequest;
+    t['3'] = FixMsgType::Reject;
+    t['4'] = FixMsgType::SequenceReset;
+    t['5'] = FixMsgType::Logout;
+    t['8'] = FixMsgType::ExecutionReport;
+    t['9'] = FixMsgType::OrderCancelReject;
+    t['A'] = FixMsgType::Logon;
+    t['W'] = FixMsgType::MarketDataSnapshot;
+    t['X'] = FixMsgType::MarketDataIncremental;
+    t['y'] = FixMsgType::SecurityList;
+    t['x'] = FixMsgType::SecurityListRequest;
+    t['V'] = FixMsgType::MarketDataRequest;
+    t['D'] = FixMsgType::NewOrderSingle;
+    return t;
+}();
+
+inline FixMsgType fixMsgType(std::string_view value) {
+    if (value.size() != 1) return FixMsgType::Unknown;
+    unsigned char c = static_cast<unsigned char>(value[0]);
+    return c < FIX_MSG_TYPES.size() ? FIX_MSG_TYPES[c] : FixMsgType::Unknown;
+}
+
+// 35= is always the third header field (8=, 9=, 35=); read it without an index
+inline std::string_view fixHeaderMsgType(std::string_view msg) {
+    size_t first = msg.find('\x01');
+    if (first == std::string_view::npos) return std::string_view();
+    size_t second = msg.find('\x01', first + 1);
+    if (second == std::string_view::npos || msg.compare(second + 1, 3, "35=") != 0) {
+        return std::string_view();
+    }
+    size_t start = second + 4;
+    size_t end = msg.find('\x01', start);
+    if (end == std::string_view::npos) return std::string_view();
+    return msg.substr(start, end - start);
+}
+
+namespace fix_dispatch_detail {
+
+template <typename H>
+using HandlerFn = void (*)(H&, std::string_view, const FixTagIndex&);
+
+#define CHIMERA_FIX_BIND(TYPE, METHOD)                                                       \
+    if constexpr (requires(H& h, std::string_view m, const FixTagIndex& i) { h.METHOD(m, i); }) { \
+        t[static_cast<size_t>(FixMsgType::TYPE)] =                                            \
+            [](H& h, std::string_view m, const FixTagIndex& i) { h.METHOD(m, i); };           \
+    }
+
+template <typename H>
+constexpr auto makeTable() {
+    std::array<HandlerFn<H>, 16> t{};
+    CHIMERA_FIX_BIND(Heartbeat, onHeartbeat)
+    CHIMERA_FIX_BIND(TestRequest, onTestRequest)
+    CHIMERA_FIX_BIND(ResendRequest, onResendRequest)
+    CHIMERA_FIX_BIND(Reject, onReject)
+    CHIMERA_FIX_BIND(SequenceReset, onSequenceReset)
+    CHIMERA_FIX_BIND(Logout, onLogout)
+    CHIMERA_FIX_BIND(ExecutionReport, onExecutionReport)
+    CHIMERA_FIX_BIND(OrderCancelReject, onOrderCancelReject)
+    CHIMERA_FIX_BIND(Logon, onLogon)
+    CHIMERA_FIX_BIND(MarketDataSnapshot, onMarketDataSnapshot)
+    CHIMERA_FIX_BIND(MarketDataIncremental, onMarketDataIncremental)
+    CHIMERA_FIX_BIND(SecurityList, onSecurityList)
+    CHIMERA_FIX_BIND(SecurityListRequest, onSecurityListRequest)
+    CHIMERA_FIX_BIND(MarketDataRequest, onMarketDataRequest)
+    CHIMERA_FIX_BIND(NewOrderSingle, onNewOrderSingle)
+    return t;
+}
+
+#undef CHIMERA_FIX_BIND
+
+template <typename H>
+inline constexpr auto TABLE = makeTable<H>();
+
+} // namespace fix_dispatch_detail
+
+// Returns true when a handler for the message's type ran
+template <typename H>
+inline bool fixDispatch(H& handler, std::string_view msg, const FixTagIndex& idx) {
+    FixMsgType type = fixMsgType(idx.get(35));
+    fix_dispatch_detail::HandlerFn<H> fn = fix_dispatch_detail::TABLE<H>[static_cast<size_t>(type)];
+    if (!fn) return false;
+    fn(handler, msg, idx);
+    return true;
+}
+
+} // namespace chimera
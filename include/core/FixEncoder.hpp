@@ -0,0 +1,316 @@
+#pragma once
+
+// ChimeraMetals
+// FixEncoder.hpp - Pre-rendered FIX message templates, patched in place
+//
+// A FixMsgTemplate renders once, per session and MsgType, every byte that
+// never changes: "35=x|49=..|56=..|50=..|57=..|34=" and an optional static
+// body, together with their byte sums. FixEncoder copies those into a
+// reusable buffer, writes only MsgSeqNum, SendingTime and the variable
+// fields, keeps the CheckSum running as it writes, and finally places
+// "8=FIX.4.4|9=<len>|" in front of the body. Nothing on the send path
+// touches the heap.
+//
+//   enc.begin(tmpl, seq).field(11, id).body(tmpl).price(44, ticks, 2).finish();
+//
+// begin(tmpl, seq) stamps SendingTime from the thread's FixTimestampCache at
+// the session's configured precision, straight into the buffer.
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "FixSimd.hpp"
+#include "FixTime.hpp"
+
+namespace chimera {
+
+// CompIDs and SubIDs stamped into every message of one session
+struct FixSessionIds {
+    std::string begin_string = "FIX.4.4";
+    std::string sender_comp_id;     // 49
+    std::string target_comp_id;     // 56
+    std::string sender_sub_id;      // 50, omitted when empty
+    std::string target_sub_id;      // 57, omitted when empty
+    FixTimePrecision sending_time_precision = FixTimePrecision::Seconds;   // 52
+};
+
+// A pre-rendered run of complete "tag=value\x01" fields and its byte sum
+class FixStaticFields {
+public:
+    FixStaticFields() : sum_(0) {}
+
+    explicit FixStaticFields(std::string_view fields)
+        : bytes_(fields),
+          sum_(fixSimd().byteSum(fields.data(), fields.size()))
+    {}
+
+    std::string_view bytes() const { return bytes_; }
+    uint32_t sum() const { return sum_; }
+
+private:
+    std::string bytes_;
+    uint32_t sum_;
+};
+
+class FixMsgTemplate {
+public:
+    FixMsgTemplate() : precision_(FixTimePrecision::Seconds), prefix_sum_(0), header_sum_(0) {}
+
+    // static_body is a run of complete "tag=value\x01" fields
+    FixMsgTemplate(const FixSessionIds& ids, std::string_view msg_type, std::string_view static_body = {})
+        : precision_(ids.sending_time_precision)
+    {
+        prefix_ = "8=" + ids.begin_string + "\x01" "9=";
+        header_.reserve(64 + ids.sender_comp_id.size() + ids.target_comp_id.size());
+        header_.append("35=").append(msg_type).append("\x01");
+        header_.append("49=").append(ids.sender_comp_id).append("\x01");
+        header_.append("56=").append(ids.target_comp_id).append("\x01");
+        if (!ids.sender_sub_id.empty()) header_.append("50=").append(ids.sender_sub_id).append("\x01");
+        if (!ids.target_sub_id.empty()) header_.append("57=").append(ids.target_sub_id).append("\x01");
+        header_.append("34=");
+        body_ = FixStaticFields(static_body);
+
+        prefix_sum_ = fixSimd().byteSum(prefix_.data(), prefix_.size());
+        header_sum_ = fixSimd().byteSum(header_.data(), header_.size());
+    }
+
+    std::string_view prefix() const { return prefix_; }
+    std::string_view header() const { return header_; }
+    const FixStaticFields& body() const { return body_; }
+    uint32_t prefixSum() const { return prefix_sum_; }
+    uint32_t headerSum() const { return header_sum_; }
+    FixTimePrecision sendingTimePrecision() const { return precision_; }
+
+private:
+    std::string prefix_;    // "8=FIX.4.4\x01" "9="
+    std::string header_;    // "35=..\x01" ... "34="
+    FixStaticFields body_;
+    FixTimePrecision precision_;
+    uint32_t prefix_sum_;
+    uint32_t header_sum_;
+};
+
+class FixEncoder {
+public:
+    static const size_t CAPACITY = 8192;
+    static const size_t HEADROOM = 32;     // room for "8=FIX.4.4|9=<len>|"
+
+    FixEncoder()
+        : tmpl_(nullptr),
+          pos_(HEADROOM),
+          sum_(0),
+          overflow_(false)
+    {}
+
+    // Starts a message: cached header, MsgSeqNum and SendingTime
+    FixEncoder& begin(const FixMsgTemplate& t, int64_t seq, std::string_view sending_time) {
+        tmpl_ = &t;
+        pos_ = HEADROOM;
+        sum_ = 0;
+        overflow_ = false;
+        raw(t.header(), t.headerSum());
+        integer(seq);
+        put('\x01');
+        tag(52);
+        bytes(sending_time);
+        put('\x01');
+        return *this;
+    }
+
+    // As above, SendingTime = now at the template's precision
+    FixEncoder& begin(const FixMsgTemplate& t, int64_t seq) {
+        return begin(t, seq, fixWallClockNs());
+    }
+
+    FixEncoder& begin(const FixMsgTemplate& t, int64_t seq, int64_t sending_ns) {
+        tmpl_ = &t;
+        pos_ = HEADROOM;
+        sum_ = 0;
+        overflow_ = false;
+        raw(t.header(), t.headerSum());
+        integer(seq);
+        put('\x01');
+        tag(52);
+        if (reserve(FIX_TIMESTAMP_MAX + 1)) {
+            pos_ += fixThreadTimestampCache().format(buf_ + pos_, sending_ns, t.sendingTimePrecision(), sum_);
+        }
+        put('\x01');
+        return *this;
+    }
+
+    // Appends the template's pre-rendered static body at this point
+    FixEncoder& body(const FixMsgTemplate& t) {
+        return fields(t.body());
+    }
+
+    FixEncoder& fields(const FixStaticFields& f) {
+        return raw(f.bytes(), f.sum());
+    }
+
+    FixEncoder& field(uint32_t t, std::string_view v) {
+        tag(t);
+        bytes(v);
+        put('\x01');
+        return *this;
+    }
+
+    FixEncoder& field(uint32_t t, int64_t v) {
+        tag(t);
+        integer(v);
+        put('\x01');
+        return *this;
+    }
+
+    FixEncoder& field(uint32_t t, int v) {
+        return field(t, static_cast<int64_t>(v));
+    }
+
+    FixEncoder& field(uint32_t t, char v) {
+        tag(t);
+        put(v);
+        put('\x01');
+        return *this;
+    }
+
+    // prefix followed by a number, e.g. 262=MDReq-<seq>
+    FixEncoder& field(uint32_t t, std::string_view prefix, int64_t v) {
+        tag(t);
+        bytes(prefix);
+        integer(v);
+        put('\x01');
+        return *this;
+    }
+
+    // UTCTimestamp field (60=, 126=, ...) through the thread's FixTimestampCache
+    FixEncoder& timestamp(uint32_t t, int64_t epoch_ns, FixTimePrecision precision) {
+        tag(t);
+        if (reserve(FIX_TIMESTAMP_MAX + 1)) {
+            pos_ += fixThreadTimestampCache().format(buf_ + pos_, epoch_ns, precision, sum_);
+        }
+        put('\x01');
+        return *this;
+    }
+
+    // Fixed-point value: ticks=517334, digits=2 -> 5173.34
+    FixEncoder& price(uint32_t t, int64_t ticks, int digits) {
+        tag(t);
+        if (ticks < 0) {
+            put('-');
+            ticks = -ticks;
+        }
+        if (digits <= 0) {
+            integer(ticks);
+        } else {
+            char tmp[24];
+            char* end = std::to_chars(tmp, tmp + sizeof(tmp), static_cast<uint64_t>(ticks)).ptr;
+            size_t n = static_cast<size_t>(end - tmp);
+            size_t d = static_cast<size_t>(digits);
+            if (n <= d) {
+                put('0');
+                put('.');
+                for (size_t i = n; i < d; ++i) put('0');
+                bytes(std::string_view(tmp, n));
+            } else {
+                bytes(std::string_view(tmp, n - d));
+                put('.');
+                bytes(std::string_view(tmp + n - d, d));
+            }
+        }
+        put('\x01');
+        return *this;
+    }
+
+    // Copies pre-rendered fields whose byte sum is already known
+    FixEncoder& raw(std::string_view v, uint32_t sum) {
+        if (!reserve(v.size())) return *this;
+        std::memcpy(buf_ + pos_, v.data(), v.size());
+        pos_ += v.size();
+        sum_ += sum;
+        return *this;
+    }
+
+    // Writes BeginString/BodyLength in front of the body and appends CheckSum.
+    // Returns the complete message, valid until the next begin(); empty if the
+    // message did not fit.
+    std::string_view finish() {
+        if (overflow_ || !tmpl_ || !reserve(7)) return std::string_view();
+
+        char len[16];
+        char* len_end = std::to_chars(len, len + sizeof(len), pos_ - HEADROOM).ptr;
+        size_t len_n = static_cast<size_t>(len_end - len);
+        std::string_view prefix = tmpl_->prefix();
+        size_t head = prefix.size() + len_n + 1;
+        if (head > HEADROOM) return std::string_view();
+
+        char* start = buf_ + HEADROOM - head;
+        std::memcpy(start, prefix.data(), prefix.size());
+        std::memcpy(start + prefix.size(), len, len_n);
+        start[head - 1] = '\x01';
+
+        uint32_t total = sum_ + tmpl_->prefixSum() + '\x01';
+        for (size_t i = 0; i < len_n; ++i) total += static_cast<unsigned char>(len[i]);
+        unsigned cs = total % 256;
+
+        char* p = buf_ + pos_;
+        p[0] = '1';
+        p[1] = '0';
+        p[2] = '=';
+        p[3] = static_cast<char>('0' + cs / 100);
+        p[4] = static_cast<char>('0' + cs / 10 % 10);
+        p[5] = static_cast<char>('0' + cs % 10);
+        p[6] = '\x01';
+        pos_ += 7;
+
+        return std::string_view(start, static_cast<size_t>(buf_ + pos_ - start));
+    }
+
+    bool overflow() const {
+        return overflow_;
+    }
+
+private:
+    bool reserve(size_t n) {
+        if (overflow_ || pos_ + n > CAPACITY) {
+            overflow_ = true;
+            return false;
+        }
+        return true;
+    }
+
+    void put(char c) {
+        if (!reserve(1)) return;
+        buf_[pos_++] = c;
+        sum_ += static_cast<unsigned char>(c);
+    }
+
+    void bytes(std::string_view v) {
+        if (!reserve(v.size())) return;
+        for (size_t i = 0; i < v.size(); ++i) {
+            buf_[pos_ + i] = v[i];
+            sum_ += static_cast<unsigned char>(v[i]);
+        }
+        pos_ += v.size();
+    }
+
+    void integer(int64_t v) {
+        char tmp[24];
+        char* end = std::to_chars(tmp, tmp + sizeof(tmp), v).ptr;
+        bytes(std::string_view(tmp, static_cast<size_t>(end - tmp)));
+    }
+
+    void tag(uint32_t t) {
+        integer(t);
+        put('=');
+    }
+
+    const FixMsgTemplate* tmpl_;
+    size_t pos_;
+    uint32_t sum_;
+    bool overflow_;
+    char buf_[CAPACITY];
+};
+
+} // namespace chimera
@@ -0,0 +1,160 @@
+#pragma once
+
+// ChimeraMetals
+// FixExecIdWindow.hpp - Fixed-capacity ExecID deduplication window
+//
+// Remembers the last `capacity` ExecIDs (optionally also bounded by age) in
+// tables allocated once at construction. Each ExecID is hashed to 64 bits
+// and placed in one of PROBE consecutive slots from its home slot. Probing
+// reads only the 16-byte hash/generation tags (PROBE of them are four cache
+// lines); a hash hit is then confirmed against the stored bytes, so no two
+// ids are ever confused. Every insert takes the next generation number; an
+// entry is live while it is among the last `capacity` generations and
+// younger than max_age_ns. Expired slots are simply reused, so eviction
+// costs nothing and clear() is a generation bump.
+//
+// There are 4x capacity slots. When all PROBE slots around a home slot are
+// live the oldest of them is pushed out early; forcedEvictions() counts
+// those (about one in 2M inserts in bench_fix_execid).
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+
+namespace chimera {
+
+class FixExecIdWindow {
+public:
+    static const size_t DEFAULT_CAPACITY = 8192;
+    static const int64_t DEFAULT_MAX_AGE_NS = 24LL * 3600 * 1000000000LL;
+    static const size_t PROBE = 16;
+    static const size_t INLINE_ID_BYTES = 55;      // longer ids compare this prefix + hash + length
+
+    explicit FixExecIdWindow(size_t capacity = DEFAULT_CAPACITY, int64_t max_age_ns = DEFAULT_MAX_AGE_NS)
+        : capacity_(capacity ? capacity : 1),
+          max_age_ns_(max_age_ns),
+          mask_(tableSize(capacity_) - 1),
+          tags_(new Tag[mask_ + 1]),
+          entries_(new Entry[mask_ + 1]),
+          next_gen_(capacity_ + 1),     // generations 0..capacity_ never look live
+          forced_evictions_(0)
+    {
+        std::memset(tags_.get(), 0, sizeof(Tag) * (mask_ + 1));
+        std::memset(entries_.get(), 0, sizeof(Entry) * (mask_ + 1));
+    }
+
+    FixExecIdWindow(const FixExecIdWindow&) = delete;
+    FixExecIdWindow& operator=(const FixExecIdWindow&) = delete;
+
+    bool contains(std::string_view id, int64_t now_ns) const {
+        return find(id, hashId(id), now_ns) != NPOS;
+    }
+
+    // Adds id; false if it was already in the window
+    bool insert(std::string_view id, int64_t now_ns) {
+        uint64_t h = hashId(id);
+        if (find(id, h, now_ns) != NPOS) return false;
+
+        size_t home = static_cast<size_t>(h) & mask_;
+        size_t victim = NPOS;
+        for (size_t i = 0; i < PROBE; ++i) {
+            size_t slot = (home + i) & mask_;
+            if (!inWindow(tags_[slot])) {
+                victim = slot;
+                break;
+            }
+            if (victim == NPOS || tags_[slot].gen < tags_[victim].gen) victim = slot;
+        }
+        if (inWindow(tags_[victim]) && young(entries_[victim], now_ns)) ++forced_evictions_;
+
+        tags_[victim].hash = h;
+        tags_[victim].gen = next_gen_++;
+        Entry& e = entries_[victim];
+        e.time_ns = now_ns;
+        e.len = static_cast<uint8_t>(id.size() < 255 ? id.size() : 255);
+        std::memcpy(e.id, id.data(), id.size() < INLINE_ID_BYTES ? id.size() : INLINE_ID_BYTES);
+        return true;
+    }
+
+    bool erase(std::string_view id) {
+        size_t slot = find(id, hashId(id), INT64_MIN);
+        if (slot == NPOS) return false;
+        tags_[slot].gen = 0;
+        return true;
+    }
+
+    // Forgets everything in O(1)
+    void clear() {
+        next_gen_ += capacity_;
+    }
+
+    size_t capacity() const { return capacity_; }
+    uint64_t forcedEvictions() const { return forced_evictions_; }
+
+private:
+    static const size_t NPOS = static_cast<size_t>(-1);
+
+    struct Tag {
+        uint64_t hash;
+        uint64_t gen;
+    };
+
+    struct Entry {
+        int64_t time_ns;
+        uint8_t len;
+        char id[INLINE_ID_BYTES];
+    };
+    static_assert(sizeof(Entry) == 64, "one entry per cache line");
+
+    static size_t tableSize(size_t capacity) {
+        size_t n = PROBE;
+        while (n < capacity * 4) n <<= 1;
+        return n;
+    }
+
+    // FNV-1a, finished with a multiply-xorshift so short numeric ids spread
+    static uint64_t hashId(std::string_view id) {
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (unsigned char c : id) {
+            h ^= c;
+            h *= 0x100000001b3ull;
+        }
+        h ^= h >> 32;
+        h *= 0xd6e8feb86659fd93ull;
+        h ^= h >> 32;
+        return h;
+    }
+
+    bool inWindow(const Tag& t) const {
+        return t.gen + capacity_ >= next_gen_;
+    }
+
+    // now_ns == INT64_MIN skips the age check
+    bool young(const Entry& e, int64_t now_ns) const {
+        return now_ns == INT64_MIN || max_age_ns_ <= 0 || now_ns - e.time_ns <= max_age_ns_;
+    }
+
+    size_t find(std::string_view id, uint64_t h, int64_t now_ns) const {
+        size_t home = static_cast<size_t>(h) & mask_;
+        size_t len = id.size() < 255 ? id.size() : 255;
+        size_t cmp = id.size() < INLINE_ID_BYTES ? id.size() : INLINE_ID_BYTES;
+        for (size_t i = 0; i < PROBE; ++i) {
+            size_t slot = (home + i) & mask_;
+            if (tags_[slot].hash != h || !inWindow(tags_[slot])) continue;
+            const Entry& e = entries_[slot];
+            if (e.len == len && young(e, now_ns) && std::memcmp(e.id, id.data(), cmp) == 0) return slot;
+        }
+        return NPOS;
+    }
+
+    size_t capacity_;
+    int64_t max_age_ns_;
+    size_t mask_;
+    std::unique_ptr<Tag[]> tags_;
+    std::unique_ptr<Entry[]> entries_;
+    uint64_t next_gen_;
+    uint64_t forced_evictions_;
+};
+
+} // namespace chimera
@@ -0,0 +1,131 @@
+#pragma once
+
+// ChimeraMetals
+// FixGapBuffer.hpp - Sequence-indexed holding ring for inbound messages that
+// arrive ahead of a gap
+//
+// While a ResendRequest is outstanding, every message above the hole is
+// copied here instead of being dropped and re-requested. Slots are indexed
+// by seq % slots, so placing and finding a message is one array access;
+// the bytes go into an arena that is rewound whenever the buffer empties.
+// Both are allocated once. pop() hands the held messages back strictly in
+// sequence as the resends fill the hole.
+//
+// A slot may hold a seq with no bytes: the caller has already handled that
+// message (the Logon that revealed the gap) and only the sequence is kept.
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+
+namespace chimera {
+
+class FixGapBuffer {
+public:
+    static const size_t DEFAULT_SLOTS = 16384;
+    static const size_t DEFAULT_ARENA_BYTES = 8u << 20;
+
+    explicit FixGapBuffer(size_t slots = DEFAULT_SLOTS, size_t arena_bytes = DEFAULT_ARENA_BYTES)
+        : mask_(roundUp(slots) - 1),
+          slots_(new Slot[mask_ + 1]),
+          arena_(new char[arena_bytes]),
+          arena_bytes_(arena_bytes),
+          used_(0),
+          depth_(0),
+          highest_(0)
+    {
+        std::memset(slots_.get(), 0, sizeof(Slot) * (mask_ + 1));
+    }
+
+    FixGapBuffer(const FixGapBuffer&) = delete;
+    FixGapBuffer& operator=(const FixGapBuffer&) = delete;
+
+    // Copies msg in under seq, which must be above expected and within
+    // window() of it. False if it does not fit (window or arena exhausted);
+    // a seq already held is kept once and reported as held.
+    bool hold(int64_t expected, int64_t seq, std::string_view msg) {
+        if (seq <= expected || static_cast<uint64_t>(seq - expected) > mask_) return false;
+        Slot& s = slots_[static_cast<size_t>(seq) & mask_];
+        if (s.seq == seq) return true;
+        if (msg.size() > arena_bytes_ - used_) return false;
+
+        std::memcpy(arena_.get() + used_, msg.data(), msg.size());
+        s.seq = seq;
+        s.offset = static_cast<uint32_t>(used_);
+        s.len = static_cast<uint32_t>(msg.size());
+        used_ += msg.size();
+        ++depth_;
+        if (seq > highest_) highest_ = seq;
+        return true;
+    }
+
+    bool has(int64_t seq) const {
+        return seq > 0 && slots_[static_cast<size_t>(seq) & mask_].seq == seq;
+    }
+
+    // Takes out seq if held. msg is empty for a sequence-only entry and is
+    // valid until the next hold().
+    bool pop(int64_t seq, std::string_view& msg) {
+        Slot& s = slots_[static_cast<size_t>(seq) & mask_];
+        if (seq <= 0 || s.seq != seq) return false;
+        msg = std::string_view(arena_.get() + s.offset, s.len);
+        s.seq = 0;
+        release();
+        return true;
+    }
+
+    // Drops everything below seq, e.g. after a SequenceReset moved past it
+    void discardBelow(int64_t seq) {
+        if (depth_ == 0) return;
+        for (size_t i = 0; i <= mask_; ++i) {
+            if (slots_[i].seq != 0 && slots_[i].seq < seq) {
+                slots_[i].seq = 0;
+                release();
+            }
+        }
+    }
+
+    void clear() {
+        if (depth_ != 0) std::memset(slots_.get(), 0, sizeof(Slot) * (mask_ + 1));
+        depth_ = 0;
+        used_ = 0;
+        highest_ = 0;
+    }
+
+    size_t depth() const { return depth_; }
+    bool empty() const { return depth_ == 0; }
+    int64_t highest() const { return highest_; }       // 0 when empty
+    size_t window() const { return mask_; }
+    size_t arenaUsed() const { return used_; }
+
+private:
+    struct Slot {
+        int64_t seq;        // 0 = free
+        uint32_t offset;
+        uint32_t len;
+    };
+
+    static size_t roundUp(size_t n) {
+        size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    void release() {
+        if (--depth_ == 0) {
+            used_ = 0;      // the bytes stay readable until the next hold()
+            highest_ = 0;
+        }
+    }
+
+    size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    std::unique_ptr<char[]> arena_;
+    size_t arena_bytes_;
+    size_t used_;
+    size_t depth_;
+    int64_t highest_;
+};
+
+} // namespace chimera
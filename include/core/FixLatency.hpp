@@ -0,0 +1,178 @@
+#pragma once
+
+// ChimeraMetals
+// FixLatency.hpp - Broker-to-us feed latency from SendingTime (52)
+//
+// one-way = local receive time - SendingTime, measured against two different
+// clocks, so it carries the broker's clock offset. Samples go into a
+// log-linear histogram (16 sub-buckets per power of two, ~6% resolution,
+// signed so a broker clock running ahead still records). The minimum one-way
+// over the last OFFSET_WINDOW samples is the clock offset estimate: it equals
+// offset + the fastest path seen, i.e. an upper bound on how far the broker
+// clock is behind ours.
+//
+// Single writer (the session's read thread); counters are relaxed atomics so
+// telemetry and the dashboard can read percentiles from other threads.
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#include "FixTime.hpp"
+
+namespace chimera {
+
+class FixLatencyHistogram {
+public:
+    static const int SUB_BITS = 4;
+    static const int SUB_BUCKETS = 1 << SUB_BITS;
+    static const int MAX_EXPONENT = 40;     // up to 2^41 ns, ~36 minutes
+    static const int BUCKETS = (MAX_EXPONENT - SUB_BITS + 2) * SUB_BUCKETS;
+
+    FixLatencyHistogram() {
+        reset();
+    }
+
+    void record(int64_t ns) {
+        std::atomic<uint64_t>* side = ns < 0 ? neg_ : pos_;
+        uint64_t mag = ns < 0 ? static_cast<uint64_t>(-(ns + 1)) + 1 : static_cast<uint64_t>(ns);
+        std::atomic<uint64_t>& b = side[bucketOf(mag)];
+        b.store(b.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    // Value at quantile q in [0, 1], mid-point of its bucket; 0 when empty
+    int64_t percentile(double q) const {
+        uint64_t total = count();
+        if (total == 0) return 0;
+        uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+
+        uint64_t seen = 0;
+        for (int i = BUCKETS - 1; i >= 0; --i) {
+            seen += neg_[i].load(std::memory_order_relaxed);
+            if (seen >= rank) return -static_cast<int64_t>(midpoint(i));
+        }
+        for (int i = 0; i < BUCKETS; ++i) {
+            seen += pos_[i].load(std::memory_order_relaxed);
+            if (seen >= rank) return static_cast<int64_t>(midpoint(i));
+        }
+        return static_cast<int64_t>(midpoint(BUCKETS - 1));
+    }
+
+    void reset() {
+        for (int i = 0; i < BUCKETS; ++i) {
+            neg_[i].store(0, std::memory_order_relaxed);
+            pos_[i].store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static int bucketOf(uint64_t v) {
+        if (v < SUB_BUCKETS) return static_cast<int>(v);
+        int e = 63 - std::countl_zero(v);
+        if (e > MAX_EXPONENT) return BUCKETS - 1;
+        int sub = static_cast<int>((v >> (e - SUB_BITS)) & (SUB_BUCKETS - 1));
+        return (e - SUB_BITS + 1) * SUB_BUCKETS + sub;
+    }
+
+    static uint64_t midpoint(int i) {
+        if (i < SUB_BUCKETS) return static_cast<uint64_t>(i);
+        int e = i / SUB_BUCKETS + SUB_BITS - 1;
+        uint64_t sub = static_cast<uint64_t>(i % SUB_BUCKETS);
+        uint64_t width = 1ULL << (e - SUB_BITS);
+        return (1ULL << e) + sub * width + width / 2;
+    }
+
+    std::atomic<uint64_t> neg_[BUCKETS];
+    std::atomic<uint64_t> pos_[BUCKETS];
+    std::atomic<uint64_t> count_;
+};
+
+class FixFeedLatency {
+public:
+    static const uint32_t OFFSET_WINDOW = 1024;
+
+    FixFeedLatency()
+        : last_ns_(0),
+          offset_ns_(0),
+          window_min_(std::numeric_limits<int64_t>::max()),
+          window_count_(0),
+          first_window_(true)
+    {}
+
+    // sending_ns is SendingTime truncated to frac_digits; the sample is taken
+    // from the middle of that unit so second-precision senders are not biased
+    // by half a second.
+    void record(int64_t sending_ns, int frac_digits, int64_t recv_ns) {
+        static const int64_t HALF_UNIT[10] = {500000000LL, 0, 0, 500000LL, 0, 0, 500LL, 0, 0, 0};
+        int64_t one_way = recv_ns - (sending_ns + HALF_UNIT[frac_digits]);
+
+        hist_.record(one_way);
+        last_ns_.store(one_way, std::memory_order_relaxed);
+
+        // The first window publishes its running minimum; later ones on completion
+        if (one_way < window_min_) window_min_ = one_way;
+        if (first_window_) offset_ns_.store(window_min_, std::memory_order_relaxed);
+        if (++window_count_ == OFFSET_WINDOW) {
+            offset_ns_.store(window_min_, std::memory_order_relaxed);
+            window_min_ = std::numeric_limits<int64_t>::max();
+            window_count_ = 0;
+            first_window_ = false;
+        }
+    }
+
+    // Parses 52= and records it; false if the timestamp is malformed
+    bool record(std::string_view sending_time, int64_t recv_ns) {
+        int64_t sending_ns = 0;
+        int frac_digits = 0;
+        if (!parseFixUtcTimestamp(sending_time, sending_ns, &frac_digits)) return false;
+        record(sending_ns, frac_digits, recv_ns);
+        return true;
+    }
+
+    uint64_t count() const {
+        return hist_.count();
+    }
+
+    int64_t lastNs() const {
+        return last_ns_.load(std::memory_order_relaxed);
+    }
+
+    int64_t percentileNs(double q) const {
+        return hist_.percentile(q);
+    }
+
+    double percentileMs(double q) const {
+        return static_cast<double>(hist_.percentile(q)) / 1e6;
+    }
+
+    int64_t clockOffsetNs() const {
+        return offset_ns_.load(std::memory_order_relaxed);
+    }
+
+    void reset() {
+        hist_.reset();
+        last_ns_.store(0, std::memory_order_relaxed);
+        offset_ns_.store(0, std::memory_order_relaxed);
+        first_window_ = true;
+        window_min_ = std::numeric_limits<int64_t>::max();
+        window_count_ = 0;
+    }
+
+private:
+    FixLatencyHistogram hist_;
+    std::atomic<int64_t> last_ns_;
+    std::atomic<int64_t> offset_ns_;
+    int64_t window_min_;
+    uint32_t window_count_;
+    bool first_window_;
+};
+
+} // namespace chimera
@@ -0,0 +1,251 @@
+#pragma once
+
+// ChimeraMetals
+// FixMdDecoder.hpp - NoMDEntries (268) repeating-group decoder for 35=W / 35=X
+//
+// One message decodes into one FixMdBatch of typed entries. The group's
+// delimiter is the first tag after 268 (279 on cTrader incrementals, 269 on
+// snapshots); each repeat of it opens a new entry. Per entry:
+//   279 MDUpdateAction  269 MDEntryType  270 MDEntryPx
+//   271 MDEntrySize     278 MDEntryID    55  Symbol (falls back to the header 55)
+// Prices are parsed at the entry symbol's precision once the entry is
+// complete, so 55 may follow 270; decimals beyond it (or beyond
+// FIX_SIZE_DIGITS in 271) are rounded, not rejected. Entries with a bad
+// number are dropped and counted; the rest of the batch still applies.
+
+#include <cstdint>
+#include <string_view>
+
+#include "FixNumeric.hpp"
+#include "FixTagIndex.hpp"
+
+namespace chimera {
+
+enum class FixMdAction : uint8_t {
+    New = 0,
+    Change = 1,
+    Delete = 2
+};
+
+// MDEntrySize is carried at two decimals: "1.5" -> 150
+constexpr int FIX_SIZE_DIGITS = 2;
+
+struct FixMdEntry {
+    std::string_view symbol;    // 55, per entry or from the header
+    int64_t symbol_id;          // numeric cTrader id, -1 when 55 is a name
+    std::string_view entry_id;  // 278
+    FixMdAction action;         // 279, New on snapshots
+    char type;                  // 269: '0' bid, '1' offer, '2' trade
+    bool has_price;
+    bool has_size;
+    FixPrice price;             // 270 at the symbol's precision
+    int64_t size;               // 271 at FIX_SIZE_DIGITS
+};
+
+// Best bid / offer per symbol after collapsing a batch
+struct FixMdTop {
+    std::string_view symbol;
+    int64_t symbol_id;
+    bool has_bid;
+    bool has_ask;
+    FixPrice bid;
+    FixPrice ask;
+    int64_t bid_size;           // 271 of the best entry, FIX_SIZE_DIGITS; 0 if absent
+    int64_t ask_size;
+};
+
+class FixMdBatch {
+public:
+    static const size_t MAX_ENTRIES = 256;
+
+    FixMdBatch()
+        : count_(0),
+          declared_(0),
+          errors_(0),
+          snapshot_(false),
+          truncated_(false)
+    {}
+
+    void clear() {
+        count_ = 0;
+        declared_ = 0;
+        errors_ = 0;
+        snapshot_ = false;
+        truncated_ = false;
+    }
+
+    bool snapshot() const { return snapshot_; }
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    const FixMdEntry& operator[](size_t i) const { return entries_[i]; }
+    const FixMdEntry* begin() const { return entries_; }
+    const FixMdEntry* end() const { return entries_ + count_; }
+
+    // 268 as sent; differs from size() when entries were dropped or truncated
+    size_t declared() const { return declared_; }
+    // Entries dropped for an unparseable 279/270/271
+    size_t errors() const { return errors_; }
+    // More than MAX_ENTRIES entries in one message
+    bool truncated() const { return truncated_; }
+
+    // Collapse New/Change bid and offer entries into one best price per
+    // symbol. Returns the number of symbols written to out.
+    size_t tops(FixMdTop* out, size_t max) const {
+        size_t n = 0;
+        for (size_t i = 0; i < count_; ++i) {
+            const FixMdEntry& e = entries_[i];
+            if (!e.has_price || e.action == FixMdAction::Delete) continue;
+            if (e.type != '0' && e.type != '1') continue;
+
+            size_t s = 0;
+            while (s < n && !sameSymbol(out[s], e)) ++s;
+            if (s == n) {
+                if (n == max) continue;
+                out[n] = FixMdTop{e.symbol, e.symbol_id, false, false, FixPrice{}, FixPrice{}, 0, 0};
+                ++n;
+            }
+
+            FixMdTop& t = out[s];
+            int64_t size = e.has_size ? e.size : 0;
+            if (e.type == '0') {
+                if (!t.has_bid || e.price.ticks > t.bid.ticks) {
+                    t.bid = e.price;
+                    t.bid_size = size;
+                }
+                t.has_bid = true;
+            } else {
+                if (!t.has_ask || e.price.ticks < t.ask.ticks) {
+                    t.ask = e.price;
+                    t.ask_size = size;
+                }
+                t.has_ask = true;
+            }
+        }
+        return n;
+    }
+
+private:
+    friend class FixMdDecoder;
+
+    static bool sameSymbol(const FixMdTop& t, const FixMdEntry& e) {
+        if (e.symbol_id >= 0) return t.symbol_id == e.symbol_id;
+        return t.symbol_id < 0 && t.symbol == e.symbol;
+    }
+
+    FixMdEntry entries_[MAX_ENTRIES];
+    size_t count_;
+    size_t declared_;
+    size_t errors_;
+    bool snapshot_;
+    bool truncated_;
+};
+
+class FixMdDecoder {
+public:
+    // Decode the 268 group of a parsed 35=W or 35=X. Returns false when the
+    // message is neither or carries no well-formed 268.
+    static bool decode(const FixTagIndex& idx, const FixPricePrecision& precision, FixMdBatch& out) {
+        out.clear();
+
+        std::string_view type = idx.get(35);
+        if (type != "W" && type != "X") return false;
+        out.snapshot_ = (type == "W");
+
+        size_t start = idx.position(268);
+        if (start == FixTagIndex::NPOS) return false;
+        int64_t declared = 0;
+        if (parseFixInt(idx.value(start), declared) != FixNumError::None || declared < 0) return false;
+        out.declared_ = static_cast<size_t>(declared);
+
+        // A 55 ahead of the group is the message-level symbol (35=W)
+        std::string_view header_symbol;
+        size_t sym_pos = idx.position(55);
+        if (sym_pos != FixTagIndex::NPOS && sym_pos < start) header_symbol = idx.value(sym_pos);
+
+        Pending cur;
+        bool open = false;
+        uint32_t delim = 0;
+
+        for (size_t i = start + 1; i < idx.fieldCount(); ++i) {
+            uint32_t tag = idx.field(i).tag;
+            if (tag == 10) break;
+            if (delim == 0) delim = tag;
+
+            if (tag == delim) {
+                if (open) finish(cur, precision, out);
+                cur = Pending();
+                cur.symbol = header_symbol;
+                open = true;
+            }
+            if (!open) continue;
+
+            std::string_view v = idx.value(i);
+            switch (tag) {
+                case 279: cur.action = v; break;
+                case 269: cur.type = v.empty() ? '\0' : v[0]; break;
+                case 270: cur.price = v; break;
+                case 271: cur.size = v; break;
+                case 278: cur.entry_id = v; break;
+                case 55: cur.symbol = v; break;
+                default: break;
+            }
+        }
+        if (open) finish(cur, precision, out);
+
+        return true;
+    }
+
+private:
+    struct Pending {
+        std::string_view symbol;
+        std::string_view entry_id;
+        std::string_view action;
+        std::string_view price;
+        std::string_view size;
+        char type = '\0';
+    };
+
+    static void finish(const Pending& p, const FixPricePrecision& precision, FixMdBatch& out) {
+        if (out.count_ == FixMdBatch::MAX_ENTRIES) {
+            out.truncated_ = true;
+            return;
+        }
+
+        FixMdEntry& e = out.entries_[out.count_];
+        e.symbol = p.symbol;
+        e.entry_id = p.entry_id;
+        e.type = p.type;
+
+        if (p.symbol.empty() || parseFixInt(p.symbol, e.symbol_id) != FixNumError::None) {
+            e.symbol_id = -1;
+        }
+
+        e.action = FixMdAction::New;
+        if (!p.action.empty()) {
+            int a = 0;
+            if (parseFixInt(p.action, a) != FixNumError::None || a < 0 || a > 2) {
+                ++out.errors_;
+                return;
+            }
+            e.action = static_cast<FixMdAction>(a);
+        }
+
+        e.has_price = !p.price.empty();
+        e.price = FixPrice();
+        if (e.has_price && parseFixPriceRounded(p.price, precision.digits(e.symbol_id), e.price) != FixNumError::None) {
+            ++out.errors_;
+            return;
+        }
+
+        e.has_size = !p.size.empty();
+        e.size = 0;
+        if (e.has_size && parseFixPriceRounded(p.size, FIX_SIZE_DIGITS, e.size) != FixNumError::None) {
+            ++out.errors_;
+            return;
+        }
+
+        ++out.count_;
+    }
+};
+
+} // namespace chimera
@@ -0,0 +1,387 @@
+#pragma once
+
+// ChimeraMetals
+// FixMessageStore.hpp - Memory-mapped outbound message store for ResendRequest
+//
+// One file per FIX session, mapped shared: a header with the sequence numbers,
+// an index of one 32-byte slot per MsgSeqNum (seq % slots) and a ring of
+// message bytes. append() is two memcpys into the mapping; the page cache
+// carries them to disk, so a process crash loses nothing and the send path
+// never waits on fsync (flush() is there for a clean shutdown). open() maps
+// the file and trusts the header, so recovery is a few page faults however
+// much history the file holds.
+//
+// A message stays retrievable until the ring has wrapped over its bytes or
+// its index slot has been reused by seq + slots. reset() starts a new epoch,
+// which hides every older message without touching the file.
+//
+// replay() answers a ResendRequest: application messages are re-sent with
+// PossDupFlag (43=Y), a fresh SendingTime and OrigSendingTime (122) set to
+// the original 52, BodyLength and CheckSum recomputed; admin messages and
+// anything no longer held collapse into one SequenceReset-GapFill per run.
+
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "platform/platform.hpp"
+
+#include "FixDispatch.hpp"
+#include "FixEncoder.hpp"
+#include "FixNumeric.hpp"
+#include "FixSimd.hpp"
+#include "FixTime.hpp"
+
+namespace chimera {
+
+struct FixReplayStats {
+    uint32_t resent = 0;            // application messages re-sent with 43=Y
+    uint32_t gap_fills = 0;         // SequenceReset-GapFill messages sent
+};
+
+class FixMessageStore {
+public:
+    static const uint64_t DEFAULT_INDEX_SLOTS = 1ull << 18;    // 8 MB of index
+    static const uint64_t DEFAULT_DATA_BYTES = 64ull << 20;     // message ring
+    static const size_t MAX_MESSAGE = FixEncoder::CAPACITY;
+
+    FixMessageStore()
+        : hdr_(nullptr),
+          index_(nullptr),
+          data_(nullptr)
+    {}
+
+    ~FixMessageStore() {
+        close();
+    }
+
+    FixMessageStore(const FixMessageStore&) = delete;
+    FixMessageStore& operator=(const FixMessageStore&) = delete;
+
+    // Maps path, creating it if needed. An existing store with the same
+    // geometry keeps its messages; a different geometry keeps only the
+    // sequence numbers.
+    bool open(const std::string& path,
+              uint64_t index_slots = DEFAULT_INDEX_SLOTS,
+              uint64_t data_bytes = DEFAULT_DATA_BYTES)
+    {
+        std::lock_guard<std::mutex> lg(mtx_);
+        closeLocked();
+        if (index_slots == 0 || data_bytes < MAX_MESSAGE) return false;
+
+        uint64_t size = HEADER_BYTES + index_slots * sizeof(Entry) + data_bytes;
+        if (!plat::map_file(path.c_str(), size, file_)) return false;
+
+        char* base = static_cast<char*>(file_.data);
+        hdr_ = reinterpret_cast<Header*>(base);
+        index_ = reinterpret_cast<Entry*>(base + HEADER_BYTES);
+        data_ = base + HEADER_BYTES + index_slots * sizeof(Entry);
+
+        bool known = std::memcmp(hdr_->magic, MAGIC, sizeof(hdr_->magic)) == 0 && hdr_->version == VERSION;
+        if (known && hdr_->index_slots == index_slots && hdr_->data_bytes == data_bytes) {
+            rollForward();
+            return true;
+        }
+
+        int64_t next_out = known ? hdr_->next_out_seq : 1;
+        int64_t next_in = known ? hdr_->next_in_seq : 1;
+        uint32_t epoch = known ? hdr_->epoch + 1 : 1;
+        std::memset(hdr_, 0, sizeof(Header));
+        hdr_->version = VERSION;
+        hdr_->index_slots = index_slots;
+        hdr_->data_bytes = data_bytes;
+        hdr_->epoch = epoch;            // slots written under the old geometry never match
+        hdr_->next_out_seq = next_out;
+        hdr_->next_in_seq = next_in;
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(hdr_->magic, MAGIC, sizeof(hdr_->magic));
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lg(mtx_);
+        closeLocked();
+    }
+
+    bool isOpen() const {
+        return hdr_ != nullptr;
+    }
+
+    // Records an outbound message under its own MsgSeqNum (34). Admin types
+    // are only marked; replay turns them into gap fills.
+    bool append(std::string_view msg) {
+        if (!isOpen()) return false;
+        int64_t seq = 0;
+        if (parseFixInt(headerField(msg, "\x01" "34="), seq) != FixNumError::None) return false;
+        return append(seq, msg, isAdmin(fixHeaderMsgType(msg)));
+    }
+
+    bool append(int64_t seq, std::string_view msg, bool admin) {
+        if (seq <= 0 || msg.size() > MAX_MESSAGE) return false;
+        std::lock_guard<std::mutex> lg(mtx_);
+        if (!hdr_) return false;
+
+        // Admin messages keep no bytes: nothing of them is ever re-sent
+        uint64_t len = admin ? 0 : msg.size();
+        uint64_t pos = hdr_->head;
+        if (pos % hdr_->data_bytes + len > hdr_->data_bytes) {
+            pos += hdr_->data_bytes - pos % hdr_->data_bytes;   // keep each message contiguous
+        }
+        if (len) std::memcpy(data_ + pos % hdr_->data_bytes, msg.data(), len);
+
+        // Bytes, then the slot, then the header: a crash part way through
+        // leaves at worst a message that rollForward() or replay() skips
+        Entry& e = slot(seq);
+        e.seq = 0;
+        std::atomic_thread_fence(std::memory_order_release);
+        e.pos = pos;
+        e.len = static_cast<uint32_t>(len);
+        e.epoch = hdr_->epoch;
+        e.flags = admin ? FLAG_ADMIN : 0;
+        std::atomic_thread_fence(std::memory_order_release);
+        e.seq = seq;
+        std::atomic_thread_fence(std::memory_order_release);
+        hdr_->head = pos + len;
+        if (seq >= hdr_->next_out_seq) hdr_->next_out_seq = seq + 1;
+        return true;
+    }
+
+    // Forgets every message; the next outbound seq becomes next_out_seq
+    void reset(int64_t next_out_seq = 1, int64_t next_in_seq = 1) {
+        std::lock_guard<std::mutex> lg(mtx_);
+        if (!hdr_) return;
+        ++hdr_->epoch;
+        hdr_->next_out_seq = next_out_seq;
+        hdr_->next_in_seq = next_in_seq;
+    }
+
+    int64_t nextOutSeq() const {
+        std::lock_guard<std::mutex> lg(mtx_);
+        return hdr_ ? hdr_->next_out_seq : 1;
+    }
+
+    int64_t nextInSeq() const {
+        std::lock_guard<std::mutex> lg(mtx_);
+        return hdr_ ? hdr_->next_in_seq : 1;
+    }
+
+    void setNextOutSeq(int64_t seq) {
+        std::lock_guard<std::mutex> lg(mtx_);
+        if (hdr_) hdr_->next_out_seq = seq;
+    }
+
+    void setNextInSeq(int64_t seq) {
+        std::lock_guard<std::mutex> lg(mtx_);
+        if (hdr_) hdr_->next_in_seq = seq;
+    }
+
+    // The stored bytes of seq, valid until the next append(); false for
+    // admin messages and for anything no longer held
+    bool get(int64_t seq, std::string_view& msg) const {
+        std::lock_guard<std::mutex> lg(mtx_);
+        return lookup(seq, msg) == Held::Message;
+    }
+
+    // Starts writing dirty pages back; wait blocks until they are on disk
+    bool flush(bool wait) {
+        std::lock_guard<std::mutex> lg(mtx_);
+        return hdr_ && plat::flush_file(file_, wait);
+    }
+
+    // Re-sends [begin, end] (end 0 = everything sent so far) through
+    // sink(std::string_view) -> bool, stopping if the sink fails.
+    // gap_fill is gapFillTemplate(ids) for this session; enc builds the gap
+    // fills and may be the session's own encoder.
+    template <typename Sink>
+    FixReplayStats replay(int64_t begin, int64_t end, FixEncoder& enc,
+                          const FixMsgTemplate& gap_fill, Sink&& sink)
+    {
+        FixReplayStats stats;
+        std::lock_guard<std::mutex> lg(mtx_);
+        if (!hdr_) return stats;
+
+        int64_t last = hdr_->next_out_seq - 1;
+        if (begin < 1) begin = 1;
+        if (end <= 0 || end > last) end = last;
+
+        int64_t gap_begin = 0;
+        for (int64_t seq = begin; seq <= end; ++seq) {
+            std::string_view stored;
+            std::string_view resend;
+            if (lookup(seq, stored) == Held::Message) resend = rewritePossDup(stored);
+            if (resend.empty()) {
+                if (!gap_begin) gap_begin = seq;
+                continue;
+            }
+            if (gap_begin) {
+                if (!sink(buildGapFill(enc, gap_fill, gap_begin, seq))) return stats;
+                ++stats.gap_fills;
+                gap_begin = 0;
+            }
+            if (!sink(resend)) return stats;
+            ++stats.resent;
+        }
+        if (gap_begin) {
+            if (sink(buildGapFill(enc, gap_fill, gap_begin, end + 1))) ++stats.gap_fills;
+        }
+        return stats;
+    }
+
+    // SequenceReset (35=4) with GapFillFlag and PossDupFlag pre-rendered
+    static FixMsgTemplate gapFillTemplate(const FixSessionIds& ids) {
+        return FixMsgTemplate(ids, "4", "43=Y\x01" "123=Y\x01");
+    }
+
+    // Session-level types: never re-sent, always gap-filled
+    static bool isAdmin(std::string_view msg_type) {
+        if (msg_type.size() != 1) return false;
+        switch (msg_type[0]) {
+        case '0': case '1': case '2': case '3': case '4': case '5': case 'A':
+            return true;
+        default:
+            return false;
+        }
+    }
+
+private:
+    static constexpr char MAGIC[8] = {'C', 'H', 'F', 'I', 'X', 'S', 'T', 'R'};
+    static const uint32_t VERSION = 1;
+    static const uint64_t HEADER_BYTES = 4096;
+    static const uint32_t FLAG_ADMIN = 1;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t epoch;             // bumped by reset(); older slots stop matching
+        uint64_t index_slots;
+        uint64_t data_bytes;
+        int64_t next_out_seq;
+        int64_t next_in_seq;
+        uint64_t head;              // ring position after the last message, never wraps
+    };
+    static_assert(sizeof(Header) <= HEADER_BYTES, "header fits its page");
+
+    struct Entry {
+        int64_t seq;                // written last; 0 while the slot is being filled
+        uint64_t pos;               // ring position of the bytes
+        uint32_t len;
+        uint32_t epoch;
+        uint32_t flags;
+        uint32_t reserved;
+    };
+    static_assert(sizeof(Entry) == 32, "two index slots per 64-byte line");
+
+    enum class Held { Nothing, Admin, Message };
+
+    void closeLocked() {
+        if (!hdr_) return;
+        plat::unmap_file(file_);
+        hdr_ = nullptr;
+        index_ = nullptr;
+        data_ = nullptr;
+    }
+
+    Entry& slot(int64_t seq) const {
+        return index_[static_cast<uint64_t>(seq) % hdr_->index_slots];
+    }
+
+    // mtx_ held
+    Held lookup(int64_t seq, std::string_view& msg) const {
+        if (seq <= 0) return Held::Nothing;
+        const Entry& e = slot(seq);
+        if (e.seq != seq || e.epoch != hdr_->epoch) return Held::Nothing;
+        if (e.flags & FLAG_ADMIN) return Held::Admin;
+        if (e.len == 0 || e.len > MAX_MESSAGE) return Held::Nothing;
+        if (e.pos + e.len > hdr_->head || hdr_->head - e.pos > hdr_->data_bytes) {
+            return Held::Nothing;       // the ring has moved past these bytes
+        }
+        msg = std::string_view(data_ + e.pos % hdr_->data_bytes, e.len);
+        return Held::Message;
+    }
+
+    // A crash between a slot and the header leaves next_out_seq one behind
+    void rollForward() {
+        int64_t seq = hdr_->next_out_seq;
+        for (;;) {
+            const Entry& e = slot(seq);
+            if (e.seq != seq || e.epoch != hdr_->epoch) break;
+            if (e.pos + e.len > hdr_->head) hdr_->head = e.pos + e.len;
+            hdr_->next_out_seq = ++seq;
+        }
+    }
+
+    // Value of the first header field named by key ("\x01" "34="), or empty
+    static std::string_view headerField(std::string_view msg, std::string_view key) {
+        size_t p = msg.find(key);
+        if (p == std::string_view::npos) return std::string_view();
+        size_t start = p + key.size();
+        size_t end = msg.find('\x01', start);
+        if (end == std::string_view::npos) return std::string_view();
+        return msg.substr(start, end - start);
+    }
+
+    // stored with "43=Y|52=<now>|122=<original 52>|" in place of its 52,
+    // BodyLength and CheckSum recomputed. Empty if stored is malformed.
+    std::string_view rewritePossDup(std::string_view stored) {
+        size_t body_len_tag = stored.find("\x01" "9=");
+        if (body_len_tag == std::string_view::npos) return std::string_view();
+        size_t body = stored.find('\x01', body_len_tag + 1);
+        size_t st = stored.find("\x01" "52=");
+        if (body == std::string_view::npos || st == std::string_view::npos || st < body) {
+            return std::string_view();
+        }
+        size_t st_end = stored.find('\x01', st + 4);
+        if (st_end == std::string_view::npos || stored.size() < 8) return std::string_view();
+        size_t cs = stored.size() - 8;          // the SOH before "10=nnn|"
+        if (stored.compare(cs, 4, "\x01" "10=") != 0 || cs < st_end) return std::string_view();
+        ++cs;
+        if (stored.find("\x01" "43=", body) < cs) return std::string_view();    // never stored twice
+
+        std::string_view orig = stored.substr(st + 4, st_end - st - 4);
+        int frac = orig.size() > 18 ? static_cast<int>(orig.size() - 18) : 0;
+        char now[FIX_TIMESTAMP_MAX];
+        size_t now_n = formatFixUtcTimestamp(now, fixWallClockNs(), frac);
+
+        // Body: up to 52, the PossDup fields, the rest up to 10=
+        body_.clear();
+        body_.append(stored.data() + body + 1, st + 1 - body - 1);
+        body_.append("43=Y\x01" "52=").append(now, now_n);
+        body_.append("\x01" "122=").append(orig).append("\x01");
+        body_.append(stored.data() + st_end + 1, cs - st_end - 1);
+
+        char len[16];
+        char* len_end = std::to_chars(len, len + sizeof(len), body_.size()).ptr;
+        out_.clear();
+        out_.append(stored.data(), body_len_tag + 3);           // "8=FIX.4.4|9="
+        out_.append(len, static_cast<size_t>(len_end - len)).append("\x01");
+        out_.append(body_);
+
+        unsigned sum = fixChecksum(out_.data(), out_.size());
+        char trailer[7] = {'1', '0', '=',
+                           static_cast<char>('0' + sum / 100),
+                           static_cast<char>('0' + sum / 10 % 10),
+                           static_cast<char>('0' + sum % 10), '\x01'};
+        out_.append(trailer, sizeof(trailer));
+        return out_;
+    }
+
+    static std::string_view buildGapFill(FixEncoder& enc, const FixMsgTemplate& gap_fill,
+                                         int64_t seq, int64_t new_seq)
+    {
+        return enc.begin(gap_fill, seq).body(gap_fill).field(36, new_seq).finish();
+    }
+
+    mutable std::mutex mtx_;
+    plat::mapped_file file_;
+    Header* hdr_;
+    Entry* index_;
+    char* data_;
+    std::string body_;              // replay scratch, reused
+    std::string out_;
+};
+
+} // namespace chimera
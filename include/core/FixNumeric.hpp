@@ -0,0 +1,223 @@
+#pragma once
+
+// ChimeraMetals
+// FixNumeric.hpp - Allocation-free integer and fixed-point parsing for FIX fields
+//
+// Prices are parsed straight from the wire into int64 ticks at the symbol's
+// precision (SymbolDigits, 1008 in the cTrader SecurityList). No substr, no
+// locale, no exceptions: every parser returns a FixNumError and leaves the
+// output untouched on failure. FixPrice::toDouble() is the on-demand view.
+
+#include <cstdint>
+#include <string_view>
+
+#include "FixTagIndex.hpp"
+
+namespace chimera {
+
+enum class FixNumError {
+    None = 0,
+    Empty,          // no digits
+    InvalidChar,    // anything but [-]digits[.digits]
+    Overflow,       // does not fit in int64 at the requested scale
+    Precision       // non-zero digits beyond the symbol's precision
+};
+
+inline const char* fixNumErrorName(FixNumError e) {
+    switch (e) {
+        case FixNumError::None: return "OK";
+        case FixNumError::Empty: return "EMPTY";
+        case FixNumError::InvalidChar: return "INVALID_CHAR";
+        case FixNumError::Overflow: return "OVERFLOW";
+        case FixNumError::Precision: return "PRECISION";
+    }
+    return "UNKNOWN";
+}
+
+constexpr int FIX_MAX_DIGITS = 9;
+
+inline int64_t fixPow10(int digits) {
+    static const int64_t POW10[FIX_MAX_DIGITS + 1] = {
+        1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL,
+        1000000LL, 10000000LL, 100000000LL, 1000000000LL
+    };
+    return POW10[digits];
+}
+
+struct FixPrice {
+    int64_t ticks = 0;
+    int digits = 0;
+
+    double toDouble() const {
+        return static_cast<double>(ticks) / static_cast<double>(fixPow10(digits));
+    }
+};
+
+// Up to 18 decimal digits always fit in int64; only longer inputs need checking
+constexpr size_t FIX_SAFE_DIGITS = 18;
+
+// Signed decimal integer (MsgSeqNum, BodyLength, numeric Symbol ids, qty)
+inline FixNumError parseFixInt(std::string_view s, int64_t& out) {
+    size_t i = 0;
+    bool neg = false;
+    if (!s.empty() && s[0] == '-') {
+        neg = true;
+        i = 1;
+    }
+    if (i == s.size()) return FixNumError::Empty;
+    if (s.size() - i > FIX_SAFE_DIGITS + 1) return FixNumError::Overflow;
+
+    uint64_t v = 0;
+    for (; i < s.size(); ++i) {
+        unsigned d = static_cast<unsigned char>(s[i]) - '0';
+        if (d > 9) return FixNumError::InvalidChar;
+        v = v * 10 + d;
+    }
+    if (v > static_cast<uint64_t>(INT64_MAX)) return FixNumError::Overflow;
+
+    out = neg ? -static_cast<int64_t>(v) : static_cast<int64_t>(v);
+    return FixNumError::None;
+}
+
+inline FixNumError parseFixInt(std::string_view s, int& out) {
+    int64_t v = 0;
+    FixNumError e = parseFixInt(s, v);
+    if (e != FixNumError::None) return e;
+    if (v > INT32_MAX || v < INT32_MIN) return FixNumError::Overflow;
+    out = static_cast<int>(v);
+    return FixNumError::None;
+}
+
+// Decimal -> ticks at `digits` places: "5173.3" at 2 digits -> 517330.
+// Extra fractional digits are accepted only when they are zeros.
+inline FixNumError parseFixPrice(std::string_view s, int digits, int64_t& out) {
+    if (digits < 0 || digits > FIX_MAX_DIGITS) return FixNumError::Precision;
+
+    const char* p = s.data();
+    const char* end = p + s.size();
+    bool neg = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        neg = (*p == '-');
+        ++p;
+    }
+
+    // Integer part
+    uint64_t v = 0;
+    const char* int_start = p;
+    for (; p < end; ++p) {
+        unsigned d = static_cast<unsigned char>(*p) - '0';
+        if (d > 9) break;
+        v = v * 10 + d;
+    }
+    size_t int_digits = static_cast<size_t>(p - int_start);
+    if (int_digits + static_cast<size_t>(digits) > FIX_SAFE_DIGITS) return FixNumError::Overflow;
+
+    // Fraction, scaled to exactly `digits` places
+    int frac = 0;
+    if (p < end) {
+        if (*p != '.') return FixNumError::InvalidChar;
+        ++p;
+        for (; p < end && frac < digits; ++p, ++frac) {
+            unsigned d = static_cast<unsigned char>(*p) - '0';
+            if (d > 9) return FixNumError::InvalidChar;
+            v = v * 10 + d;
+        }
+        for (; p < end; ++p) {
+            unsigned d = static_cast<unsigned char>(*p) - '0';
+            if (d > 9) return FixNumError::InvalidChar;
+            if (d != 0) return FixNumError::Precision;
+        }
+    }
+    if (int_digits == 0 && frac == 0) return FixNumError::Empty;
+
+    v *= static_cast<uint64_t>(fixPow10(digits - frac));
+
+    out = neg ? -static_cast<int64_t>(v) : static_cast<int64_t>(v);
+    return FixNumError::None;
+}
+
+inline FixNumError parseFixPrice(std::string_view s, int digits, FixPrice& out) {
+    int64_t ticks = 0;
+    FixNumError e = parseFixPrice(s, digits, ticks);
+    if (e != FixNumError::None) return e;
+    out.ticks = ticks;
+    out.digits = digits;
+    return FixNumError::None;
+}
+
+// As parseFixPrice, but fractional digits beyond `digits` round the result
+// (half away from zero) instead of failing: "1.2345" at 2 digits -> 123.
+// For feeds that quote finer than the precision the book is kept at.
+inline FixNumError parseFixPriceRounded(std::string_view s, int digits, int64_t& out) {
+    size_t dot = s.find('.');
+    if (dot == std::string_view::npos || digits < 0 || s.size() - dot - 1 <= static_cast<size_t>(digits)) {
+        return parseFixPrice(s, digits, out);
+    }
+    std::string_view extra = s.substr(dot + 1 + static_cast<size_t>(digits));
+    for (char c : extra) {
+        if (static_cast<unsigned>(static_cast<unsigned char>(c) - '0') > 9) return FixNumError::InvalidChar;
+    }
+    int64_t v = 0;
+    FixNumError e = parseFixPrice(s.substr(0, dot + 1 + static_cast<size_t>(digits)), digits, v);
+    if (e != FixNumError::None) return e;
+    if (extra[0] >= '5') v += s[0] == '-' ? -1 : 1;
+    out = v;
+    return FixNumError::None;
+}
+
+inline FixNumError parseFixPriceRounded(std::string_view s, int digits, FixPrice& out) {
+    int64_t ticks = 0;
+    FixNumError e = parseFixPriceRounded(s, digits, ticks);
+    if (e != FixNumError::None) return e;
+    out.ticks = ticks;
+    out.digits = digits;
+    return FixNumError::None;
+}
+
+// Per-symbol price precision, indexed by the numeric cTrader symbol id.
+// Filled from the SecurityList (35=y) NoRelatedSym entries: 55=<id>, 1008=<digits>.
+class FixPricePrecision {
+public:
+    static const uint32_t MAX_SYMBOL_ID = 4096;
+    static const int DEFAULT_DIGITS = 5;
+
+    FixPricePrecision() {
+        for (uint32_t i = 0; i < MAX_SYMBOL_ID; ++i) digits_[i] = DEFAULT_DIGITS;
+    }
+
+    int digits(int64_t symbol_id) const {
+        if (symbol_id < 0 || symbol_id >= MAX_SYMBOL_ID) return DEFAULT_DIGITS;
+        return digits_[symbol_id];
+    }
+
+    void set(int64_t symbol_id, int digits) {
+        if (symbol_id < 0 || symbol_id >= MAX_SYMBOL_ID) return;
+        if (digits < 0 || digits > FIX_MAX_DIGITS) return;
+        digits_[symbol_id] = static_cast<uint8_t>(digits);
+    }
+
+    // Returns the number of symbols whose precision was recorded
+    size_t loadSecurityList(const FixTagIndex& idx) {
+        size_t loaded = 0;
+        int64_t symbol_id = -1;
+        for (size_t i = 0; i < idx.fieldCount(); ++i) {
+            uint32_t tag = idx.field(i).tag;
+            if (tag == 55) {
+                if (parseFixInt(idx.value(i), symbol_id) != FixNumError::None) symbol_id = -1;
+            } else if (tag == 1008 && symbol_id >= 0) {
+                int d = 0;
+                if (parseFixInt(idx.value(i), d) == FixNumError::None) {
+                    set(symbol_id, d);
+                    ++loaded;
+                }
+                symbol_id = -1;
+            }
+        }
+        return loaded;
+    }
+
+private:
+    uint8_t digits_[MAX_SYMBOL_ID];
+};
+
+} // namespace chimera
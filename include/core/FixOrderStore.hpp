@@ -0,0 +1,305 @@
+#pragma once
+
+// ChimeraMetals
+// FixOrderStore.hpp - Slab of order records indexed by integer ClOrdID
+//
+// ClOrdIDs (11) are plain integers handed out in increasing order, and a
+// record lives in slot id % capacity of a slab allocated once, so finding
+// the order an ExecutionReport refers to is one parse of 11 and one array
+// access: no string hashing, no node allocation. Each record is one cache
+// line holding the order's terms, its state and its cumulative fill.
+//
+// Cancels and replaces get ClOrdIDs of their own (41 = the order they act
+// on) and a record of their own, so a 35=8 or 35=9 answering them finds
+// the original through orig_id.
+//
+// State follows OrdStatus (39). Fills (150=F) add LastQty (32) at LastPx
+// (31) to the running quantity and average price, which the broker's CumQty
+// (14) and AvgPx (6) override when present. Filled, Canceled, Replaced and
+// Rejected are final: later reports may still add fills but do not move the
+// state. A slot is reused once its order is final; add() refuses to
+// overwrite one still working.
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "FixNumeric.hpp"
+#include "FixTagIndex.hpp"
+
+namespace chimera {
+
+enum class FixOrdState : uint8_t {
+    Free = 0,
+    PendingNew,
+    New,
+    PartiallyFilled,
+    Filled,
+    PendingCancel,
+    Canceled,
+    PendingReplace,
+    Replaced,
+    Rejected
+};
+
+inline const char* fixOrdStateName(FixOrdState s) {
+    switch (s) {
+        case FixOrdState::Free: return "FREE";
+        case FixOrdState::PendingNew: return "PENDING_NEW";
+        case FixOrdState::New: return "NEW";
+        case FixOrdState::PartiallyFilled: return "PARTIALLY_FILLED";
+        case FixOrdState::Filled: return "FILLED";
+        case FixOrdState::PendingCancel: return "PENDING_CANCEL";
+        case FixOrdState::Canceled: return "CANCELED";
+        case FixOrdState::PendingReplace: return "PENDING_REPLACE";
+        case FixOrdState::Replaced: return "REPLACED";
+        case FixOrdState::Rejected: return "REJECTED";
+    }
+    return "UNKNOWN";
+}
+
+inline bool fixOrdStateFinal(FixOrdState s) {
+    return s == FixOrdState::Filled || s == FixOrdState::Canceled ||
+           s == FixOrdState::Replaced || s == FixOrdState::Rejected;
+}
+
+enum class FixOrdKind : uint8_t {
+    Order,          // 35=D
+    Cancel,         // 35=F, orig_id = the order
+    Replace         // 35=G, orig_id = the order it replaces
+};
+
+// What the sender registers as it sends 35=D / F / G
+struct FixOrderNote {
+    uint64_t id = 0;                // 11
+    uint64_t orig_id = 0;           // 41, Cancel and Replace
+    int64_t qty = 0;                // QTY_DIGITS places
+    int64_t price = 0;              // ticks at digits places, 0 = market
+    uint16_t symbol = 0;
+    uint8_t digits = 0;
+    char side = '1';                // 54
+    FixOrdKind kind = FixOrdKind::Order;
+};
+
+struct alignas(64) FixOrder {
+    static const int QTY_DIGITS = 2;
+
+    uint64_t id;
+    uint64_t orig_id;
+    int64_t qty;
+    int64_t cum_qty;
+    int64_t price;
+    double avg_px;
+    int64_t updated_ns;             // rx time of the last report
+    uint16_t symbol;
+    uint8_t digits;
+    char side;
+    FixOrdState state;
+    FixOrdState prev_state;         // restored when a cancel/replace is rejected
+    FixOrdKind kind;
+
+    double qtyValue() const { return static_cast<double>(qty) / fixPow10(QTY_DIGITS); }
+    double cumQtyValue() const { return static_cast<double>(cum_qty) / fixPow10(QTY_DIGITS); }
+    double leavesQtyValue() const { return static_cast<double>(qty - cum_qty) / fixPow10(QTY_DIGITS); }
+    double priceValue() const { return static_cast<double>(price) / fixPow10(digits); }
+    bool working() const { return state != FixOrdState::Free && !fixOrdStateFinal(state); }
+};
+static_assert(sizeof(FixOrder) == 64, "one order per cache line");
+
+// The fill an ExecutionReport carried, FixOrderStore::onExecutionReport()
+struct FixOrderFill {
+    int64_t qty = 0;                // 0 = the report was not a fill
+    double px = 0.0;
+};
+
+class FixOrderStore {
+public:
+    static const size_t DEFAULT_CAPACITY = 16384;
+
+    explicit FixOrderStore(size_t capacity = DEFAULT_CAPACITY)
+        : mask_(roundUp(capacity) - 1),
+          slab_(new FixOrder[mask_ + 1]),
+          collisions_(0)
+    {
+        std::memset(static_cast<void*>(slab_.get()), 0, sizeof(FixOrder) * (mask_ + 1));
+    }
+
+    FixOrderStore(const FixOrderStore&) = delete;
+    FixOrderStore& operator=(const FixOrderStore&) = delete;
+
+    // Records an order, cancel or replace as sent. Null if the slot still
+    // holds a working order (more than capacity() ids in flight).
+    FixOrder* add(const FixOrderNote& n, int64_t now_ns) {
+        if (n.id == 0) return nullptr;
+        FixOrder& o = slab_[n.id & mask_];
+        if (o.id != n.id && o.working()) {
+            ++collisions_;
+            return nullptr;
+        }
+        FixOrder* orig = n.kind == FixOrdKind::Order ? nullptr : find(n.orig_id);
+
+        o.id = n.id;
+        o.orig_id = n.orig_id;
+        o.qty = n.qty;
+        o.cum_qty = 0;
+        o.price = n.price;
+        o.avg_px = 0.0;
+        o.updated_ns = now_ns;
+        o.symbol = n.symbol;
+        o.digits = n.digits;
+        o.side = n.side;
+        o.kind = n.kind;
+        o.state = n.kind == FixOrdKind::Cancel ? FixOrdState::PendingCancel : FixOrdState::PendingNew;
+        o.prev_state = o.state;
+
+        if (orig) {
+            if (n.kind == FixOrdKind::Replace) {
+                o.cum_qty = orig->cum_qty;
+                o.avg_px = orig->avg_px;
+                if (o.symbol == 0) o.symbol = orig->symbol;
+                if (o.digits == 0) o.digits = orig->digits;
+                o.side = orig->side;
+            }
+            if (orig->working()) {
+                orig->prev_state = orig->state;
+                orig->state = n.kind == FixOrdKind::Cancel ? FixOrdState::PendingCancel
+                                                           : FixOrdState::PendingReplace;
+            }
+        }
+        return &o;
+    }
+
+    FixOrder* find(uint64_t id) {
+        if (id == 0) return nullptr;
+        FixOrder& o = slab_[id & mask_];
+        return o.id == id ? &o : nullptr;
+    }
+
+    const FixOrder* find(uint64_t id) const {
+        return const_cast<FixOrderStore*>(this)->find(id);
+    }
+
+    // 35=8. Returns the order 11 names (null if it is not ours or has been
+    // overwritten); fill is set when the report was a trade.
+    FixOrder* onExecutionReport(const FixTagIndex& idx, int64_t now_ns, FixOrderFill& fill) {
+        fill = FixOrderFill();
+        FixOrder* o = find(idOf(idx, 11));
+        if (!o) return nullptr;
+        o->updated_ns = now_ns;
+
+        char exec_type = idx.getChar(150);
+        if (exec_type == 'F' || exec_type == '1' || exec_type == '2') {
+            int64_t last_qty = 0, last_px = 0;
+            if (parseFixPrice(idx.get(32), FixOrder::QTY_DIGITS, last_qty) == FixNumError::None &&
+                parseFixPrice(idx.get(31), FIX_MAX_DIGITS, last_px) == FixNumError::None && last_qty > 0) {
+                double px = static_cast<double>(last_px) / fixPow10(FIX_MAX_DIGITS);
+                int64_t cum = o->cum_qty + last_qty;
+                o->avg_px = (o->avg_px * static_cast<double>(o->cum_qty) + px * static_cast<double>(last_qty)) /
+                            static_cast<double>(cum);
+                o->cum_qty = cum;
+                fill.qty = last_qty;
+                fill.px = px;
+            }
+        }
+        int64_t v = 0;
+        if (parseFixPrice(idx.get(14), FixOrder::QTY_DIGITS, v) == FixNumError::None) o->cum_qty = v;
+        if (o->cum_qty > 0 && parseFixPrice(idx.get(6), FIX_MAX_DIGITS, v) == FixNumError::None && v > 0) {
+            o->avg_px = static_cast<double>(v) / fixPow10(FIX_MAX_DIGITS);
+        }
+
+        FixOrdState next = stateOf(idx.getChar(39));
+        if (o->kind != FixOrdKind::Order) {
+            FixOrder* orig = find(o->orig_id);
+            if (exec_type == '4' || next == FixOrdState::Canceled) {
+                if (orig) setState(*orig, FixOrdState::Canceled);
+                setState(*o, FixOrdState::Canceled);
+                return o;
+            }
+            if (exec_type == '5' && orig) {
+                setState(*orig, FixOrdState::Replaced);
+                next = o->cum_qty > 0 ? FixOrdState::PartiallyFilled : FixOrdState::New;
+            }
+            if (next == FixOrdState::Rejected && orig) restore(*orig);
+        }
+        if (next == FixOrdState::Replaced && o->kind == FixOrdKind::Order) return o;   // answered via the new id
+        if ((o->state == FixOrdState::PendingCancel || o->state == FixOrdState::PendingReplace) &&
+            (next == FixOrdState::New || next == FixOrdState::PartiallyFilled)) {
+            o->prev_state = next;       // still waiting on the cancel/replace
+            return o;
+        }
+        if (next != FixOrdState::Free) setState(*o, next);
+        return o;
+    }
+
+    // 35=9: the cancel or replace 11 named was refused; the order 41 names
+    // goes back to where it was
+    FixOrder* onCancelReject(const FixTagIndex& idx, int64_t now_ns) {
+        FixOrder* req = find(idOf(idx, 11));
+        FixOrder* orig = find(req ? req->orig_id : idOf(idx, 41));
+        if (req) {
+            req->updated_ns = now_ns;
+            setState(*req, FixOrdState::Rejected);
+        }
+        if (orig) {
+            orig->updated_ns = now_ns;
+            restore(*orig);
+            FixOrdState now = stateOf(idx.getChar(39));
+            if (now != FixOrdState::Free && now != FixOrdState::Rejected) setState(*orig, now);
+        }
+        return orig;
+    }
+
+    void clear() {
+        std::memset(static_cast<void*>(slab_.get()), 0, sizeof(FixOrder) * (mask_ + 1));
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+    uint64_t collisions() const { return collisions_; }   // add() refused: slot still working
+
+private:
+    static size_t roundUp(size_t n) {
+        size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    static uint64_t idOf(const FixTagIndex& idx, uint32_t tag) {
+        int64_t id = 0;
+        if (parseFixInt(idx.get(tag), id) != FixNumError::None || id <= 0) return 0;
+        return static_cast<uint64_t>(id);
+    }
+
+    // OrdStatus (39); Free = absent or not a state we track
+    static FixOrdState stateOf(char ord_status) {
+        switch (ord_status) {
+            case '0': return FixOrdState::New;
+            case '1': return FixOrdState::PartiallyFilled;
+            case '2': return FixOrdState::Filled;
+            case '4': return FixOrdState::Canceled;
+            case 'C': return FixOrdState::Canceled;     // Expired
+            case '5': return FixOrdState::Replaced;
+            case '6': return FixOrdState::PendingCancel;
+            case '8': return FixOrdState::Rejected;
+            case 'A': return FixOrdState::PendingNew;
+            case 'E': return FixOrdState::PendingReplace;
+        }
+        return FixOrdState::Free;
+    }
+
+    static void setState(FixOrder& o, FixOrdState s) {
+        if (fixOrdStateFinal(o.state)) return;
+        o.state = s;
+    }
+
+    static void restore(FixOrder& o) {
+        if (o.state == FixOrdState::PendingCancel || o.state == FixOrdState::PendingReplace) {
+            o.state = o.prev_state;
+        }
+    }
+
+    size_t mask_;
+    std::unique_ptr<FixOrder[]> slab_;
+    uint64_t collisions_;
+};
+
+} // namespace chimera
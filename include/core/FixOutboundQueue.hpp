@@ -0,0 +1,287 @@
+#pragma once
+
+// ChimeraMetals
+// FixOutboundQueue.hpp - Lock-free MPSC outbound queue with TLS record coalescing
+//
+// Producers copy finished messages into fixed slots (bounded Vyukov-style
+// ring, one CAS per push). Whoever holds the flush flag drains every
+// published slot into one buffer and hands it to the writer as a single
+// TLS record: a burst of orders, or a heartbeat reply plus a resend, costs
+// one SSL_write and one syscall instead of one each.
+//
+// When to flush is the caller's policy:
+//   push(.., urgent=true)   flushes at once (orders, cancels)
+//   flushIfDue(now)         flushes when max_record_bytes are pending or the
+//                           oldest message has waited max_delay_ns
+//   flush()                 unconditionally, e.g. before blocking in SSL_read
+// A producer that finds another thread flushing leaves its message to it;
+// the flusher re-checks after releasing the flag, fenced against the
+// producer's publish, so nothing is stranded.
+//
+// Messages reach the wire in the order their push claimed a slot.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "FixTime.hpp"
+
+namespace chimera {
+
+struct FixOutboundBudget {
+    size_t max_record_bytes = 16384;    // TLS plaintext record limit
+    int64_t max_delay_ns = 50000;       // oldest pending message may wait this long
+};
+
+struct FixOutboundStats {
+    uint64_t messages = 0;      // pushed
+    uint64_t records = 0;       // writer calls, i.e. SSL_write / TLS records
+    uint64_t bytes = 0;
+    uint64_t urgent = 0;        // pushes that forced a flush
+    uint64_t direct = 0;        // too large or queue full, written through
+    uint64_t errors = 0;        // writer failures
+
+    // Totals over several sessions
+    FixOutboundStats& operator+=(const FixOutboundStats& o) {
+        messages += o.messages;
+        records += o.records;
+        bytes += o.bytes;
+        urgent += o.urgent;
+        direct += o.direct;
+        errors += o.errors;
+        return *this;
+    }
+};
+
+class FixOutboundQueue {
+public:
+    static const size_t SLOTS = 256;
+    static const size_t SLOT_BYTES = 1024;
+    static const size_t MAX_RECORD = 16384;
+
+    FixOutboundQueue()
+        : head_(0),
+          tail_(0),
+          pending_bytes_(0),
+          messages_(0),
+          records_(0),
+          bytes_(0),
+          urgent_(0),
+          direct_(0),
+          errors_(0)
+    {
+        for (size_t i = 0; i < SLOTS; ++i) slots_[i].seq.store(i, std::memory_order_relaxed);
+        flushing_.clear();
+    }
+
+    void setBudget(const FixOutboundBudget& b) {
+        budget_ = b;
+        if (budget_.max_record_bytes == 0 || budget_.max_record_bytes > MAX_RECORD) {
+            budget_.max_record_bytes = MAX_RECORD;
+        }
+    }
+
+    const FixOutboundBudget& budget() const {
+        return budget_;
+    }
+
+    // Queues msg, then flushes if urgent or the budget is exhausted. A message
+    // that does not fit a slot, or a full queue, is written through after
+    // draining what is already queued. Returns false only on a write failure.
+    template <typename Writer>
+    bool push(const char* data, size_t size, Writer&& writer, bool urgent = false) {
+        int64_t now = fixWallClockNs();
+        if (!enqueue(data, size, now)) {
+            return writeThrough(data, size, writer);
+        }
+        messages_.fetch_add(1, std::memory_order_relaxed);
+        if (urgent) {
+            urgent_.fetch_add(1, std::memory_order_relaxed);
+            return flush(writer);
+        }
+        return flushIfDue(now, writer);
+    }
+
+    template <typename Writer>
+    bool flushIfDue(int64_t now_ns, Writer&& writer) {
+        if (!due(now_ns)) return true;
+        return flush(writer);
+    }
+
+    // Drains everything published so far. Returns false if a write failed.
+    template <typename Writer>
+    bool flush(Writer&& writer) {
+        bool ok = true;
+        // The two fences pair up (store buffering): a producer that published
+        // and then finds the flag set is seen by the flusher's ready() after
+        // its clear. Without them either load may miss the other's store.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (true) {
+            if (flushing_.test_and_set(std::memory_order_acquire)) return ok;
+            ok = drain(writer) && ok;
+            flushing_.clear(std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!ready()) return ok;
+        }
+    }
+
+    // Something published is waiting and the size or delay budget is spent
+    bool due(int64_t now_ns) const {
+        if (!ready()) return false;
+        if (pending_bytes_.load(std::memory_order_relaxed) >= budget_.max_record_bytes) return true;
+        const Slot& s = slots_[head_.load(std::memory_order_relaxed) & (SLOTS - 1)];
+        return now_ns - s.enqueued_ns >= budget_.max_delay_ns;
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    FixOutboundStats stats() const {
+        FixOutboundStats s;
+        s.messages = messages_.load(std::memory_order_relaxed);
+        s.records = records_.load(std::memory_order_relaxed);
+        s.bytes = bytes_.load(std::memory_order_relaxed);
+        s.urgent = urgent_.load(std::memory_order_relaxed);
+        s.direct = direct_.load(std::memory_order_relaxed);
+        s.errors = errors_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    // Drops anything queued; for reconnects, with no producer running
+    void clear() {
+        uint64_t h = head_.load(std::memory_order_relaxed);
+        uint64_t t = tail_.load(std::memory_order_relaxed);
+        for (; h != t; ++h) slots_[h & (SLOTS - 1)].seq.store(h + SLOTS, std::memory_order_relaxed);
+        head_.store(t, std::memory_order_release);
+        pending_bytes_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static_assert((SLOTS & (SLOTS - 1)) == 0, "SLOTS must be a power of two");
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> seq;      // == ticket: free, == ticket + 1: published
+        uint32_t size;
+        int64_t enqueued_ns;
+        char data[SLOT_BYTES];
+    };
+
+    bool enqueue(const char* data, size_t size, int64_t now) {
+        if (size > SLOT_BYTES) return false;
+
+        uint64_t pos = tail_.load(std::memory_order_relaxed);
+        Slot* s;
+        while (true) {
+            s = &slots_[pos & (SLOTS - 1)];
+            uint64_t seq = s->seq.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;       // full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::memcpy(s->data, data, size);
+        s->size = static_cast<uint32_t>(size);
+        s->enqueued_ns = now;
+        pending_bytes_.fetch_add(size, std::memory_order_relaxed);
+        s->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool ready() const {
+        uint64_t h = head_.load(std::memory_order_relaxed);
+        return slots_[h & (SLOTS - 1)].seq.load(std::memory_order_acquire) == h + 1;
+    }
+
+    // Caller holds flushing_
+    template <typename Writer>
+    bool drain(Writer& writer) {
+        bool ok = true;
+        size_t len = 0;
+        uint64_t h = head_.load(std::memory_order_relaxed);
+
+        while (true) {
+            Slot& s = slots_[h & (SLOTS - 1)];
+            if (s.seq.load(std::memory_order_acquire) != h + 1) break;
+
+            if (len > 0 && len + s.size > budget_.max_record_bytes) {
+                ok = emit(writer, len) && ok;
+                len = 0;
+            }
+            std::memcpy(record_ + len, s.data, s.size);
+            len += s.size;
+            pending_bytes_.fetch_sub(s.size, std::memory_order_relaxed);
+
+            s.seq.store(h + SLOTS, std::memory_order_release);
+            ++h;
+            head_.store(h, std::memory_order_release);
+        }
+
+        if (len > 0) ok = emit(writer, len) && ok;
+        return ok;
+    }
+
+    template <typename Writer>
+    bool emit(Writer& writer, size_t len) {
+        records_.fetch_add(1, std::memory_order_relaxed);
+        bytes_.fetch_add(len, std::memory_order_relaxed);
+        if (writer(record_, len)) return true;
+        errors_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    template <typename Writer>
+    bool writeThrough(const char* data, size_t size, Writer& writer) {
+        // Queued messages go first; spin until the current flusher is done
+        while (flushing_.test_and_set(std::memory_order_acquire)) {}
+        bool ok = drain(writer);
+        messages_.fetch_add(1, std::memory_order_relaxed);
+        direct_.fetch_add(1, std::memory_order_relaxed);
+        records_.fetch_add(1, std::memory_order_relaxed);
+        bytes_.fetch_add(size, std::memory_order_relaxed);
+        if (!writer(data, size)) {
+            errors_.fetch_add(1, std::memory_order_relaxed);
+            ok = false;
+        }
+        flushing_.clear(std::memory_order_release);
+        return ok;
+    }
+
+    Slot slots_[SLOTS];
+    alignas(64) std::atomic<uint64_t> head_;            // consumer
+    alignas(64) std::atomic<uint64_t> tail_;            // producers
+    alignas(64) std::atomic<size_t> pending_bytes_;
+    std::atomic_flag flushing_;
+    FixOutboundBudget budget_;
+    char record_[MAX_RECORD + SLOT_BYTES];
+
+    std::atomic<uint64_t> messages_;
+    std::atomic<uint64_t> records_;
+    std::atomic<uint64_t> bytes_;
+    std::atomic<uint64_t> urgent_;
+    std::atomic<uint64_t> direct_;
+    std::atomic<uint64_t> errors_;
+};
+
+// Records/s and SSL_write calls per message between two stats() snapshots
+struct FixOutboundRates {
+    double records_per_sec = 0.0;
+    double writes_per_message = 0.0;
+
+    static FixOutboundRates between(const FixOutboundStats& a, const FixOutboundStats& b, double seconds) {
+        FixOutboundRates r;
+        uint64_t records = b.records - a.records;
+        uint64_t messages = b.messages - a.messages;
+        if (seconds > 0.0) r.records_per_sec = static_cast<double>(records) / seconds;
+        if (messages > 0) r.writes_per_message = static_cast<double>(records) / static_cast<double>(messages);
+        return r;
+    }
+};
+
+} // namespace chimera
@@ -0,0 +1,99 @@
+#pragma once
+
+// ChimeraMetals
+// FixQuoteCache.hpp - Per-symbol top of book, one seqlocked cache line each
+//
+// The quote thread is the only writer; the dashboard, telemetry and any
+// strategy thread read. Each symbol owns one 64-byte slot: a FixSeqlock
+// sequence word and the quote itself, so a reader always gets a bid, ask
+// and sizes from the same update, never a bid from one tick and an ask from
+// the next. Writers never wait; readers retry only while that one slot is
+// being written. Slots are indexed by FixSymbolDirectory handle, so there
+// are no string keys and the whole cache is a few kilobytes.
+//
+// A batch that carries only one side updates that side and keeps the other.
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "FixMdDecoder.hpp"
+#include "FixNumeric.hpp"
+#include "FixSeqlock.hpp"
+#include "FixSymbolDirectory.hpp"
+#include "FixTime.hpp"
+
+namespace chimera {
+
+struct FixQuote {
+    double bid;
+    double ask;
+    double bid_size;                // units, 0 when the feed sent no 271
+    double ask_size;
+    int64_t exchange_ns;            // SendingTime (52) of the last update, 0 if absent
+    int64_t rx_ns;                  // receive time of the last update
+    uint64_t updates;               // 0 = never quoted
+
+    bool valid() const { return updates != 0; }
+    double mid() const { return (bid + ask) / 2.0; }
+    double spread() const { return ask - bid; }
+};
+
+class FixQuoteCache {
+public:
+    static const size_t MAX_SYMBOLS = FixSymbolDirectory::MAX_SYMBOLS;
+
+    FixQuoteCache() : slots_(new FixSeqlock<FixQuote>[MAX_SYMBOLS]) {}
+
+    FixQuoteCache(const FixQuoteCache&) = delete;
+    FixQuoteCache& operator=(const FixQuoteCache&) = delete;
+
+    // Writer thread only. False for FIX_NO_SYMBOL or a top with no price.
+    bool update(FixSymbolHandle h, const FixMdTop& top, int64_t exchange_ns, int64_t rx_ns) {
+        if (h >= MAX_SYMBOLS || (!top.has_bid && !top.has_ask)) return false;
+        FixSeqlock<FixQuote>& slot = slots_[h];
+        FixQuote q = slot.load();   // never retries: this thread is the only writer
+        if (top.has_bid) {
+            q.bid = top.bid.toDouble();
+            q.bid_size = static_cast<double>(top.bid_size) / fixPow10(FIX_SIZE_DIGITS);
+        }
+        if (top.has_ask) {
+            q.ask = top.ask.toDouble();
+            q.ask_size = static_cast<double>(top.ask_size) / fixPow10(FIX_SIZE_DIGITS);
+        }
+        q.exchange_ns = exchange_ns;
+        q.rx_ns = rx_ns;
+        ++q.updates;
+        slot.store(q);
+        return true;
+    }
+
+    // As above for every top of a decoded batch, stamped with the message's
+    // 52; symbols not in the directory are skipped
+    size_t update(const FixSymbolDirectory& symbols, const FixMdTop* tops, size_t n,
+                  std::string_view sending_time, int64_t rx_ns) {
+        int64_t exchange_ns = 0;
+        if (!parseFixUtcTimestamp(sending_time, exchange_ns)) exchange_ns = 0;
+        size_t stored = 0;
+        for (size_t i = 0; i < n; ++i) stored += update(symbols.handleOf(tops[i]), tops[i], exchange_ns, rx_ns);
+        return stored;
+    }
+
+    // Any thread. An invalid (all zero) quote for a symbol never updated.
+    FixQuote load(FixSymbolHandle h) const {
+        if (h >= MAX_SYMBOLS) return FixQuote();
+        return slots_[h].load();
+    }
+
+    // Updates so far; a poller can skip load() when this has not moved
+    uint64_t version(FixSymbolHandle h) const {
+        return h < MAX_SYMBOLS ? slots_[h].version() : 0;
+    }
+
+private:
+    std::unique_ptr<FixSeqlock<FixQuote>[]> slots_;
+};
+
+static_assert(sizeof(FixSeqlock<FixQuote>) == 64, "one quote slot per cache line");
+
+} // namespace chimera
@@ -0,0 +1,529 @@
+#pragma once
+
+// ChimeraMetals
+// FixReactor.hpp - Single-threaded epoll reactor for FIX sessions (Linux)
+//
+// One thread owns every session's non-blocking socket and non-blocking SSL:
+// TCP connect, TLS handshake, reads, writes that the socket would not take
+// (EPOLLOUT), timers and cross-thread wakeups (eventfd) all run in run().
+// Heartbeats, logon timeouts and shutdown no longer depend on a socket
+// becoming readable, and one pinned core serves QUOTE and TRADE alike.
+//
+// Per iteration: epoll_wait until the next timer, handle readiness, fire
+// due timers, then flush every session's outbound queue before blocking
+// again, so replies produced while handling a batch share one TLS record.
+// Other threads that queue non-urgent messages call wake().
+//
+// Spin mode (setSpin) replaces the blocking epoll_wait with epoll_wait(0)
+// and a pause backoff, so a tick is picked up without a scheduler wakeup.
+// After idle_ns with no events the loop blocks as usual until the next one;
+// it costs a whole core only while the market is moving.
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+#include "platform/platform.hpp"
+
+#include "FixSession.hpp"
+#include "FixSpin.hpp"
+#include "FixTagIndex.hpp"
+
+namespace chimera {
+
+class FixReactorHandler {
+public:
+    virtual ~FixReactorHandler() {}
+
+    // TLS is up; send Logon from here
+    virtual void onConnected(FixSession&) {}
+    virtual void onMessage(FixSession& session, std::string_view msg, const FixTagIndex& idx) = 0;
+    // Called once; the session is already disconnected. Reconnect from here
+    // or from a timer.
+    virtual void onDisconnected(FixSession&) {}
+};
+
+// Busy-poll receive loop; off means epoll_wait blocks
+struct FixSpinPolicy {
+    bool enabled = false;
+    int64_t idle_ns = 500000000;        // no events this long: block until the next
+};
+
+// Per-socket options for FIX connections; 0 / false leaves the OS default
+struct FixSocketTuning {
+    int rcvbuf_bytes = 0;
+    int sndbuf_bytes = 0;
+    int busy_poll_us = 0;       // SO_BUSY_POLL; raising it needs CAP_NET_ADMIN
+    bool quickack = false;      // ACK every read at once instead of delaying
+    bool ktls = false;          // ask OpenSSL for kernel TLS; falls back silently
+};
+
+class FixReactor {
+public:
+    using TimerFn = std::function<void()>;
+
+    static const int MAX_EVENTS = 64;
+
+    FixReactor()
+        : epfd_(epoll_create1(EPOLL_CLOEXEC)),
+          wakefd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+          running_(true),
+          next_timer_id_(1),
+          idle_blocks_(0)
+    {
+        if (epfd_ >= 0 && wakefd_ >= 0) {
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.ptr = nullptr;
+            epoll_ctl(epfd_, EPOLL_CTL_ADD, wakefd_, &ev);
+        }
+    }
+
+    ~FixReactor() {
+        for (auto& e : entries_) {
+            if (!e->closed) e->session->disconnect();
+        }
+        if (wakefd_ >= 0) ::close(wakefd_);
+        if (epfd_ >= 0) ::close(epfd_);
+    }
+
+    FixReactor(const FixReactor&) = delete;
+    FixReactor& operator=(const FixReactor&) = delete;
+
+    bool ok() const {
+        return epfd_ >= 0 && wakefd_ >= 0;
+    }
+
+    // Applied to every socket connect() creates from now on
+    void setTuning(const FixSocketTuning& t) {
+        tuning_ = t;
+    }
+
+    // Before run()
+    void setSpin(const FixSpinPolicy& p) {
+        spin_ = p;
+    }
+
+    // Spin mode: times the loop gave up spinning and blocked
+    uint64_t idleBlocks() const {
+        return idle_blocks_.load(std::memory_order_relaxed);
+    }
+
+    // Starts a non-blocking TCP connect + TLS handshake for session.
+    // handler.onConnected() runs once TLS is up, onDisconnected() on any
+    // failure. Reactor thread only (or before run()).
+    bool connect(FixSession& session, FixReactorHandler& handler,
+                 const sockaddr_in& addr, SSL_CTX* ctx) {
+        return open(session, handler, addr, ctx, nullptr, std::string());
+    }
+
+    // Same, through a long-lived FixTlsClient: SNI for host and resumption
+    // of its last session. connectTiming() gets tcp_ns, tls_ns, tls_resumed.
+    bool connect(FixSession& session, FixReactorHandler& handler,
+                 const sockaddr_in& addr, FixTlsClient& tls, const std::string& host) {
+        return open(session, handler, addr, tls.ctx(), &tls, host);
+    }
+
+    // Closes session's connection; onDisconnected() follows
+    void disconnect(FixSession& session) {
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            if (entries_[i]->session == &session) shutdownEntry(*entries_[i]);
+        }
+    }
+
+    // Runs fn after delay_ns, then every interval_ns if non-zero
+    uint64_t addTimer(int64_t delay_ns, int64_t interval_ns, TimerFn fn) {
+        Timer t;
+        t.deadline = nowNs() + delay_ns;
+        t.interval = interval_ns;
+        t.id = next_timer_id_++;
+        t.fn = std::make_shared<TimerFn>(std::move(fn));
+        uint64_t id = t.id;
+        timers_.push_back(std::move(t));
+        std::push_heap(timers_.begin(), timers_.end(), TimerLater());
+        return id;
+    }
+
+    void cancelTimer(uint64_t id) {
+        for (const Timer& t : timers_) {
+            if (t.id == id) {
+                cancelled_.push_back(id);
+                return;
+            }
+        }
+    }
+
+    // Any thread
+    void wake() {
+        uint64_t one = 1;
+        ssize_t r = ::write(wakefd_, &one, sizeof(one));
+        (void)r;
+    }
+
+    // Any thread
+    void stop() {
+        running_.store(false, std::memory_order_release);
+        wake();
+    }
+
+    bool running() const {
+        return running_.load(std::memory_order_acquire);
+    }
+
+    // Loops until stop(), which may come before run() starts. cpu >= 0
+    // pins the calling thread first.
+    void run(int cpu = -1) {
+        if (cpu >= 0 && !plat::pin_thread(cpu)) {
+            std::cerr << "[FIX] Could not pin reactor to CPU " << cpu << "\n";
+        }
+        if (!spin_.enabled) {
+            while (running()) poll(-1);
+            return;
+        }
+
+        FixSpinBackoff backoff;
+        int64_t last_event = nowNs();
+        while (running()) {
+            if (poll(0) > 0) {
+                last_event = nowNs();
+                backoff.reset();
+                continue;
+            }
+            if (nowNs() - last_event < spin_.idle_ns) {
+                backoff.pause();
+                continue;
+            }
+            // Idle: sleep until traffic; a timer alone does not resume spinning
+            idle_blocks_.fetch_add(1, std::memory_order_relaxed);
+            if (poll(-1) > 0) {
+                last_event = nowNs();
+                backoff.reset();
+            }
+        }
+    }
+
+    // One iteration; timeout_ms < 0 waits for the next timer or event.
+    // Returns the number of ready descriptors.
+    int poll(int timeout_ms) {
+        int timeout = timerTimeoutMs();
+        if (timeout_ms >= 0 && (timeout < 0 || timeout_ms < timeout)) timeout = timeout_ms;
+
+        epoll_event events[MAX_EVENTS];
+        int n = epoll_wait(epfd_, events, MAX_EVENTS, timeout);
+        for (int i = 0; i < n; ++i) {
+            Entry* e = static_cast<Entry*>(events[i].data.ptr);
+            if (!e) {
+                uint64_t v;
+                while (::read(wakefd_, &v, sizeof(v)) > 0) {}
+                continue;
+            }
+            if (e->closed) continue;
+            onEvent(*e, events[i].events);
+        }
+
+        fireTimers();
+
+        // Indexed: onDisconnected() may connect() a replacement
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            Entry& e = *entries_[i];
+            if (e.closed || e.phase != Phase::Open) continue;
+            if (!e.session->flushOutbound()) {
+                shutdownEntry(e);
+                continue;
+            }
+            updateInterest(e);
+        }
+
+        reap();
+        return n;
+    }
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    enum class Phase {
+        TcpConnect,
+        Handshake,
+        Open
+    };
+
+    struct Entry {
+        FixSession* session = nullptr;
+        FixReactorHandler* handler = nullptr;
+        socket_t fd = INVALID_SOCKET_FD;
+        Phase phase = Phase::TcpConnect;
+        int64_t stage_ns = 0;           // start of the current connect stage
+        uint32_t events = 0;
+        bool closed = false;
+    };
+
+    struct Timer {
+        int64_t deadline = 0;
+        int64_t interval = 0;
+        uint64_t id = 0;
+        std::shared_ptr<TimerFn> fn;
+    };
+
+    struct TimerLater {
+        bool operator()(const Timer& a, const Timer& b) const {
+            return a.deadline > b.deadline;
+        }
+    };
+
+    bool open(FixSession& session, FixReactorHandler& handler, const sockaddr_in& addr,
+              SSL_CTX* ctx, FixTlsClient* tls, const std::string& host) {
+        int64_t started = nowNs();
+        socket_t fd = plat::create_tcp();
+        if (fd == INVALID_SOCKET_FD) return false;
+        if (!plat::set_nonblocking(fd, true)) {
+            plat::socket_close(fd);
+            return false;
+        }
+        applyTuning(fd);
+
+        int rc = plat::socket_connect(fd, addr);
+        if (rc < 0 && !plat::connect_in_progress(plat::last_error())) {
+            plat::socket_close(fd);
+            return false;
+        }
+
+        SSL* ssl = SSL_new(ctx);
+        if (!ssl) {
+            plat::socket_close(fd);
+            return false;
+        }
+        SSL_set_fd(ssl, fd);
+        SSL_set_connect_state(ssl);
+        if (tls) tls->prepare(ssl, host);
+        SSL_set_mode(ssl, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+#ifdef SSL_OP_ENABLE_KTLS
+        if (tuning_.ktls) SSL_set_options(ssl, SSL_OP_ENABLE_KTLS);
+#endif
+
+        session.attachSSL(ssl, fd);
+        session.setNonBlocking(true);
+        session.setState(FixSession::State::Connecting);
+
+        auto e = std::make_unique<Entry>();
+        e->session = &session;
+        e->handler = &handler;
+        e->fd = fd;
+        e->phase = rc == 0 ? Phase::Handshake : Phase::TcpConnect;
+        e->stage_ns = started;
+        FixConnectTiming& timing = session.connectTiming();
+        timing.tcp_ns = 0;
+        timing.tls_ns = 0;
+        timing.tls_resumed = false;
+        timing.standby = false;
+        if (rc == 0) {
+            e->stage_ns = nowNs();
+            timing.tcp_ns = e->stage_ns - started;
+        }
+        e->events = EPOLLIN | EPOLLOUT;
+
+        epoll_event ev{};
+        ev.events = e->events;
+        ev.data.ptr = e.get();
+        if (epoll_ctl(epfd_, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            session.disconnect();
+            return false;
+        }
+        entries_.push_back(std::move(e));
+        return true;
+    }
+
+    void onEvent(Entry& e, uint32_t ev) {
+        if (e.phase == Phase::TcpConnect) {
+            int err = 0;
+            socklen_t len = sizeof(err);
+            if ((ev & (EPOLLERR | EPOLLHUP)) ||
+                getsockopt(e.fd, SOL_SOCKET, SO_ERROR, &err, &len) != 0 || err != 0) {
+                shutdownEntry(e);
+                return;
+            }
+            if (!(ev & EPOLLOUT)) return;
+            e.phase = Phase::Handshake;
+            int64_t now = nowNs();
+            e.session->connectTiming().tcp_ns = now - e.stage_ns;
+            e.stage_ns = now;
+        }
+
+        if (e.phase == Phase::Handshake) {
+            handshake(e);
+            return;
+        }
+
+        if (ev & EPOLLOUT) {
+            if (!e.session->flushTxBacklog()) {
+                shutdownEntry(e);
+                return;
+            }
+        }
+        if (ev & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+            readAll(e);
+        }
+    }
+
+    void handshake(Entry& e) {
+        SSL* ssl = e.session->ssl();
+        int rc = SSL_do_handshake(ssl);
+        if (rc == 1) {
+            e.phase = Phase::Open;
+            e.session->setState(FixSession::State::Connected);
+            e.session->resetOnReconnect();
+            e.session->detectKtls();
+            FixConnectTiming& timing = e.session->connectTiming();
+            timing.tls_ns = nowNs() - e.stage_ns;
+            timing.tls_resumed = FixTlsClient::resumed(ssl);
+            setInterest(e, EPOLLIN);
+            e.handler->onConnected(*e.session);
+            return;
+        }
+        int err = SSL_get_error(ssl, rc);
+        if (err == SSL_ERROR_WANT_READ) {
+            setInterest(e, EPOLLIN);
+        } else if (err == SSL_ERROR_WANT_WRITE) {
+            setInterest(e, EPOLLIN | EPOLLOUT);
+        } else {
+            ERR_print_errors_fp(stderr);
+            shutdownEntry(e);
+        }
+    }
+
+    // Edge of the socket: read until OpenSSL wants more from the kernel
+    void readAll(Entry& e) {
+        FixSession& s = *e.session;
+        while (!e.closed) {
+            bool retry = false;
+            bool fatal = false;
+            int n = s.readIntoRing(retry, fatal);
+            if (n > 0) {
+                s.forEachCompleteMessage([&](std::string_view msg, const FixTagIndex& idx) {
+                    if (!e.closed) e.handler->onMessage(s, msg, idx);
+                });
+                if (s.getState() == FixSession::State::Error) {
+                    shutdownEntry(e);
+                    return;
+                }
+                continue;
+            }
+            if (fatal || !retry) {
+                shutdownEntry(e);      // error or clean close_notify
+                return;
+            }
+            break;                     // WANT_READ / WANT_WRITE
+        }
+        // The kernel drops back to delayed ACKs on its own; re-arm per wakeup
+        if (tuning_.quickack) plat::set_quickack(e.fd);
+    }
+
+    void applyTuning(socket_t fd) {
+        plat::set_nodelay(fd);
+        if (tuning_.rcvbuf_bytes > 0 && !plat::set_rcvbuf(fd, tuning_.rcvbuf_bytes)) {
+            std::cerr << "[FIX] SO_RCVBUF " << tuning_.rcvbuf_bytes << " refused\n";
+        }
+        if (tuning_.sndbuf_bytes > 0 && !plat::set_sndbuf(fd, tuning_.sndbuf_bytes)) {
+            std::cerr << "[FIX] SO_SNDBUF " << tuning_.sndbuf_bytes << " refused\n";
+        }
+        if (tuning_.busy_poll_us > 0 && !plat::set_busy_poll(fd, tuning_.busy_poll_us)) {
+            std::cerr << "[FIX] SO_BUSY_POLL " << tuning_.busy_poll_us << "us refused\n";
+        }
+        if (tuning_.quickack) plat::set_quickack(fd);
+    }
+
+    // EPOLLOUT only while OpenSSL has bytes the socket refused
+    void updateInterest(Entry& e) {
+        uint32_t want = EPOLLIN;
+        SSL* ssl = e.session->ssl();
+        if (e.session->txBacklogged() || (ssl && SSL_want_write(ssl))) want |= EPOLLOUT;
+        setInterest(e, want);
+    }
+
+    void setInterest(Entry& e, uint32_t events) {
+        if (e.events == events) return;
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.ptr = &e;
+        if (epoll_ctl(epfd_, EPOLL_CTL_MOD, e.fd, &ev) == 0) e.events = events;
+    }
+
+    void shutdownEntry(Entry& e) {
+        if (e.closed) return;
+        e.closed = true;
+        epoll_ctl(epfd_, EPOLL_CTL_DEL, e.fd, nullptr);
+        e.session->disconnect();
+        e.handler->onDisconnected(*e.session);
+    }
+
+    void reap() {
+        entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                      [](const std::unique_ptr<Entry>& e) { return e->closed; }),
+                       entries_.end());
+    }
+
+    bool isCancelled(uint64_t id) {
+        auto it = std::find(cancelled_.begin(), cancelled_.end(), id);
+        if (it == cancelled_.end()) return false;
+        cancelled_.erase(it);
+        return true;
+    }
+
+    int timerTimeoutMs() const {
+        if (timers_.empty()) return -1;
+        int64_t wait = timers_.front().deadline - nowNs();
+        if (wait <= 0) return 0;
+        return static_cast<int>((wait + 999999) / 1000000);
+    }
+
+    void fireTimers() {
+        int64_t now = nowNs();
+        while (!timers_.empty() && timers_.front().deadline <= now) {
+            std::pop_heap(timers_.begin(), timers_.end(), TimerLater());
+            Timer t = std::move(timers_.back());
+            timers_.pop_back();
+            if (isCancelled(t.id)) continue;
+
+            if (t.interval > 0) {
+                Timer next = t;
+                next.deadline = now + t.interval;
+                timers_.push_back(std::move(next));
+                std::push_heap(timers_.begin(), timers_.end(), TimerLater());
+            }
+            (*t.fn)();
+        }
+    }
+
+    int epfd_;
+    int wakefd_;
+    std::atomic<bool> running_;
+    uint64_t next_timer_id_;
+    FixSocketTuning tuning_;
+    FixSpinPolicy spin_;
+    std::atomic<uint64_t> idle_blocks_;
+    std::vector<std::unique_ptr<Entry>> entries_;
+    std::vector<Timer> timers_;
+    std::vector<uint64_t> cancelled_;
+};
+
+} // namespace chimera
+
+#endif // __linux__
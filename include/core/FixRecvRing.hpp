@@ -0,0 +1,169 @@
+#pragma once
+
+// ChimeraMetals
+// FixRecvRing.hpp - Fixed-capacity receive buffer with zero-copy FIX framing
+//
+// Bytes are read straight into writePtr() and framed in place. Each complete
+// message is handed out as a std::string_view into the buffer; views stay valid
+// until the next compact()/read, which only ever moves the trailing partial
+// message (at most one memmove per read, never one per message).
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+
+namespace chimera {
+
+class FixRecvRing {
+public:
+    enum class Frame {
+        Complete,    // out holds one full message (header through 10=xxx<SOH>)
+        NeedMore,    // partial message buffered, read more bytes
+        Malformed    // BodyLength/trailer invalid, buffer has been cleared
+    };
+
+    static const size_t DEFAULT_CAPACITY = 256 * 1024;
+    static const size_t MAX_FIX_MESSAGE_SIZE = 65536;
+
+    explicit FixRecvRing(size_t capacity = DEFAULT_CAPACITY)
+        : buf_(new char[capacity]),
+          capacity_(capacity),
+          head_(0),
+          tail_(0)
+    {}
+
+    FixRecvRing(const FixRecvRing&) = delete;
+    FixRecvRing& operator=(const FixRecvRing&) = delete;
+
+    // Free space at the write end. Compacts first when the tail is short of
+    // room for a maximum-sized read, so callers can always pass writable()
+    // straight to SSL_read.
+    char* writePtr() {
+        if (capacity_ - tail_ < MAX_FIX_MESSAGE_SIZE / 4) {
+            compact();
+        }
+        return buf_.get() + tail_;
+    }
+
+    size_t writable() const {
+        return capacity_ - tail_;
+    }
+
+    void commit(size_t n) {
+        tail_ += n;
+    }
+
+    // Copying ingress for callers that already own a buffer.
+    bool append(const char* data, size_t size) {
+        if (size > capacity_ - tail_) compact();
+        if (size > capacity_ - tail_) return false;
+        std::memcpy(buf_.get() + tail_, data, size);
+        tail_ += size;
+        return true;
+    }
+
+    size_t size() const {
+        return tail_ - head_;
+    }
+
+    bool full() const {
+        return head_ == 0 && tail_ == capacity_;
+    }
+
+    void clear() {
+        head_ = 0;
+        tail_ = 0;
+    }
+
+    // Move the unconsumed bytes to the front. Invalidates outstanding views.
+    void compact() {
+        if (head_ == 0) return;
+        size_t n = tail_ - head_;
+        if (n > 0) {
+            std::memmove(buf_.get(), buf_.get() + head_, n);
+        }
+        head_ = 0;
+        tail_ = n;
+    }
+
+    Frame next(std::string_view& out) {
+        static const char BEGIN[] = "8=FIX";
+        const size_t BEGIN_LEN = sizeof(BEGIN) - 1;
+        const size_t CHECKSUM_LENGTH = 7; // "10=xxx\x01"
+
+        while (true) {
+            std::string_view pending(buf_.get() + head_, tail_ - head_);
+            if (pending.size() < BEGIN_LEN) return Frame::NeedMore;
+
+            if (pending.compare(0, BEGIN_LEN, BEGIN) != 0) {
+                size_t start = pending.find(BEGIN);
+                if (start == std::string_view::npos) {
+                    // Keep a possible split "8=FI" prefix for the next read
+                    head_ = tail_ - (BEGIN_LEN - 1);
+                    return Frame::NeedMore;
+                }
+                head_ += start;
+                continue;
+            }
+
+            size_t soh = pending.find('\x01', BEGIN_LEN);
+            if (soh == std::string_view::npos) return Frame::NeedMore;
+
+            size_t len_pos = soh + 1;
+            if (pending.size() < len_pos + 2) return Frame::NeedMore;
+            if (pending[len_pos] != '9' || pending[len_pos + 1] != '=') {
+                head_ += len_pos;
+                continue;
+            }
+
+            size_t body_length = 0;
+            size_t i = len_pos + 2;
+            size_t digits = 0;
+            for (; i < pending.size() && pending[i] != '\x01'; ++i, ++digits) {
+                unsigned d = static_cast<unsigned char>(pending[i]) - '0';
+                if (d > 9 || digits >= 6) {
+                    clear();
+                    return Frame::Malformed;
+                }
+                body_length = body_length * 10 + d;
+            }
+            if (i == pending.size()) return Frame::NeedMore;
+            if (digits == 0 || body_length > MAX_FIX_MESSAGE_SIZE) {
+                clear();
+                return Frame::Malformed;
+            }
+
+            size_t expected_total = i + 1 + body_length + CHECKSUM_LENGTH;
+            if (pending.size() < expected_total) {
+                if (expected_total > capacity_) {
+                    clear();
+                    return Frame::Malformed;
+                }
+                return Frame::NeedMore;
+            }
+
+            const char* trailer = pending.data() + expected_total - CHECKSUM_LENGTH;
+            if (std::memcmp(trailer, "10=", 3) != 0 || trailer[6] != '\x01') {
+                clear();
+                return Frame::Malformed;
+            }
+
+            out = pending.substr(0, expected_total);
+            head_ += expected_total;
+            if (head_ == tail_) {
+                head_ = 0;
+                tail_ = 0;
+            }
+            return Frame::Complete;
+        }
+    }
+
+private:
+    std::unique_ptr<char[]> buf_;
+    size_t capacity_;
+    size_t head_;
+    size_t tail_;
+};
+
+} // namespace chimera
@@ -0,0 +1,111 @@
+#pragma once
+
+// ChimeraMetals
+// FixRxTimestamp.hpp - Kernel receive timestamps for a TLS socket
+//
+// OpenSSL owns the reads, so the timestamp is taken with a one-byte
+// recvmsg(MSG_PEEK) before SSL_read: the kernel attaches the software RX
+// timestamp of the oldest unread segment (SO_TIMESTAMPING, else
+// SO_TIMESTAMPNS) without consuming it. Skip the peek while SSL_pending() > 0,
+// those bytes were stamped by an earlier read. Anywhere else (Windows, or
+// the socket option refused) stamp() falls back to the wall clock.
+
+#include <cstdint>
+#include <cstring>
+
+#include "FixTime.hpp"
+
+#ifdef __linux__
+#include <linux/net_tstamp.h>
+#include <sys/socket.h>
+#include <time.h>
+#endif
+
+namespace chimera {
+
+class FixRxTimestamp {
+public:
+    enum class Source {
+        WallClock,
+        SoTimestampNs,
+        SoTimestamping
+    };
+
+    FixRxTimestamp()
+        : source_(Source::WallClock)
+    {}
+
+    // Ask the kernel to timestamp incoming segments on fd
+    Source enable(int fd) {
+        source_ = Source::WallClock;
+#ifdef __linux__
+        int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+        if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) == 0) {
+            source_ = Source::SoTimestamping;
+        } else {
+            int on = 1;
+            if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on)) == 0) {
+                source_ = Source::SoTimestampNs;
+            }
+        }
+#else
+        (void)fd;
+#endif
+        return source_;
+    }
+
+    Source source() const {
+        return source_;
+    }
+
+    // Receive time of the next unread byte on fd, in epoch ns. Blocks like
+    // the SSL_read that follows it would.
+    int64_t stamp(int fd) const {
+#ifdef __linux__
+        if (source_ != Source::WallClock) {
+            char byte;
+            alignas(cmsghdr) char control[128];
+            iovec iov{&byte, 1};
+            msghdr msg{};
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+
+            if (recvmsg(fd, &msg, MSG_PEEK) > 0) {
+                for (cmsghdr* c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c)) {
+                    if (c->cmsg_level != SOL_SOCKET) continue;
+                    timespec ts{};
+                    if (c->cmsg_type == SO_TIMESTAMPING) {
+                        // scm_timestamping: ts[0] software, ts[2] raw hardware
+                        std::memcpy(&ts, CMSG_DATA(c), sizeof(ts));
+                    } else if (c->cmsg_type == SO_TIMESTAMPNS) {
+                        std::memcpy(&ts, CMSG_DATA(c), sizeof(ts));
+                    } else {
+                        continue;
+                    }
+                    if (ts.tv_sec != 0) {
+                        return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+                    }
+                }
+            }
+        }
+#else
+        (void)fd;
+#endif
+        return fixWallClockNs();
+    }
+
+    static const char* sourceName(Source s) {
+        switch (s) {
+            case Source::SoTimestamping: return "SO_TIMESTAMPING";
+            case Source::SoTimestampNs: return "SO_TIMESTAMPNS";
+            default: return "wall clock";
+        }
+    }
+
+private:
+    Source source_;
+};
+
+} // namespace chimera
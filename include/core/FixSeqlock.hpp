@@ -0,0 +1,83 @@
+#pragma once
+
+// ChimeraMetals
+// FixSeqlock.hpp - Single-writer snapshot readable from any thread
+//
+// The writer bumps the sequence to odd, stores the value, and bumps it back
+// to even; a reader copies the value between two reads of the sequence and
+// retries if they differ or were odd. The writer never waits and readers
+// never block it, so a stats or state snapshot can be published from the
+// I/O thread on every change and polled by a dashboard or strategy thread
+// at no cost to the publisher beyond two stores and the copy.
+//
+// The value lives in relaxed atomic words rather than a plain T, so the
+// racing copy is well defined. T must be trivially copyable.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "FixSpin.hpp"
+
+namespace chimera {
+
+template <typename T>
+class FixSeqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "snapshots are copied by value");
+
+public:
+    FixSeqlock() : seq_(0) {
+        store(T());
+    }
+
+    explicit FixSeqlock(const T& v) : seq_(0) {
+        store(v);
+    }
+
+    FixSeqlock(const FixSeqlock&) = delete;
+    FixSeqlock& operator=(const FixSeqlock&) = delete;
+
+    // Writer thread only
+    void store(const T& v) {
+        uint64_t buf[WORDS] = {};
+        std::memcpy(buf, &v, sizeof(T));
+        uint64_t s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; ++i) words_[i].store(buf[i], std::memory_order_relaxed);
+        seq_.store(s + 2, std::memory_order_release);
+    }
+
+    // Any thread; spins only while a store is in progress
+    T load() const {
+        uint64_t buf[WORDS];
+        for (;;) {
+            uint64_t s0 = seq_.load(std::memory_order_acquire);
+            if (s0 & 1) {
+                fixCpuPause();
+                continue;
+            }
+            for (size_t i = 0; i < WORDS; ++i) buf[i] = words_[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == s0) break;
+        }
+        T v;
+        std::memcpy(&v, buf, sizeof(T));
+        return v;
+    }
+
+    // Stores so far; a reader can skip a load() when this has not moved
+    uint64_t version() const {
+        return seq_.load(std::memory_order_acquire) >> 1;
+    }
+
+private:
+    static const size_t WORDS = (sizeof(T) + 7) / 8;
+
+    alignas(64) std::atomic<uint64_t> seq_;
+    std::atomic<uint64_t> words_[WORDS];
+};
+
+} // namespace chimera
@@ -6,27 +6,108 @@
 // FIX #4: Gap recovery state, resend throttle, all state cleared on reset
 
 #include <atomic>
+#include <cstring>
 #include <mutex>
 #include <string>
 #include <vector>
 #include <functional>
 #include <chrono>
-#include <unordered_set>
-#include <unordered_map>
 #include <fstream>
 #include <iostream>
-#include <tuple>
+#include <type_traits>
+#include <string_view>
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 
-#ifdef _WIN32
-#include <winsock2.h>
-#else
-#include <unistd.h>
-#endif
+#include "platform/platform.hpp"
+
+#include "FixConnect.hpp"
+#include "FixExecIdWindow.hpp"
+#include "FixGapBuffer.hpp"
+#include "FixMessageStore.hpp"
+#include "FixOrderStore.hpp"
+#include "FixOutboundQueue.hpp"
+#include "FixRecvRing.hpp"
+#include "FixRxTimestamp.hpp"
+#include "FixSeqlock.hpp"
+#include "FixSimd.hpp"
+#include "FixSpscQueue.hpp"
+#include "FixTagIndex.hpp"
+#include "FixTime.hpp"
 
 namespace chimera {
 
+// Part of the broker's sequence to ask for again; end 0 = through the last
+struct FixResendRange {
+    int64_t begin = 0;              // 0 = nothing to request
+    int64_t end = 0;
+};
+
+// Where an inbound message stands against the expected MsgSeqNum (34)
+enum class FixSeqAction {
+    Process,        // the expected one: handle it, then drain nextHeld()
+    Duplicate,      // below expected (a resend already seen): drop it
+    Held,           // ahead of a gap: kept in the gap buffer until its turn
+    Overflow        // ahead of a gap with the buffer full: dropped
+};
+
+// Gap recovery counters, FixSession::gapStats()
+struct FixGapStats {
+    uint64_t gaps = 0;                  // holes detected
+    uint64_t held = 0;                  // messages kept instead of re-requested
+    uint64_t overflows = 0;             // messages dropped with the buffer full
+    uint64_t requested = 0;             // sequence numbers asked for in ResendRequests
+    uint64_t rerequests = 0;            // ResendRequests repeated after a stall
+    size_t depth = 0;                   // held right now
+    size_t max_depth = 0;
+    int64_t last_recovery_ns = 0;       // hole seen -> filled and drained
+    int64_t max_recovery_ns = 0;
+
+    // Combines the sessions of one logical connection (active + standby)
+    FixGapStats& operator+=(const FixGapStats& o) {
+        gaps += o.gaps;
+        held += o.held;
+        overflows += o.overflows;
+        requested += o.requested;
+        rerequests += o.rerequests;
+        depth += o.depth;
+        if (o.max_depth > max_depth) max_depth = o.max_depth;
+        if (o.last_recovery_ns) last_recovery_ns = o.last_recovery_ns;
+        if (o.max_recovery_ns > max_recovery_ns) max_recovery_ns = o.max_recovery_ns;
+        return *this;
+    }
+};
+
+// A fill handed from the I/O thread to the application, nextFill()
+struct FixFillEvent {
+    static const size_t MAX_ID = 38;
+    uint64_t cl_ord_id;
+    double last_qty;
+    double last_px;
+    double cum_qty;
+    double avg_px;
+    int64_t rx_time_ns;
+    FixOrdState state;              // after this fill
+    bool is_buy;
+    uint8_t len;
+    char exec_id[MAX_ID + 1];
+
+    std::string_view execId() const { return std::string_view(exec_id, len); }
+};
+
+// Threading: one I/O thread (FixReactor::run, or whatever thread drives
+// readIntoRing) owns the connection. It alone connects and disconnects,
+// reads the socket, and owns the receive ring, the tag index, inbound
+// sequencing and the gap buffer, ExecID dedup and the order store; none
+// of that takes a lock. Other threads reach it only through
+//   sslWrite()             MPSC outbound queue, any thread
+//   nextClOrdId()          atomic counter, any thread
+//   registerOrder()        SPSC queue, one order thread -> I/O thread
+//   nextFill()             SPSC queue, I/O thread -> one application thread
+//   gapStats()             seqlocked snapshot, any thread
+//   atomics                state, seq numbers, last inbound time
+// mtx_ only serializes the connection lifecycle against the writers'
+// send_mtx_ and the cold accessors (sub id, store).
 class FixSession {
 public:
     enum class State {
@@ -46,9 +127,15 @@ public:
           running_(false),
           gap_recovery_active_(false),
           highest_requested_seq_(0),
-          gap_queue_count_(0),
           last_inbound_ns_(nowNs()),
-          last_resend_request_(std::chrono::steady_clock::now())
+          gap_started_ns_(0),
+          open_resend_from_(0),
+          overflow_seq_(0),
+          stall_seq_(0),
+          stall_since_ns_(0),
+          rx_time_ns_(0),
+          store_(nullptr),
+          next_cl_ord_id_(static_cast<uint64_t>(fixWallClockNs() / 1000))
     {}
 
     ~FixSession() {
@@ -59,6 +146,7 @@ public:
         std::lock_guard<std::mutex> lg(mtx_);
         ssl_ = s;
         sock_ = sock;
+        rx_stamp_.enable(sock);
         state_ = State::Connected;
     }
 
@@ -70,15 +158,18 @@ public:
             ssl_ = nullptr;
         }
         if (sock_ >= 0) {
-#ifdef _WIN32
-            closesocket(sock_);
-#else
-            close(sock_);
-#endif
+            plat::socket_close(sock_);
             sock_ = -1;
         }
         state_ = State::Disconnected;
-        inbound_buffer_.clear();
+        recv_ring_.clear();
+        out_queue_.clear();
+        ktls_rx_ = false;
+        {
+            std::lock_guard<std::mutex> slg(send_mtx_);
+            tx_backlog_.clear();
+            ktls_tx_ = false;
+        }
     }
 
     SSL* ssl() {
@@ -144,22 +235,19 @@ public:
 
     // FIX #3 & #4: Enhanced resetOnReconnect
     // Now properly resets ALL state including heartbeat timer
+    // I/O thread only
     void resetOnReconnect() {
-        std::lock_guard<std::mutex> lg(buffer_mtx_);
-        inbound_buffer_.clear();
+        recv_ring_.clear();
         gap_recovery_active_.store(false, std::memory_order_release);
         highest_requested_seq_.store(0, std::memory_order_release);
-        gap_queue_count_ = 0;
+        open_resend_from_ = 0;
+        overflow_seq_ = 0;
+        gap_buffer_.clear();
         processed_exec_ids_.clear();
-        known_orders_.clear();
-        fill_history_.clear();
-        last_sending_time_.clear();
+        publishGapStats();
         
         // FIX #3: CRITICAL - Reset heartbeat timer on reconnect
         last_inbound_ns_.store(nowNs(), std::memory_order_release);
-        
-        // FIX #4: Reset resend request throttle
-        last_resend_request_ = std::chrono::steady_clock::now();
     }
 
     bool isGapRecoveryActive() const {
@@ -179,28 +267,110 @@ public:
         return target > 0 && current_seq >= target;
     }
 
-    bool incrementGapQueue() {
-        std::lock_guard<std::mutex> lg(buffer_mtx_);
-        if (gap_queue_count_ >= MAX_GAP_QUEUE) {
-            return false;
+    // Sequences one inbound message. A message past a hole is copied into
+    // the gap buffer (or, with keep_bytes false, only its seq is: the caller
+    // handles it now, e.g. the Logon). resend is then set to the part of the
+    // hole not already requested, so each missing range is asked for once.
+    // The first Overflow asks for everything from the first unrequested seq;
+    // until expected passes the dropped seq, holes below it count as asked
+    // for and only the part above it is requested.
+    // I/O thread only, as are nextHeld() and applySequenceReset().
+    FixSeqAction sequenceInbound(int64_t seq, std::string_view msg, FixResendRange& resend,
+                                 bool keep_bytes = true)
+    {
+        int64_t expected = expected_seq_.load(std::memory_order_acquire);
+        if (seq < expected) return FixSeqAction::Duplicate;
+        if (seq == expected) {
+            expected_seq_.store(static_cast<int>(seq + 1), std::memory_order_release);
+            finishRecoveryIfDone();
+            return FixSeqAction::Process;
+        }
+
+        if (!gap_recovery_active_.load(std::memory_order_acquire)) {
+            gap_recovery_active_.store(true, std::memory_order_release);
+            gap_started_ns_ = nowNs();
+            stall_seq_ = expected;
+            stall_since_ns_ = gap_started_ns_;
+            ++gap_stats_.gaps;
+        }
+        // Everything up to the highest requested or held seq is accounted for
+        int64_t requested = highest_requested_seq_.load(std::memory_order_acquire);
+        int64_t covered = requested > gap_buffer_.highest() ? requested : gap_buffer_.highest();
+        int64_t from = covered >= expected ? covered + 1 : expected;
+
+        if (!gap_buffer_.hold(expected, seq, keep_bytes ? msg : std::string_view())) {
+            ++gap_stats_.overflows;
+            if (!open_resend_from_) {
+                resend.begin = from;
+                resend.end = 0;
+                open_resend_from_ = from;
+                overflow_seq_ = seq;
+            }
+            publishGapStats();
+            return FixSeqAction::Overflow;
         }
-        gap_queue_count_++;
+        ++gap_stats_.held;
+        if (gap_buffer_.depth() > gap_stats_.max_depth) gap_stats_.max_depth = gap_buffer_.depth();
+        if (open_resend_from_ && from <= overflow_seq_) from = overflow_seq_ + 1;
+        if (from < seq) {
+            resend.begin = from;
+            resend.end = seq - 1;
+            gap_stats_.requested += static_cast<uint64_t>(seq - from);
+            highest_requested_seq_.store(static_cast<int>(seq - 1), std::memory_order_release);
+        }
+        publishGapStats();
+        return FixSeqAction::Held;
+    }
+
+    // The held message whose turn has come, if any; call after every
+    // Process until false. msg is empty when the caller already handled it,
+    // and valid until the next sequenceInbound().
+    bool nextHeld(std::string_view& msg) {
+        int64_t expected = expected_seq_.load(std::memory_order_acquire);
+        if (!gap_buffer_.pop(expected, msg)) return false;
+        expected_seq_.store(static_cast<int>(expected + 1), std::memory_order_release);
+        if (!finishRecoveryIfDone()) publishGapStats();
         return true;
     }
 
-    void resetGapQueue() {
-        std::lock_guard<std::mutex> lg(buffer_mtx_);
-        gap_queue_count_ = 0;
+    // SequenceReset (35=4): NewSeqNo (36) moves expected forward, never back
+    void applySequenceReset(int64_t new_seq) {
+        if (new_seq <= expected_seq_.load(std::memory_order_acquire)) return;
+        expected_seq_.store(static_cast<int>(new_seq), std::memory_order_release);
+        gap_buffer_.discardBelow(new_seq);
+        if (!finishRecoveryIfDone()) publishGapStats();
     }
 
-    bool canSendResendRequest() {
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - last_resend_request_).count();
-        if (elapsed >= 5) {
-            last_resend_request_ = now;
-            return true;
+    // Any thread: the snapshot the I/O thread last published
+    FixGapStats gapStats() const {
+        return gap_snapshot_.load();
+    }
+
+    // I/O thread, from a periodic timer. A gap whose expected seq has not
+    // moved for stall_ns (one heartbeat interval) is asked for again from
+    // expected through everything outstanding, in case the ResendRequest or
+    // its replay was lost. False while the gap is moving or there is none.
+    bool resendIfStalled(long long stall_ns, FixResendRange& resend) {
+        if (!gap_recovery_active_.load(std::memory_order_relaxed)) return false;
+        int64_t expected = expected_seq_.load(std::memory_order_relaxed);
+        long long now = nowNs();
+        if (expected != stall_seq_) {
+            stall_seq_ = expected;
+            stall_since_ns_ = now;
+            return false;
         }
-        return false;
+        if (now - stall_since_ns_ < stall_ns) return false;
+        stall_since_ns_ = now;
+
+        int64_t requested = highest_requested_seq_.load(std::memory_order_relaxed);
+        int64_t end = gap_buffer_.highest() - 1 > requested ? gap_buffer_.highest() - 1 : requested;
+        if (open_resend_from_) end = 0;
+        else if (end < expected) return false;
+        resend.begin = expected;
+        resend.end = end;
+        ++gap_stats_.rerequests;
+        publishGapStats();
+        return true;
     }
 
     void updateLastInbound() {
@@ -214,8 +384,11 @@ public:
         return diff_sec > static_cast<long long>(heartbeat_interval_sec * 2);
     }
 
+    // I/O thread only; no lock, the owner is also the only one that can
+    // free ssl_ (disconnect). With kernel TLS receive, SSL_read reads the
+    // kernel's plaintext through recvmsg and still handles the non-data
+    // records itself (TLS 1.3 NewSessionTicket, KeyUpdate, alerts).
     int sslRead(char* buffer, int size, bool& should_retry, bool& fatal_error) {
-        std::lock_guard<std::mutex> lg(mtx_);
         if (!ssl_) {
             fatal_error = true;
             return -1;
@@ -251,49 +424,134 @@ public:
         }
     }
 
-    bool sslWrite(const char* data, int size) {
+    // Queues one complete message on the outbound queue. urgent flushes it
+    // (with anything queued ahead of it) at once; otherwise it is coalesced
+    // with later messages until the outbound budget is spent, or until
+    // flushOutbound() / readIntoRing().
+    bool sslWrite(const char* data, int size, bool urgent = false) {
+        if (size <= 0) return false;
+        return out_queue_.push(data, static_cast<size_t>(size), recordWriter(), urgent);
+    }
+
+    bool flushOutbound() {
+        return out_queue_.flush(recordWriter());
+    }
+
+    // Call from timers / idle loops so a non-urgent message never waits
+    // longer than the delay budget
+    bool flushOutboundIfDue() {
+        return out_queue_.flushIfDue(fixWallClockNs(), recordWriter());
+    }
+
+    void setOutboundBudget(const FixOutboundBudget& b) {
+        out_queue_.setBudget(b);
+    }
+
+    FixOutboundStats outboundStats() const {
+        return out_queue_.stats();
+    }
+
+    // One SSL_write per call: a coalesced run of messages becomes one record
+    bool writeRecord(const char* data, int size) {
         std::lock_guard<std::mutex> lg(send_mtx_);
         if (!ssl_) return false;
+        if (non_blocking_) return writeNonBlocking(data, size);
 
         int total = 0;
         while (total < size) {
-            int n = SSL_write(ssl_, data + total, size - total);
+            bool retry = false;
+            int n = writeSome(data + total, size - total, retry);
             if (n > 0) {
                 total += n;
                 continue;
             }
+            if (!retry) return false;
+        }
+        return true;
+    }
 
-            int err = SSL_get_error(ssl_, n);
-            switch (err) {
-                case SSL_ERROR_WANT_READ:
-                case SSL_ERROR_WANT_WRITE:
-                    continue;
-
-                case SSL_ERROR_ZERO_RETURN:
-                case SSL_ERROR_SYSCALL:
-                case SSL_ERROR_SSL:
-                    ERR_print_errors_fp(stderr);
-                    return false;
+    // Non-blocking mode (FixReactor): writes the socket will not take now are
+    // kept in order and retried by flushTxBacklog() when it turns writable.
+    // The SSL must have SSL_MODE_ENABLE_PARTIAL_WRITE and
+    // SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER set.
+    void setNonBlocking(bool nb) {
+        std::lock_guard<std::mutex> lg(send_mtx_);
+        non_blocking_ = nb;
+    }
 
-                default:
-                    return false;
-            }
+    // After the handshake: picks up whichever directions OpenSSL moved into
+    // the kernel (SSL_OP_ENABLE_KTLS, kernel tls module, a kTLS-capable
+    // cipher). An offloaded send goes straight to send(); receive always
+    // stays on SSL_read, which uses the kernel path when it is there.
+    void detectKtls() {
+        std::lock_guard<std::mutex> lg(mtx_);
+        std::lock_guard<std::mutex> slg(send_mtx_);
+#ifndef OPENSSL_NO_KTLS
+        if (ssl_) {
+            ktls_tx_ = BIO_get_ktls_send(SSL_get_wbio(ssl_)) != 0;
+            ktls_rx_ = BIO_get_ktls_recv(SSL_get_rbio(ssl_)) != 0;
         }
-        return true;
+#endif
+    }
+
+    bool ktlsSend() const {
+        return ktls_tx_;
+    }
+
+    bool ktlsRecv() const {
+        return ktls_rx_;
+    }
+
+    bool txBacklogged() const {
+        std::lock_guard<std::mutex> lg(send_mtx_);
+        return !tx_backlog_.empty();
+    }
+
+    // Returns false if the connection failed
+    bool flushTxBacklog() {
+        std::lock_guard<std::mutex> lg(send_mtx_);
+        if (!ssl_) return false;
+        return drainTxBacklog();
+    }
+
+    // Sequence numbers go to the attached FixMessageStore when there is one:
+    // two stores into its mapped header, no file rewrite. Without a store
+    // they are written to filename.
+    void attachStore(FixMessageStore* store) {
+        std::lock_guard<std::mutex> lg(mtx_);
+        store_ = store;
+    }
+
+    FixMessageStore* store() {
+        std::lock_guard<std::mutex> lg(mtx_);
+        return store_;
     }
 
     void saveSequenceState(const std::string& filename) {
         std::lock_guard<std::mutex> lg(mtx_);
+        int seq = seq_.load(std::memory_order_acquire);
+        int exp = expected_seq_.load(std::memory_order_acquire);
+        if (store_ && store_->isOpen()) {
+            store_->setNextOutSeq(seq);
+            store_->setNextInSeq(exp);
+            return;
+        }
         std::ofstream f(filename, std::ios::binary);
         if (f.is_open()) {
-            int seq = seq_.load(std::memory_order_acquire);
-            int exp = expected_seq_.load(std::memory_order_acquire);
             f.write(reinterpret_cast<char*>(&seq), sizeof(seq));
             f.write(reinterpret_cast<char*>(&exp), sizeof(exp));
         }
     }
 
     bool loadSequenceState(const std::string& filename) {
+        {
+            std::lock_guard<std::mutex> lg(mtx_);
+            if (store_ && store_->isOpen()) {
+                seq_.store(static_cast<int>(store_->nextOutSeq()), std::memory_order_release);
+                expected_seq_.store(static_cast<int>(store_->nextInSeq()), std::memory_order_release);
+                return true;
+            }
+        }
         std::ifstream f(filename, std::ios::binary);
         if (!f.is_open()) return false;
 
@@ -309,165 +567,177 @@ public:
         return false;
     }
 
-    bool hasProcessedExec(const std::string& exec_id) {
-        std::lock_guard<std::mutex> lg(buffer_mtx_);
-        return processed_exec_ids_.count(exec_id) > 0;
+    // ExecID dedup over a fixed window (FixExecIdWindow): no allocation,
+    // ids older than the window are forgotten. I/O thread only.
+    bool hasProcessedExec(std::string_view exec_id) {
+        return processed_exec_ids_.contains(exec_id, nowNs());
     }
 
-    void markExecProcessed(const std::string& exec_id) {
-        std::lock_guard<std::mutex> lg(buffer_mtx_);
-        processed_exec_ids_.insert(exec_id);
+    // False if exec_id was already marked
+    bool markExecProcessed(std::string_view exec_id) {
+        return processed_exec_ids_.insert(exec_id, nowNs());
     }
 
-    void registerOrder(const std::string& clOrdId) {
-        std::lock_guard<std::mutex> lg(buffer_mtx_);
-        known_orders_[clOrdId] = true;
+    // ClOrdID (11) for the next 35=D / F / G. Starts at the wall clock in
+    // microseconds, so ids stay unique across restarts within a day.
+    uint64_t nextClOrdId() {
+        return next_cl_ord_id_.fetch_add(1, std::memory_order_relaxed);
     }
 
-    bool isKnownOrder(const std::string& clOrdId) {
-        std::lock_guard<std::mutex> lg(buffer_mtx_);
-        return known_orders_.count(clOrdId) > 0;
+    void seedClOrdId(uint64_t first) {
+        next_cl_ord_id_.store(first, std::memory_order_relaxed);
     }
 
-    bool checkPossDupFlag(const std::string& msg) {
-        size_t pos = msg.find("43=");
-        if (pos != std::string::npos) {
-            char flag = msg[pos + 3];
-            return (flag == 'Y');
-        }
-        return false;
+    // Order thread: queues an order, cancel or replace as it is sent; the
+    // I/O thread adds it to the order store before the next report. False
+    // if the queue is full (the I/O thread is not reading); the caller retries.
+    bool registerOrder(const FixOrderNote& note) {
+        return note.id != 0 && order_notes_.push(note);
     }
 
-    bool validateSendingTime(const std::string& msg) {
-        size_t pos = msg.find("52=");
-        if (pos == std::string::npos) {
-            std::cerr << "[FIX] Missing SendingTime (52)\n";
-            return false;
-        }
-
-        size_t end = msg.find("\x01", pos);
-        if (end == std::string::npos) return false;
-
-        std::string sending_time_str = msg.substr(pos + 3, end - (pos + 3));
-
-        if (sending_time_str.length() < 17) {
-            std::cerr << "[FIX] Malformed SendingTime: " << sending_time_str << "\n";
-            return false;
-        }
+    // I/O thread only, as are the order store calls below
+    const FixOrder* findOrder(uint64_t cl_ord_id) {
+        drainOrderNotes();
+        return orders_.find(cl_ord_id);
+    }
 
-        if (!last_sending_time_.empty()) {
-            if (sending_time_str < last_sending_time_) {
-                std::cerr << "[FIX] SendingTime regression: "
-                          << sending_time_str << " < " << last_sending_time_ << "\n";
-                return false;
-            }
+    // 35=8: updates the order 11 names and queues a FixFillEvent for a
+    // trade. Null if the order is not in the store. Callers dedup the
+    // ExecID (markExecProcessed) first.
+    const FixOrder* applyExecutionReport(const FixTagIndex& idx) {
+        drainOrderNotes();
+        FixOrderFill fill;
+        const FixOrder* o = orders_.onExecutionReport(idx, rx_time_ns_, fill);
+        if (o && fill.qty > 0) {
+            FixFillEvent ev;
+            ev.cl_ord_id = o->id;
+            ev.last_qty = static_cast<double>(fill.qty) / fixPow10(FixOrder::QTY_DIGITS);
+            ev.last_px = fill.px;
+            ev.cum_qty = o->cumQtyValue();
+            ev.avg_px = o->avg_px;
+            ev.rx_time_ns = rx_time_ns_;
+            ev.state = o->state;
+            ev.is_buy = o->side == '1';
+            std::string_view exec_id = idx.get(17);
+            ev.len = static_cast<uint8_t>(exec_id.size() < FixFillEvent::MAX_ID ? exec_id.size() : FixFillEvent::MAX_ID);
+            std::memcpy(ev.exec_id, exec_id.data(), ev.len);
+            ev.exec_id[ev.len] = '\0';
+            if (!fills_.push(ev)) ++fills_dropped_;
         }
+        return o;
+    }
 
-        last_sending_time_ = sending_time_str;
-        return true;
+    // 35=9: a cancel or replace was refused
+    const FixOrder* applyCancelReject(const FixTagIndex& idx) {
+        drainOrderNotes();
+        return orders_.onCancelReject(idx, rx_time_ns_);
     }
 
-    void recordFill(const std::string& execId, double qty, double price, bool is_buy) {
-        std::lock_guard<std::mutex> lg(buffer_mtx_);
-        fill_history_[execId] = std::make_tuple(qty, price, is_buy);
+    // Fill events lost because the application was not draining nextFill()
+    uint64_t fillsDropped() const {
+        return fills_dropped_;
     }
 
-    bool getFillDetails(const std::string& execId, double& qty, double& price, bool& is_buy) {
-        std::lock_guard<std::mutex> lg(buffer_mtx_);
-        auto it = fill_history_.find(execId);
-        if (it == fill_history_.end()) return false;
+    // Validators query the per-message tag index built by forEachCompleteMessage()
+    bool checkPossDupFlag(const FixTagIndex& idx) const {
+        return idx.getChar(43) == 'Y';
+    }
 
-        std::tie(qty, price, is_buy) = it->second;
-        return true;
+    // Stage durations of the current connection; written by whoever drives
+    // the connect (FixReactor for TCP/TLS, the application for DNS/Logon)
+    FixConnectTiming& connectTiming() {
+        return connect_timing_;
     }
 
-    void removeFill(const std::string& execId) {
-        std::lock_guard<std::mutex> lg(buffer_mtx_);
-        processed_exec_ids_.erase(execId);
-        fill_history_.erase(execId);
+    // Receive time (epoch ns) of the read that delivered the current messages
+    int64_t rxTimeNs() const {
+        return rx_time_ns_;
     }
 
-    void appendToBuffer(const char* data, int size) {
-        std::lock_guard<std::mutex> lg(buffer_mtx_);
-        inbound_buffer_.append(data, size);
+    // The one application thread that consumes fills
+    bool nextFill(FixFillEvent& ev) {
+        return fills_.pop(ev);
     }
 
-    std::vector<std::string> extractCompleteMessages() {
-        std::lock_guard<std::mutex> lg(buffer_mtx_);
-        std::vector<std::string> messages;
+    // Reads straight from SSL into the receive ring (no intermediate copy).
+    // I/O thread only, like forEachCompleteMessage(); neither takes a lock.
+    // Each read is stamped with the kernel receive time when available;
+    // bytes already decrypted inside OpenSSL keep the previous stamp.
+    int readIntoRing(bool& should_retry, bool& fatal_error) {
+        char* dst = recv_ring_.writePtr();
+        int room = static_cast<int>(recv_ring_.writable());
+        if (room == 0) {
+            fatal_error = true;
+            state_.store(State::Error, std::memory_order_release);
+            return -1;
+        }
+        if (ssl_ && SSL_pending(ssl_) == 0) {
+            // About to block: nothing queued should wait on the peer
+            flushOutbound();
+            rx_time_ns_ = rx_stamp_.stamp(sock_);
+        }
+        int n = sslRead(dst, room, should_retry, fatal_error);
+        if (n > 0) {
+            recv_ring_.commit(static_cast<size_t>(n));
+        }
+        return n;
+    }
 
-        const size_t MAX_FIX_MESSAGE_SIZE = 65536;
+    // Frames every complete message currently buffered, tokenizes it once into
+    // the session tag index and passes it to fn(std::string_view) or
+    // fn(std::string_view, const FixTagIndex&). Views point into the ring and
+    // stay valid until the next readIntoRing()/appendToBuffer(). Returns the
+    // number delivered.
+    template <typename Fn>
+    size_t forEachCompleteMessage(Fn&& fn) {
+        size_t delivered = 0;
+        std::string_view msg;
 
         while (true) {
-            size_t start = inbound_buffer_.find("8=FIX");
-            if (start == std::string::npos) {
-                inbound_buffer_.clear();
-                break;
-            }
-
-            if (start > 0) {
-                inbound_buffer_.erase(0, start);
-            }
-
-            size_t body_len_pos = inbound_buffer_.find("9=");
-            if (body_len_pos == std::string::npos) break;
-
-            size_t body_len_end = inbound_buffer_.find("\x01", body_len_pos);
-            if (body_len_end == std::string::npos) break;
-
-            int body_length = 0;
-            try {
-                std::string body_len_str = inbound_buffer_.substr(
-                    body_len_pos + 2,
-                    body_len_end - (body_len_pos + 2)
-                );
-                body_length = std::stoi(body_len_str);
-
-                if (body_length < 0 || body_length > static_cast<int>(MAX_FIX_MESSAGE_SIZE)) {
-                    inbound_buffer_.clear();
-                    state_.store(State::Error, std::memory_order_release);
-                    return messages;
-                }
-            } catch (...) {
-                inbound_buffer_.erase(0, body_len_end + 1);
-                continue;
-            }
+            FixRecvRing::Frame f = recv_ring_.next(msg);
+            if (f == FixRecvRing::Frame::NeedMore) break;
 
-            size_t body_start = body_len_end + 1;
-            size_t checksum_length = 7;
-            size_t expected_total = body_start + static_cast<size_t>(body_length) + checksum_length;
-
-            if (inbound_buffer_.size() < expected_total) break;
-
-            std::string msg = inbound_buffer_.substr(0, expected_total);
-
-            if (!validateChecksum(msg)) {
-                inbound_buffer_.clear();
+            if (f == FixRecvRing::Frame::Malformed ||
+                !rx_index_.parse(msg) ||
+                !validateChecksum(rx_index_)) {
+                recv_ring_.clear();
                 state_.store(State::Error, std::memory_order_release);
-                return messages;
+                break;
             }
 
             // FIX #3: AUTO inbound timestamp update for every validated FIX message
             // This ensures heartbeat timeout is properly managed
             updateLastInbound();
 
-            messages.push_back(msg);
-            inbound_buffer_.erase(0, expected_total);
+            if constexpr (std::is_invocable_v<Fn&, std::string_view, const FixTagIndex&>) {
+                fn(msg, static_cast<const FixTagIndex&>(rx_index_));
+            } else {
+                fn(msg);
+            }
+            ++delivered;
         }
 
-        return messages;
+        return delivered;
     }
 
-    bool checkResetSeqNumFlag(const std::string& msg) {
-        size_t pos = msg.find("141=");
-        if (pos != std::string::npos) {
-            size_t end = msg.find("\x01", pos);
-            if (end != std::string::npos) {
-                char flag = msg[pos + 4];
-                return (flag == 'Y');
-            }
+    void appendToBuffer(const char* data, int size) {
+        if (!recv_ring_.append(data, static_cast<size_t>(size))) {
+            recv_ring_.clear();
+            state_.store(State::Error, std::memory_order_release);
         }
-        return false;
+    }
+
+    // Compatibility wrapper: copies each framed message out of the ring.
+    std::vector<std::string> extractCompleteMessages() {
+        std::vector<std::string> messages;
+        forEachCompleteMessage([&messages](std::string_view msg) {
+            messages.emplace_back(msg);
+        });
+        return messages;
+    }
+
+    bool checkResetSeqNumFlag(const FixTagIndex& idx) const {
+        return idx.getChar(141) == 'Y';
     }
 
     // FIX #4: Complete state reset on ResetSeqNumFlag
@@ -479,40 +749,146 @@ public:
         // FIX #4: Reset gap recovery state
         gap_recovery_active_.store(false, std::memory_order_release);
         highest_requested_seq_.store(0, std::memory_order_release);
+        open_resend_from_ = 0;
+        overflow_seq_ = 0;
         
-        std::lock_guard<std::mutex> lg(buffer_mtx_);
-        gap_queue_count_ = 0;
-        
-        // FIX #4: Reset resend request throttle
-        last_resend_request_ = std::chrono::steady_clock::now();
+        gap_buffer_.clear();
+        publishGapStats();
         
         // FIX #3: Reset heartbeat timer
         last_inbound_ns_.store(nowNs(), std::memory_order_release);
     }
 
 private:
-    bool validateChecksum(const std::string& msg) {
-        size_t cs_pos = msg.rfind("10=");
-        if (cs_pos == std::string::npos) return false;
+    // Recovery ends once everything requested has arrived (past the dropped
+    // seq, after an Overflow) and nothing is left waiting behind a hole.
+    // True if it just ended (stats published).
+    bool finishRecoveryIfDone() {
+        if (!gap_recovery_active_.load(std::memory_order_relaxed) || !gap_buffer_.empty()) return false;
+        int64_t expected = expected_seq_.load(std::memory_order_relaxed);
+        if (expected <= highest_requested_seq_.load(std::memory_order_relaxed)) return false;
+        if (open_resend_from_ && expected <= overflow_seq_) return false;
+        int64_t took = nowNs() - gap_started_ns_;
+        gap_stats_.last_recovery_ns = took;
+        if (took > gap_stats_.max_recovery_ns) gap_stats_.max_recovery_ns = took;
+        gap_recovery_active_.store(false, std::memory_order_release);
+        highest_requested_seq_.store(0, std::memory_order_release);
+        open_resend_from_ = 0;
+        overflow_seq_ = 0;
+        publishGapStats();
+        return true;
+    }
+
+    void drainOrderNotes() {
+        FixOrderNote note;
+        while (order_notes_.pop(note)) orders_.add(note, rx_time_ns_);
+    }
+
+    // I/O thread: makes the current counters visible to gapStats()
+    void publishGapStats() {
+        gap_stats_.depth = gap_buffer_.depth();
+        gap_snapshot_.store(gap_stats_);
+    }
 
-        size_t cs_end = msg.find("\x01", cs_pos);
-        if (cs_end == std::string::npos) return false;
+    // CheckSum (10) must be the last field; it covers every byte before its tag
+    bool validateChecksum(const FixTagIndex& idx) const {
+        size_t n = idx.fieldCount();
+        if (n == 0) return false;
 
-        std::string cs_str = msg.substr(cs_pos + 3, cs_end - (cs_pos + 3));
+        const FixTagIndex::Field& cs = idx.field(n - 1);
+        if (cs.tag != 10 || cs.length != 3) return false;
+
+        std::string_view msg = idx.message();
         int expected_checksum = 0;
-        try {
-            expected_checksum = std::stoi(cs_str);
-        } catch (...) {
+        for (size_t i = cs.offset; i < cs.offset + 3; ++i) {
+            unsigned d = static_cast<unsigned char>(msg[i]) - '0';
+            if (d > 9) return false;
+            expected_checksum = expected_checksum * 10 + static_cast<int>(d);
+        }
+
+        unsigned actual_checksum = fixChecksum(msg.data(), cs.offset - 3);
+
+        return (static_cast<int>(actual_checksum) == expected_checksum);
+    }
+
+    // send_mtx_ held
+    bool writeNonBlocking(const char* data, int size) {
+        if (!tx_backlog_.empty()) {
+            tx_backlog_.append(data, static_cast<size_t>(size));
+            return drainTxBacklog();
+        }
+        int total = 0;
+        while (total < size) {
+            bool retry = false;
+            int n = writeSome(data + total, size - total, retry);
+            if (n > 0) {
+                total += n;
+                continue;
+            }
+            if (retry) {
+                tx_backlog_.append(data + total, static_cast<size_t>(size - total));
+                return true;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    // send_mtx_ held
+    bool drainTxBacklog() {
+        size_t done = 0;
+        while (done < tx_backlog_.size()) {
+            bool retry = false;
+            int n = writeSome(tx_backlog_.data() + done, static_cast<int>(tx_backlog_.size() - done), retry);
+            if (n > 0) {
+                done += static_cast<size_t>(n);
+                continue;
+            }
+            if (retry) break;
+            tx_backlog_.clear();
             return false;
         }
+        tx_backlog_.erase(0, done);
+        return true;
+    }
+
+    // One write attempt, send_mtx_ held. With kernel TLS the plaintext goes
+    // straight to send() and the kernel frames and encrypts it; otherwise
+    // SSL_write. Returns bytes written, or 0 with retry set when the socket
+    // is full (WANT_READ / WANT_WRITE / EAGAIN), -1 on failure.
+    int writeSome(const char* data, int size, bool& retry) {
+        retry = false;
+        if (ktls_tx_) {
+            int n = plat::socket_send(sock_, data, size);
+            if (n > 0) return n;
+            if (n < 0 && plat::would_block(plat::last_error())) {
+                retry = true;
+                return 0;
+            }
+            return -1;
+        }
+
+        int n = SSL_write(ssl_, data, size);
+        if (n > 0) return n;
+        int err = SSL_get_error(ssl_, n);
+        if (err == SSL_ERROR_WANT_WRITE || err == SSL_ERROR_WANT_READ) {
+            retry = true;
+            return 0;
+        }
+        ERR_print_errors_fp(stderr);
+        return -1;
+    }
 
-        int actual_checksum = 0;
-        for (size_t i = 0; i < cs_pos; ++i) {
-            actual_checksum += static_cast<unsigned char>(msg[i]);
+    // Writer handed to out_queue_: one writeRecord() per drained record
+    struct RecordWriter {
+        FixSession* session;
+        bool operator()(const char* data, size_t size) const {
+            return session->writeRecord(data, static_cast<int>(size));
         }
-        actual_checksum %= 256;
+    };
 
-        return (actual_checksum == expected_checksum);
+    RecordWriter recordWriter() {
+        return RecordWriter{this};
     }
 
     static long long nowNs() {
@@ -528,20 +904,37 @@ private:
     std::atomic<bool> gap_recovery_active_;
     std::atomic<int> highest_requested_seq_;
     std::atomic<long long> last_inbound_ns_;
-    std::chrono::steady_clock::time_point last_resend_request_;
     mutable std::mutex mtx_;
-    mutable std::mutex buffer_mtx_;
     mutable std::mutex send_mtx_;
     std::string sub_id_;
-    std::string inbound_buffer_;
-    std::unordered_set<std::string> processed_exec_ids_;
-    std::unordered_map<std::string, bool> known_orders_;
-    std::unordered_map<std::string, std::tuple<double, double, bool>> fill_history_;
-    int gap_queue_count_;
-    std::string last_sending_time_;
-
-    static const int MAX_GAP_QUEUE = 10000;
-    static const int MAX_SENDING_TIME_DRIFT_SEC = 120;
+    FixRecvRing recv_ring_;
+    FixTagIndex rx_index_;
+    FixOutboundQueue out_queue_;
+    std::string tx_backlog_;        // non-blocking only, guarded by send_mtx_
+    bool non_blocking_ = false;
+    bool ktls_tx_ = false;          // guarded by send_mtx_
+    bool ktls_rx_ = false;          // I/O thread
+    FixConnectTiming connect_timing_;
+    // I/O thread
+    FixExecIdWindow processed_exec_ids_;
+    FixOrderStore orders_;          // kept across reconnects: the orders live at the broker
+    uint64_t fills_dropped_ = 0;
+    FixGapBuffer gap_buffer_;
+    FixGapStats gap_stats_;
+    // Cross-thread
+    FixSpscQueue<FixOrderNote, 1024> order_notes_;     // order thread -> I/O thread
+    FixSpscQueue<FixFillEvent, 1024> fills_;           // I/O thread -> application
+    FixSeqlock<FixGapStats> gap_snapshot_;
+    long long gap_started_ns_;
+    int64_t open_resend_from_;      // open-ended ResendRequest (16=0) from here, 0 = none
+    int64_t overflow_seq_;          // the dropped seq that prompted it
+    int64_t stall_seq_;             // expected when resendIfStalled() last saw it move
+    long long stall_since_ns_;
+    FixRxTimestamp rx_stamp_;
+    int64_t rx_time_ns_;
+    FixMessageStore* store_;        // outbound history and seq numbers, optional
+    std::atomic<uint64_t> next_cl_ord_id_;
+
 };
 
 } // namespace chimera
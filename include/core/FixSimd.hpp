@@ -0,0 +1,294 @@
+#pragma once
+
+// ChimeraMetals
+// FixSimd.hpp - Vectorized FIX checksum and delimiter kernels with runtime dispatch
+//
+// Two kernels sit under every inbound and outbound message:
+//   byteSum   - sum of bytes for CheckSum (10), via SAD against zero
+//   delimMask - SOH / '=' bitmasks for one 64-byte block, used by FixTagIndex
+// SSE2 is the x86-64 baseline; AVX2 and AVX-512BW are picked once at startup
+// when the CPU and OS support them. Every level returns bit-identical results
+// to the scalar fallback. CHIMERA_SIMD=scalar|sse2|avx2|avx512 overrides
+// (clamped to the CPU); any other value keeps the best available.
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CHIMERA_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define CHIMERA_TARGET(x)
+#else
+#define CHIMERA_TARGET(x) __attribute__((target(x)))
+#endif
+
+namespace chimera {
+
+enum class SimdLevel {
+    Scalar = 0,
+    SSE2 = 1,
+    AVX2 = 2,
+    AVX512BW = 3
+};
+
+struct FixSimdKernels {
+    SimdLevel level;
+    uint32_t (*byteSum)(const char* p, size_t n);
+    void (*delimMask)(const char* block64, uint64_t& soh, uint64_t& eq);
+};
+
+namespace fix_simd_detail {
+
+inline uint32_t byteSumScalar(const char* p, size_t n) {
+    uint32_t sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += static_cast<unsigned char>(p[i]);
+    }
+    return sum;
+}
+
+inline void delimMaskScalar(const char* p, uint64_t& soh, uint64_t& eq) {
+    uint64_t s = 0, e = 0;
+    for (int i = 0; i < 64; ++i) {
+        s |= static_cast<uint64_t>(p[i] == '\x01') << i;
+        e |= static_cast<uint64_t>(p[i] == '=') << i;
+    }
+    soh = s;
+    eq = e;
+}
+
+#ifdef CHIMERA_SIMD_X86
+
+CHIMERA_TARGET("sse2")
+inline uint32_t byteSumSSE2(const char* p, size_t n) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(v, zero));
+    }
+    uint32_t sum = static_cast<uint32_t>(_mm_cvtsi128_si32(acc)) +
+                   static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_unpackhi_epi64(acc, acc)));
+    return sum + byteSumScalar(p + i, n - i);
+}
+
+CHIMERA_TARGET("sse2")
+inline void delimMaskSSE2(const char* p, uint64_t& soh, uint64_t& eq) {
+    const __m128i vsoh = _mm_set1_epi8('\x01');
+    const __m128i veq = _mm_set1_epi8('=');
+    uint64_t s = 0, e = 0;
+    for (int i = 0; i < 4; ++i) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * 16));
+        s |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, vsoh)))) << (i * 16);
+        e |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, veq)))) << (i * 16);
+    }
+    soh = s;
+    eq = e;
+}
+
+CHIMERA_TARGET("avx2")
+inline uint32_t byteSumAVX2(const char* p, size_t n) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(v, zero));
+    }
+    __m128i lo = _mm256_castsi256_si128(acc);
+    __m128i hi = _mm256_extracti128_si256(acc, 1);
+    __m128i s = _mm_add_epi64(lo, hi);
+    uint32_t sum = static_cast<uint32_t>(_mm_cvtsi128_si32(s)) +
+                   static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_unpackhi_epi64(s, s)));
+    return sum + byteSumScalar(p + i, n - i);
+}
+
+CHIMERA_TARGET("avx2")
+inline void delimMaskAVX2(const char* p, uint64_t& soh, uint64_t& eq) {
+    const __m256i vsoh = _mm256_set1_epi8('\x01');
+    const __m256i veq = _mm256_set1_epi8('=');
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+    soh = static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, vsoh)))) |
+          (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(b, vsoh)))) << 32);
+    eq = static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, veq)))) |
+         (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(b, veq)))) << 32);
+}
+
+CHIMERA_TARGET("avx512f,avx512bw")
+inline uint32_t byteSumAVX512(const char* p, size_t n) {
+    const __m512i zero = _mm512_setzero_si512();
+    __m512i acc = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m512i v = _mm512_loadu_si512(reinterpret_cast<const void*>(p + i));
+        acc = _mm512_add_epi64(acc, _mm512_sad_epu8(v, zero));
+    }
+    alignas(64) uint64_t lanes[8];
+    _mm512_store_si512(reinterpret_cast<void*>(lanes), acc);
+    uint64_t sum = 0;
+    for (uint64_t v : lanes) sum += v;
+    return static_cast<uint32_t>(sum) + byteSumAVX2(p + i, n - i);
+}
+
+CHIMERA_TARGET("avx512f,avx512bw")
+inline void delimMaskAVX512(const char* p, uint64_t& soh, uint64_t& eq) {
+    __m512i v = _mm512_loadu_si512(reinterpret_cast<const void*>(p));
+    soh = _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('\x01'));
+    eq = _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('='));
+}
+
+inline SimdLevel detectCpu() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int r[4];
+    __cpuid(r, 0);
+    int max_leaf = r[0];
+    __cpuid(r, 1);
+    bool osxsave = (r[2] & (1 << 27)) != 0;
+    bool avx = (r[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || max_leaf < 7) return SimdLevel::SSE2;
+    unsigned long long xcr0 = _xgetbv(0);
+    if ((xcr0 & 0x6) != 0x6) return SimdLevel::SSE2;
+    __cpuidex(r, 7, 0);
+    bool avx2 = (r[1] & (1 << 5)) != 0;
+    bool avx512f = (r[1] & (1 << 16)) != 0;
+    bool avx512bw = (r[1] & (1 << 30)) != 0;
+    if (avx512f && avx512bw && (xcr0 & 0xE6) == 0xE6) return SimdLevel::AVX512BW;
+    return avx2 ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512f")) return SimdLevel::AVX512BW;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    return SimdLevel::SSE2;
+#endif
+}
+
+#else
+
+inline SimdLevel detectCpu() {
+    return SimdLevel::Scalar;
+}
+
+#endif
+
+} // namespace fix_simd_detail
+
+// Kernels for an explicit level, clamped to what the CPU supports
+inline FixSimdKernels fixSimdKernels(SimdLevel want) {
+    SimdLevel have = fix_simd_detail::detectCpu();
+    SimdLevel level = static_cast<int>(want) < static_cast<int>(have) ? want : have;
+
+    switch (level) {
+#ifdef CHIMERA_SIMD_X86
+        case SimdLevel::AVX512BW:
+            return {level, fix_simd_detail::byteSumAVX512, fix_simd_detail::delimMaskAVX512};
+        case SimdLevel::AVX2:
+            return {level, fix_simd_detail::byteSumAVX2, fix_simd_detail::delimMaskAVX2};
+        case SimdLevel::SSE2:
+            return {level, fix_simd_detail::byteSumSSE2, fix_simd_detail::delimMaskSSE2};
+#endif
+        default:
+            return {SimdLevel::Scalar, fix_simd_detail::byteSumScalar, fix_simd_detail::delimMaskScalar};
+    }
+}
+
+// Process-wide kernels, selected on first use
+inline const FixSimdKernels& fixSimd() {
+    static const FixSimdKernels kernels = [] {
+        SimdLevel want = SimdLevel::AVX512BW;
+        if (const char* env = std::getenv("CHIMERA_SIMD")) {
+            if (std::strcmp(env, "scalar") == 0) want = SimdLevel::Scalar;
+            else if (std::strcmp(env, "sse2") == 0) want = SimdLevel::SSE2;
+            else if (std::strcmp(env, "avx2") == 0) want = SimdLevel::AVX2;
+            else if (std::strcmp(env, "avx512") == 0) want = SimdLevel::AVX512BW;
+        }
+        return fixSimdKernels(want);
+    }();
+    return kernels;
+}
+
+inline const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SSE2: return "SSE2";
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::AVX512BW: return "AVX-512BW";
+        default: return "scalar";
+    }
+}
+
+// Forward-only cursor over a message's SOH/'=' bitmasks, one 64-byte block
+// at a time. The final partial block is zero-padded, so positions past the
+// end never match.
+class FixDelimCursor {
+public:
+    FixDelimCursor(const char* base, size_t n, const FixSimdKernels& k = fixSimd())
+        : base_(base),
+          n_(n),
+          kernels_(k),
+          block_(static_cast<size_t>(-1)),
+          soh_(0),
+          eq_(0)
+    {}
+
+    // Position of the next SOH at or after from, or size() if none
+    size_t nextSoh(size_t from) {
+        return find(from, true);
+    }
+
+    // Position of the next '=' at or after from, or size() if none
+    size_t nextEq(size_t from) {
+        return find(from, false);
+    }
+
+    size_t size() const {
+        return n_;
+    }
+
+private:
+    void load(size_t b) {
+        size_t off = b << 6;
+        if (off + 64 <= n_) {
+            kernels_.delimMask(base_ + off, soh_, eq_);
+        } else {
+            char tail[64] = {};
+            std::memcpy(tail, base_ + off, n_ - off);
+            kernels_.delimMask(tail, soh_, eq_);
+        }
+        block_ = b;
+    }
+
+    size_t find(size_t from, bool soh) {
+        while (from < n_) {
+            size_t b = from >> 6;
+            if (b != block_) load(b);
+            uint64_t m = (soh ? soh_ : eq_) >> (from & 63);
+            if (m) return from + static_cast<size_t>(std::countr_zero(m));
+            from = (b + 1) << 6;
+        }
+        return n_;
+    }
+
+    const char* base_;
+    size_t n_;
+    const FixSimdKernels& kernels_;
+    size_t block_;
+    uint64_t soh_;
+    uint64_t eq_;
+};
+
+// FIX CheckSum (10): sum of every byte before "10=", modulo 256
+inline unsigned fixChecksum(const char* p, size_t n) {
+    return fixSimd().byteSum(p, n) % 256;
+}
+
+} // namespace chimera
@@ -0,0 +1,47 @@
+#pragma once
+
+// ChimeraMetals
+// FixSpin.hpp - Spin-wait backoff for busy-polling receive loops
+//
+// A polling loop that finds nothing calls pause(): it issues 1, 2, 4 ...
+// up to MAX_PAUSES CPU pause hints, so an idle spinner backs off the
+// sibling hyperthread and the memory bus without giving up the core. Any
+// hit calls reset(). On x86 this is _mm_pause (~40-140 cycles each,
+// depending on the microarchitecture); on ARM a yield hint.
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace chimera {
+
+inline void fixCpuPause() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+class FixSpinBackoff {
+public:
+    static const uint32_t MAX_PAUSES = 64;
+
+    FixSpinBackoff() : pauses_(1) {}
+
+    void pause() {
+        for (uint32_t i = 0; i < pauses_; ++i) fixCpuPause();
+        if (pauses_ < MAX_PAUSES) pauses_ <<= 1;
+    }
+
+    void reset() {
+        pauses_ = 1;
+    }
+
+private:
+    uint32_t pauses_;
+};
+
+} // namespace chimera
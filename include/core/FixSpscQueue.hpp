@@ -0,0 +1,74 @@
+#pragma once
+
+// ChimeraMetals
+// FixSpscQueue.hpp - Bounded single-producer / single-consumer ring
+//
+// Hands fixed-size records from one thread to exactly one other: the
+// producer owns the tail, the consumer owns the head, each on its own cache
+// line with a private copy of the other side's index, so a push or pop
+// touches shared state only when the cached index says the ring looks full
+// or empty. No CAS, no lock, no allocation after construction. Used where a
+// FixSession's I/O thread exchanges data with one application thread.
+//
+// T must be trivially copyable (records are copied in and out by value).
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace chimera {
+
+template <typename T, size_t N>
+class FixSpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "records are copied by value");
+
+public:
+    FixSpscQueue() : head_(0), tail_cache_(0), tail_(0), head_cache_(0) {}
+
+    FixSpscQueue(const FixSpscQueue&) = delete;
+    FixSpscQueue& operator=(const FixSpscQueue&) = delete;
+
+    // Producer thread only. False if the ring is full.
+    bool push(const T& v) {
+        uint64_t t = tail_.load(std::memory_order_relaxed);
+        if (t - head_cache_ == N) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (t - head_cache_ == N) return false;
+        }
+        slots_[t & (N - 1)] = v;
+        tail_.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only. False if the ring is empty.
+    bool pop(T& out) {
+        uint64_t h = head_.load(std::memory_order_relaxed);
+        if (h == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (h == tail_cache_) return false;
+        }
+        out = slots_[h & (N - 1)];
+        head_.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Either side; exact only when the other side is idle
+    size_t size() const {
+        return static_cast<size_t>(tail_.load(std::memory_order_acquire) -
+                                   head_.load(std::memory_order_acquire));
+    }
+
+    bool empty() const { return size() == 0; }
+    static size_t capacity() { return N; }
+
+private:
+    alignas(64) std::atomic<uint64_t> head_;    // consumer line
+    uint64_t tail_cache_;
+    alignas(64) std::atomic<uint64_t> tail_;    // producer line
+    uint64_t head_cache_;
+    alignas(64) T slots_[N];
+};
+
+} // namespace chimera
@@ -0,0 +1,202 @@
+#pragma once
+
+// ChimeraMetals
+// FixSymbolDirectory.hpp - Configured symbols with dense handles, from 35=y
+//
+// The symbols to trade come from config.ini as a list of names (or cTrader
+// numeric ids) and each gets a handle in list order: 0, 1, 2, ... Those
+// handles index everything downstream (quote cache, telemetry, order
+// entry), so adding XPTUSD or XPDUSD is a config change, not a recompile.
+//
+// The SecurityList (35=y) fills in what the venue says about each one:
+//   55 Symbol (numeric id)  1007 SymbolName  1008 SymbolDigits
+//   969 MinPriceIncrement   231 ContractMultiplier
+// cTrader sends only the first three; tick size then defaults to one unit
+// of the last digit and contract size to 1.
+//
+// configure() runs before the sessions start and loadSecurityList() on the
+// quote thread. The first list fixes every symbol's venue fields; later ones
+// (after a reconnect) are matched but never rewrite them, so other threads
+// may read any symbol once ready().
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "FixMdDecoder.hpp"
+#include "FixNumeric.hpp"
+#include "FixTagIndex.hpp"
+
+namespace chimera {
+
+using FixSymbolHandle = uint16_t;
+constexpr FixSymbolHandle FIX_NO_SYMBOL = 0xFFFF;
+
+struct FixSymbol {
+    std::string name;               // as configured, 1007 once listed
+    int64_t id = -1;                // 55, -1 until the SecurityList names it
+    int digits = FixPricePrecision::DEFAULT_DIGITS;
+    double tick_size = 0.0;
+    double contract_size = 1.0;
+    bool listed = false;
+};
+
+class FixSymbolDirectory {
+public:
+    static const size_t MAX_SYMBOLS = 64;
+    // NoRelatedSym entries per MarketDataRequest
+    static const size_t MAX_PER_REQUEST = 32;
+
+    FixSymbolDirectory() : count_(0), listed_(0), ready_(false) {
+        for (uint32_t i = 0; i < FixPricePrecision::MAX_SYMBOL_ID; ++i) by_id_[i] = FIX_NO_SYMBOL;
+    }
+
+    FixSymbolDirectory(const FixSymbolDirectory&) = delete;
+    FixSymbolDirectory& operator=(const FixSymbolDirectory&) = delete;
+
+    // "XAUUSD, XAGUSD, XPTUSD" (commas and/or spaces). Returns the number of
+    // symbols added; duplicates and entries past MAX_SYMBOLS are ignored.
+    size_t configure(std::string_view list) {
+        size_t before = count_;
+        size_t i = 0;
+        while (i < list.size()) {
+            while (i < list.size() && isSeparator(list[i])) ++i;
+            size_t start = i;
+            while (i < list.size() && !isSeparator(list[i])) ++i;
+            if (i > start) add(list.substr(start, i - start));
+        }
+        return count_ - before;
+    }
+
+    // Handle of name, adding it if new; FIX_NO_SYMBOL when full
+    FixSymbolHandle add(std::string_view name) {
+        FixSymbolHandle h = byName(name);
+        if (h != FIX_NO_SYMBOL || count_ == MAX_SYMBOLS) return h;
+        FixSymbol& s = symbols_[count_];
+        s = FixSymbol();
+        s.name = std::string(name);
+        s.tick_size = 1.0 / static_cast<double>(fixPow10(s.digits));
+        // A numeric entry is already the venue id
+        int64_t id = 0;
+        if (parseFixInt(name, id) == FixNumError::None) setId(static_cast<FixSymbolHandle>(count_), id);
+        return static_cast<FixSymbolHandle>(count_++);
+    }
+
+    // Matches each NoRelatedSym entry against the configured symbols by name
+    // or numeric id. Returns the number matched; ready() from then on, and
+    // the directory no longer changes.
+    size_t loadSecurityList(const FixTagIndex& idx) {
+        bool frozen = ready();
+        size_t matched = 0;
+        Entry e;
+        for (size_t i = 0; i < idx.fieldCount(); ++i) {
+            uint32_t tag = idx.field(i).tag;
+            std::string_view v = idx.value(i);
+            if (tag == 55) {
+                matched += apply(e, frozen);
+                e = Entry();
+                e.id_text = v;
+                if (parseFixInt(v, e.id) != FixNumError::None) e.id = -1;
+            } else if (e.id >= 0) {
+                int64_t n = 0;
+                if (tag == 1007) e.name = v;
+                else if (tag == 1008 && parseFixInt(v, n) == FixNumError::None) e.digits = static_cast<int>(n);
+                else if (tag == 969 && parseFixPrice(v, FIX_MAX_DIGITS, n) == FixNumError::None)
+                    e.tick_size = static_cast<double>(n) / fixPow10(FIX_MAX_DIGITS);
+                else if (tag == 231 && parseFixPrice(v, FIX_MAX_DIGITS, n) == FixNumError::None)
+                    e.contract_size = static_cast<double>(n) / fixPow10(FIX_MAX_DIGITS);
+            }
+        }
+        matched += apply(e, frozen);
+        ready_.store(true, std::memory_order_release);
+        return matched;
+    }
+
+    FixSymbolHandle byId(int64_t id) const {
+        if (id < 0 || id >= FixPricePrecision::MAX_SYMBOL_ID) return FIX_NO_SYMBOL;
+        return by_id_[id];
+    }
+
+    FixSymbolHandle byName(std::string_view name) const {
+        for (size_t i = 0; i < count_; ++i) {
+            if (symbols_[i].name == name) return static_cast<FixSymbolHandle>(i);
+        }
+        return FIX_NO_SYMBOL;
+    }
+
+    // The symbol a decoded top of book refers to, by 55 as sent
+    FixSymbolHandle handleOf(const FixMdTop& t) const {
+        return t.symbol_id >= 0 ? byId(t.symbol_id) : byName(t.symbol);
+    }
+
+    const FixSymbol& operator[](FixSymbolHandle h) const { return symbols_[h]; }
+    size_t size() const { return count_; }
+    size_t listed() const { return listed_; }
+    bool ready() const { return ready_.load(std::memory_order_acquire); }
+
+    // Number of MarketDataRequests needed for every configured symbol
+    size_t requestCount() const { return (count_ + MAX_PER_REQUEST - 1) / MAX_PER_REQUEST; }
+
+    // NoRelatedSym group (146 and one 55 each) of request n, by numeric id
+    // (symbols not yet listed are left out) or by configured name
+    std::string relatedSymbols(size_t n, bool by_id) const {
+        std::string group;
+        size_t included = 0;
+        for (size_t i = n * MAX_PER_REQUEST; i < count_ && i < (n + 1) * MAX_PER_REQUEST; ++i) {
+            const FixSymbol& s = symbols_[i];
+            if (by_id && s.id < 0) continue;
+            group += "55=" + (by_id ? std::to_string(s.id) : s.name) + "\x01";
+            ++included;
+        }
+        return "146=" + std::to_string(included) + "\x01" + group;
+    }
+
+private:
+    struct Entry {
+        int64_t id = -1;
+        std::string_view id_text;
+        std::string_view name;
+        int digits = -1;
+        double tick_size = 0.0;
+        double contract_size = 0.0;
+    };
+
+    static bool isSeparator(char c) {
+        return c == ',' || c == ' ' || c == '\t';
+    }
+
+    bool apply(const Entry& e, bool frozen) {
+        if (e.id < 0) return false;
+        FixSymbolHandle h = byId(e.id);
+        if (h == FIX_NO_SYMBOL && !e.name.empty()) h = byName(e.name);
+        if (h == FIX_NO_SYMBOL) return false;
+        if (frozen) return symbols_[h].listed && symbols_[h].id == e.id;
+
+        FixSymbol& s = symbols_[h];
+        setId(h, e.id);
+        if (!e.name.empty() && s.name == e.id_text) s.name = std::string(e.name);
+        if (e.digits >= 0 && e.digits <= FIX_MAX_DIGITS) s.digits = e.digits;
+        s.tick_size = e.tick_size > 0.0 ? e.tick_size : 1.0 / static_cast<double>(fixPow10(s.digits));
+        if (e.contract_size > 0.0) s.contract_size = e.contract_size;
+        if (!s.listed) ++listed_;
+        s.listed = true;
+        return true;
+    }
+
+    void setId(FixSymbolHandle h, int64_t id) {
+        if (id < 0 || id >= FixPricePrecision::MAX_SYMBOL_ID) return;
+        if (symbols_[h].id >= 0 && symbols_[h].id < FixPricePrecision::MAX_SYMBOL_ID)
+            by_id_[symbols_[h].id] = FIX_NO_SYMBOL;
+        symbols_[h].id = id;
+        by_id_[id] = h;
+    }
+
+    FixSymbol symbols_[MAX_SYMBOLS];
+    size_t count_;
+    size_t listed_;
+    std::atomic<bool> ready_;
+    FixSymbolHandle by_id_[FixPricePrecision::MAX_SYMBOL_ID];
+};
+
+} // namespace chimera
@@ -0,0 +1,162 @@
+#pragma once
+
+// ChimeraMetals
+// FixTagIndex.hpp - Single-pass tag -> (offset, length) index over one framed message
+//
+// parse() tokenizes the message once. Tags below FLAT_TAGS resolve through a
+// flat array, the rest through a small overflow table; both point at the
+// first occurrence. field(i) keeps every field in wire order for repeating
+// groups. Lookups match whole tags only, so 43= never hits inside 143=.
+// Delimiters come from the vectorized SOH/'=' masks in FixSimd.hpp.
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "FixSimd.hpp"
+
+namespace chimera {
+
+class FixTagIndex {
+public:
+    struct Field {
+        uint32_t tag;
+        uint32_t offset;    // value start, relative to the message
+        uint32_t length;    // value length, SOH excluded
+    };
+
+    static const uint32_t FLAT_TAGS = 1024;
+    static const size_t MAX_FIELDS = 2048;
+    static const size_t MAX_OVERFLOW = 64;
+    static const size_t NPOS = static_cast<size_t>(-1);
+
+    FixTagIndex()
+        : msg_(),
+          count_(0),
+          overflow_count_(0)
+    {
+        std::memset(flat_, 0, sizeof(flat_));
+    }
+
+    // Tokenize msg. Returns false on a malformed field (non-numeric tag,
+    // missing '=' or SOH) or when MAX_FIELDS is exceeded.
+    bool parse(std::string_view msg, const FixSimdKernels& kernels = fixSimd()) {
+        reset();
+        msg_ = msg;
+
+        const char* base = msg.data();
+        size_t n = msg.size();
+        FixDelimCursor delims(base, n, kernels);
+        size_t pos = 0;
+
+        while (pos < n) {
+            size_t eq = delims.nextEq(pos);
+            if (eq == n || eq == pos || eq - pos > 9) return false;
+
+            uint32_t tag = 0;
+            for (size_t i = pos; i < eq; ++i) {
+                unsigned d = static_cast<unsigned char>(base[i]) - '0';
+                if (d > 9) return false;
+                tag = tag * 10 + d;
+            }
+
+            size_t soh = delims.nextSoh(eq + 1);
+            if (soh == n) return false;
+            if (count_ == MAX_FIELDS) return false;
+
+            Field& f = fields_[count_];
+            f.tag = tag;
+            f.offset = static_cast<uint32_t>(eq + 1);
+            f.length = static_cast<uint32_t>(soh - eq - 1);
+
+            uint16_t slot = static_cast<uint16_t>(count_ + 1);
+            if (tag < FLAT_TAGS) {
+                if (flat_[tag] == 0) flat_[tag] = slot;
+            } else if (findOverflow(tag) == 0 && overflow_count_ < MAX_OVERFLOW) {
+                overflow_[overflow_count_].tag = tag;
+                overflow_[overflow_count_].slot = slot;
+                ++overflow_count_;
+            }
+
+            ++count_;
+            pos = soh + 1;
+        }
+
+        return count_ > 0;
+    }
+
+    void reset() {
+        for (size_t i = 0; i < count_; ++i) {
+            if (fields_[i].tag < FLAT_TAGS) flat_[fields_[i].tag] = 0;
+        }
+        count_ = 0;
+        overflow_count_ = 0;
+        msg_ = std::string_view();
+    }
+
+    std::string_view message() const {
+        return msg_;
+    }
+
+    bool has(uint32_t tag) const {
+        return slotOf(tag) != 0;
+    }
+
+    // Value of the first occurrence of tag, empty if absent
+    std::string_view get(uint32_t tag) const {
+        uint16_t slot = slotOf(tag);
+        if (slot == 0) return std::string_view();
+        const Field& f = fields_[slot - 1];
+        return msg_.substr(f.offset, f.length);
+    }
+
+    // First character of the value, '\0' if absent or empty
+    char getChar(uint32_t tag) const {
+        std::string_view v = get(tag);
+        return v.empty() ? '\0' : v[0];
+    }
+
+    // Position of the first occurrence in fields(), NPOS if absent
+    size_t position(uint32_t tag) const {
+        uint16_t slot = slotOf(tag);
+        return slot == 0 ? NPOS : static_cast<size_t>(slot - 1);
+    }
+
+    size_t fieldCount() const {
+        return count_;
+    }
+
+    const Field& field(size_t i) const {
+        return fields_[i];
+    }
+
+    std::string_view value(size_t i) const {
+        return msg_.substr(fields_[i].offset, fields_[i].length);
+    }
+
+private:
+    struct OverflowSlot {
+        uint32_t tag;
+        uint16_t slot;
+    };
+
+    uint16_t slotOf(uint32_t tag) const {
+        return tag < FLAT_TAGS ? flat_[tag] : findOverflow(tag);
+    }
+
+    uint16_t findOverflow(uint32_t tag) const {
+        for (size_t i = 0; i < overflow_count_; ++i) {
+            if (overflow_[i].tag == tag) return overflow_[i].slot;
+        }
+        return 0;
+    }
+
+    std::string_view msg_;
+    size_t count_;
+    size_t overflow_count_;
+    uint16_t flat_[FLAT_TAGS];
+    OverflowSlot overflow_[MAX_OVERFLOW];
+    Field fields_[MAX_FIELDS];
+};
+
+} // namespace chimera
@@ -0,0 +1,243 @@
+#pragma once
+
+// ChimeraMetals
+// FixTime.hpp - UTCTimestamp (52, 60, ...) <-> epoch nanoseconds
+//
+// Fixed-format parse and format of YYYYMMDD-HH:MM:SS with an optional .sss,
+// .ssssss or .sssssssss fraction. No strptime, no gmtime, no locale: civil
+// dates go through the days-from-civil / civil-from-days algorithms, so the
+// result is UTC regardless of the host time zone and safe on any thread.
+// FixTimestampCache keeps the formatted second per thread for the send path.
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+namespace chimera {
+
+// Days since 1970-01-01 for a proleptic Gregorian date
+constexpr int64_t fixDaysFromCivil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+struct FixCivilDate {
+    int64_t year;
+    unsigned month;
+    unsigned day;
+};
+
+// Inverse of fixDaysFromCivil()
+constexpr FixCivilDate fixCivilFromDays(int64_t z) {
+    z += 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    const unsigned d = doy - (153 * mp + 2) / 5 + 1;
+    const unsigned m = mp < 10 ? mp + 3 : mp - 9;
+    return FixCivilDate{static_cast<int64_t>(yoe) + era * 400 + (m <= 2), m, d};
+}
+
+// Longest UTCTimestamp: YYYYMMDD-HH:MM:SS.sssssssss
+constexpr size_t FIX_TIMESTAMP_MAX = 27;
+
+namespace fix_time_detail {
+
+inline void put2(char* p, unsigned v) {
+    p[0] = static_cast<char>('0' + v / 10);
+    p[1] = static_cast<char>('0' + v % 10);
+}
+
+inline void putN(char* p, int n, uint64_t v) {
+    for (int i = n - 1; i >= 0; --i) {
+        p[i] = static_cast<char>('0' + v % 10);
+        v /= 10;
+    }
+}
+
+inline bool digits(const char* p, int n, unsigned& out) {
+    unsigned v = 0;
+    for (int i = 0; i < n; ++i) {
+        unsigned d = static_cast<unsigned char>(p[i]) - '0';
+        if (d > 9) return false;
+        v = v * 10 + d;
+    }
+    out = v;
+    return true;
+}
+
+} // namespace fix_time_detail
+
+// Parses s into nanoseconds since the Unix epoch. frac_digits (optional)
+// receives 0, 3, 6 or 9: the sender's precision, for callers that need to
+// bound the quantisation error of the value.
+inline bool parseFixUtcTimestamp(std::string_view s, int64_t& epoch_ns, int* frac_digits = nullptr) {
+    using fix_time_detail::digits;
+
+    const size_t n = s.size();
+    if (n != 17 && n != 21 && n != 24 && n != 27) return false;
+
+    const char* p = s.data();
+    if (p[8] != '-' || p[11] != ':' || p[14] != ':') return false;
+
+    unsigned year, month, day, hour, minute, second;
+    if (!digits(p, 4, year) || !digits(p + 4, 2, month) || !digits(p + 6, 2, day) ||
+        !digits(p + 9, 2, hour) || !digits(p + 12, 2, minute) || !digits(p + 15, 2, second)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 ||
+        hour > 23 || minute > 59 || second > 60) {
+        return false;
+    }
+
+    unsigned frac = 0;
+    int frac_n = 0;
+    if (n > 17) {
+        if (p[17] != '.') return false;
+        frac_n = static_cast<int>(n - 18);
+        if (!digits(p + 18, frac_n, frac)) return false;
+    }
+
+    static const int64_t FRAC_SCALE[10] = {0, 0, 0, 1000000LL, 0, 0, 1000LL, 0, 0, 1LL};
+
+    int64_t secs = fixDaysFromCivil(year, month, day) * 86400LL +
+                   static_cast<int64_t>(hour) * 3600 + minute * 60 + second;
+    epoch_ns = secs * 1000000000LL + static_cast<int64_t>(frac) * FRAC_SCALE[frac_n];
+    if (frac_digits) *frac_digits = frac_n;
+    return true;
+}
+
+// Writes epoch_ns as a UTCTimestamp with frac_digits (0, 3, 6 or 9) of
+// fraction into out, which needs FIX_TIMESTAMP_MAX bytes. Returns the length.
+inline size_t formatFixUtcTimestamp(char* out, int64_t epoch_ns, int frac_digits) {
+    using fix_time_detail::put2;
+    using fix_time_detail::putN;
+
+    int64_t secs = epoch_ns / 1000000000LL;
+    int64_t sub = epoch_ns % 1000000000LL;
+    if (sub < 0) {
+        sub += 1000000000LL;
+        --secs;
+    }
+    int64_t days = secs / 86400;
+    int64_t tod = secs % 86400;
+    if (tod < 0) {
+        tod += 86400;
+        --days;
+    }
+
+    FixCivilDate date = fixCivilFromDays(days);
+    putN(out, 4, static_cast<uint64_t>(date.year));
+    put2(out + 4, date.month);
+    put2(out + 6, date.day);
+    out[8] = '-';
+    put2(out + 9, static_cast<unsigned>(tod / 3600));
+    out[11] = ':';
+    put2(out + 12, static_cast<unsigned>(tod / 60 % 60));
+    out[14] = ':';
+    put2(out + 15, static_cast<unsigned>(tod % 60));
+
+    if (frac_digits != 3 && frac_digits != 6 && frac_digits != 9) return 17;
+
+    static const int64_t FRAC_DIV[10] = {0, 0, 0, 1000000LL, 0, 0, 1000LL, 0, 0, 1LL};
+    out[17] = '.';
+    putN(out + 18, frac_digits, static_cast<uint64_t>(sub / FRAC_DIV[frac_digits]));
+    return 18 + static_cast<size_t>(frac_digits);
+}
+
+// SendingTime precision, chosen per session. BlackBull rejects fractions.
+enum class FixTimePrecision {
+    Seconds = 0,
+    Millis = 3,
+    Micros = 6
+};
+
+// config.ini values: "seconds" | "ms" | "us"
+inline bool parseFixTimePrecision(std::string_view s, FixTimePrecision& out) {
+    if (s == "seconds" || s == "s" || s == "none") out = FixTimePrecision::Seconds;
+    else if (s == "ms" || s == "millis" || s == "milliseconds") out = FixTimePrecision::Millis;
+    else if (s == "us" || s == "micros" || s == "microseconds") out = FixTimePrecision::Micros;
+    else return false;
+    return true;
+}
+
+// Per-thread formatter: the 17-byte YYYYMMDD-HH:MM:SS part and its byte sum
+// are rebuilt only when the second changes; within a second only the
+// fraction digits are written.
+class FixTimestampCache {
+public:
+    FixTimestampCache()
+        : second_(std::numeric_limits<int64_t>::min()),
+          second_sum_(0)
+    {
+        std::memset(second_text_, 0, sizeof(second_text_));
+    }
+
+    // Writes epoch_ns into out (FIX_TIMESTAMP_MAX bytes) and adds the bytes
+    // written to sum. Returns the length.
+    size_t format(char* out, int64_t epoch_ns, FixTimePrecision precision, uint32_t& sum) {
+        int64_t sec = epoch_ns / 1000000000LL;
+        int64_t sub = epoch_ns % 1000000000LL;
+        if (sub < 0) {
+            sub += 1000000000LL;
+            --sec;
+        }
+
+        if (sec != second_) {
+            formatFixUtcTimestamp(second_text_, sec * 1000000000LL, 0);
+            second_sum_ = 0;
+            for (int i = 0; i < 17; ++i) second_sum_ += static_cast<unsigned char>(second_text_[i]);
+            second_ = sec;
+        }
+
+        std::memcpy(out, second_text_, 17);
+        sum += second_sum_;
+
+        int digits = static_cast<int>(precision);
+        if (digits == 0) return 17;
+
+        static const int64_t FRAC_DIV[7] = {0, 0, 0, 1000000LL, 0, 0, 1000LL};
+        uint64_t frac = static_cast<uint64_t>(sub / FRAC_DIV[digits]);
+        out[17] = '.';
+        sum += '.';
+        for (int i = digits; i >= 1; --i) {
+            char c = static_cast<char>('0' + frac % 10);
+            out[17 + i] = c;
+            sum += static_cast<unsigned char>(c);
+            frac /= 10;
+        }
+        return 18 + static_cast<size_t>(digits);
+    }
+
+    size_t format(char* out, int64_t epoch_ns, FixTimePrecision precision) {
+        uint32_t sum = 0;
+        return format(out, epoch_ns, precision, sum);
+    }
+
+private:
+    int64_t second_;
+    uint32_t second_sum_;
+    char second_text_[FIX_TIMESTAMP_MAX];
+};
+
+// The calling thread's cache; quote and trade threads never share one
+inline FixTimestampCache& fixThreadTimestampCache() {
+    thread_local FixTimestampCache cache;
+    return cache;
+}
+
+// Wall-clock now in epoch nanoseconds, comparable with parseFixUtcTimestamp()
+inline int64_t fixWallClockNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace chimera
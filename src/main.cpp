@@ -5,35 +5,33 @@
 #include <thread>
 #include <string>
 #include <cstring>
-#ifdef _WIN32
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#pragma comment(lib, "ws2_32.lib")
-#else
-#include <sys/socket.h>
-#endif
-#ifdef _WIN32
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#pragma comment(lib, "ws2_32.lib")
-#else
-#include <netinet/in.h>
-#endif
-#ifdef _WIN32
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#pragma comment(lib, "ws2_32.lib")
-#else
-#include <arpa/inet.h>
-#endif
 #include <sstream>
 #include <iomanip>
 #include <ctime>
-#include <netdb.h>
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 #include <fstream>
 #include <map>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "platform/platform.hpp"
+
+#include "core/FixBook.hpp"
+#include "core/FixDispatch.hpp"
+#include "core/FixEncoder.hpp"
+#include "core/FixLatency.hpp"
+#include "core/FixMdDecoder.hpp"
+#include "core/FixMessageStore.hpp"
+#include "core/FixNumeric.hpp"
+#include "core/FixOutboundQueue.hpp"
+#include "core/FixQuoteCache.hpp"
+#include "core/FixReactor.hpp"
+#include "core/FixSimd.hpp"
+#include "core/FixSymbolDirectory.hpp"
+#include "core/FixTagIndex.hpp"
+#include "core/FixTime.hpp"
 
 namespace chimera {
 
@@ -48,7 +46,16 @@ struct FIXConfig {
     std::string password;
     int heartbeat_interval;
     std::string reset_seq_num;
+    FixTimePrecision sending_time_precision = FixTimePrecision::Seconds;   // BlackBull rejects fractions
+    FixOutboundBudget tx_budget;            // outbound coalescing: record size and delay
+    FixSocketTuning socket_tuning;          // SO_RCVBUF/SO_SNDBUF, TCP_QUICKACK, SO_BUSY_POLL, kTLS
+    FixSpinPolicy quote_spin;               // [threads] quote_mode = spin
+    int quote_cpu = -1;                     // [threads] core for the quote reactor
+    int64_t dns_ttl_sec = 300;              // cached address refreshed in the background after this
+    bool standby_connection = false;        // keep a second TLS connection ready to log on
+    std::string message_store;              // outbound store for ResendRequest, empty = none
     int dashboard_port;
+    std::string symbols = "XAUUSD";         // [symbols] subscribe, names in handle order
 };
 
 static FIXConfig g_config;
@@ -100,22 +107,76 @@ bool loadConfig(const std::string& filename) {
             else if (key == "password") g_config.password = value;
             else if (key == "heartbeat_interval") g_config.heartbeat_interval = std::stoi(value);
             else if (key == "reset_seq_num") g_config.reset_seq_num = value;
+            else if (key == "tx_coalesce_bytes") g_config.tx_budget.max_record_bytes = std::stoul(value);
+            else if (key == "tx_coalesce_delay_us") g_config.tx_budget.max_delay_ns = std::stoll(value) * 1000;
+            else if (key == "socket_rcvbuf") g_config.socket_tuning.rcvbuf_bytes = std::stoi(value);
+            else if (key == "socket_sndbuf") g_config.socket_tuning.sndbuf_bytes = std::stoi(value);
+            else if (key == "tcp_quickack") g_config.socket_tuning.quickack = (value == "true" || value == "1");
+            else if (key == "ktls") g_config.socket_tuning.ktls = (value == "true" || value == "1");
+            else if (key == "dns_ttl_sec") g_config.dns_ttl_sec = std::stoll(value);
+            else if (key == "standby_connection") g_config.standby_connection = (value == "true" || value == "1");
+            else if (key == "message_store") g_config.message_store = value;
+            else if (key == "sending_time_precision" &&
+                     !parseFixTimePrecision(value, g_config.sending_time_precision)) {
+                std::cerr << "Unknown sending_time_precision '" << value << "', using seconds\n";
+            }
+        } else if (section == "threads") {
+            if (key == "quote_mode") {
+                if (value != "blocking" && value != "spin") {
+                    std::cerr << "Unknown quote_mode '" << value << "', using blocking\n";
+                }
+                g_config.quote_spin.enabled = (value == "spin");
+            }
+            else if (key == "quote_cpu") g_config.quote_cpu = std::stoi(value);
+            else if (key == "busy_poll_us") g_config.socket_tuning.busy_poll_us = std::stoi(value);
+            else if (key == "spin_idle_ms") g_config.quote_spin.idle_ns = std::stoll(value) * 1000000;
         } else if (section == "dashboard") {
             if (key == "port") g_config.dashboard_port = std::stoi(value);
+        } else if (section == "symbols") {
+            if (key == "subscribe") g_config.symbols = value;
         }
     }
     
     return true;
 }
 
-// Global gold price from FIX feed
-static std::atomic<double> g_gold_bid{2650.00};
-static std::atomic<double> g_gold_ask{2650.00};
+// Subscribed symbols by handle, from [symbols] in config.ini
+static FixSymbolDirectory g_symbols;
+static FixSymbolHandle g_gold = FIX_NO_SYMBOL;  // XAUUSD, what the dashboard charts
+
+// Top of book per symbol handle, written by the FIX thread only
+static FixQuoteCache g_quotes;
+
+// L2 book per symbol handle, FIX thread only; depth and imbalance are
+// published through g_books.depth() for the dashboard and engines
+static FixBookSet g_books(g_symbols);
+
 static std::atomic<bool> g_fix_connected{false};
 
-class BlackBullFIX {
+// Broker-to-us latency from SendingTime (52) vs kernel receive time
+static FixFeedLatency g_feed_latency;
+
+// The QUOTE session and, with standby_connection, a pre-connected spare that
+// takes over when it drops; each outbound queue coalesces replies into as few
+// TLS records as the budget allows
+static FixSession g_fix_sessions[2];
+
+// Stage timing of the last successful logon, for the dashboard
+static std::mutex g_connect_timing_mtx;
+static FixConnectTiming g_connect_timing;
+
+// Drives the QUOTE session from one reactor thread: non-blocking connect and
+// handshake, logon and heartbeat supervision on timers, reconnect on a timer.
+// DNS is cached and TLS sessions resumed so a reconnect costs little more
+// than the Logon round trip; a warm standby removes TCP and TLS altogether.
+class BlackBullFIX : public FixReactorHandler {
 public:
-    BlackBullFIX() : m_running(false), m_socket(-1), m_seq_num(1), m_ssl_ctx(nullptr), m_ssl(nullptr) {
+    static const int RECONNECT_DELAY_SEC = 5;
+    static const int LOGON_TIMEOUT_SEC = 10;
+
+    BlackBullFIX()
+        : m_running(false), m_seq_num(1), m_in_seq(1), m_active(&g_fix_sessions[0]), m_spare(&g_fix_sessions[1]),
+          m_spare_busy(false), m_spare_ready(false), m_active_up(false), m_logon_sent_ns(0), m_logon_timer(0), m_hb_timer(0) {
         SSL_library_init();
         SSL_load_error_strings();
         OpenSSL_add_all_algorithms();
@@ -123,334 +184,524 @@ public:
     
     ~BlackBullFIX() {
         stop();
-        if (m_ssl_ctx) {
-            SSL_CTX_free(m_ssl_ctx);
-        }
     }
     
     void start() {
+        buildTemplates();
+        if (!m_tls.ctx()) {
+            std::cerr << "[FIX] Failed to create SSL context\n";
+            return;
+        }
+        if (!m_reactor.ok()) {
+            std::cerr << "[FIX] Failed to create reactor\n";
+            return;
+        }
+        openStore();
+        m_reactor.setTuning(g_config.socket_tuning);
+        m_reactor.setSpin(g_config.quote_spin);
+        m_resolver.setTarget(g_config.host, static_cast<uint16_t>(g_config.port),
+                             g_config.dns_ttl_sec * 1000000000LL);
         m_running = true;
-        m_thread = std::thread([this]() { run(); });
+        m_thread = std::thread([this]() {
+            plat::set_thread_name("fix-quote");
+            connectToFIX();
+            m_reactor.run(g_config.quote_cpu);
+        });
     }
     
     void stop() {
         if (!m_running) return;
         m_running = false;
-        if (m_ssl) {
-            SSL_shutdown(m_ssl);
-            SSL_free(m_ssl);
-            m_ssl = nullptr;
-        }
-        if (m_socket >= 0) {
-            close(m_socket);
-            m_socket = -1;
-        }
+        m_reactor.stop();
         if (m_thread.joinable()) {
             m_thread.join();
         }
+        m_reactor.disconnect(*m_active);
+        m_reactor.disconnect(*m_spare);
+        m_store.flush(false);
     }
     
 private:
-    std::string getTimestamp() {
-        // NO MILLISECONDS! This is critical for BlackBull
-        auto now = std::time(nullptr);
-        std::tm* gmt = std::gmtime(&now);
-        char buf[32];
-        std::strftime(buf, sizeof(buf), "%Y%m%d-%H:%M:%S", gmt);
-        return std::string(buf);
+    static FixSessionIds sessionIds() {
+        FixSessionIds ids;
+        ids.sender_comp_id = g_config.sender_comp_id;
+        ids.target_comp_id = g_config.target_comp_id;
+        ids.target_sub_id = g_config.target_sub_id;
+        ids.sending_time_precision = g_config.sending_time_precision;
+        return ids;
     }
     
-    int calculateChecksum(const std::string& msg) {
-        int sum = 0;
-        for (unsigned char c : msg) {
-            sum += c;
-        }
-        return sum % 256;
-    }
-    
-    std::string buildLogon() {
-        // Read from config.ini - NO MORE HARDCODED VALUES!
-        std::string timestamp = getTimestamp();
-        
-        std::stringstream body;
-        body << "35=A\x01"                                    // MsgType = Logon
-             << "49=" << g_config.sender_comp_id << "\x01"    // SenderCompID from config
-             << "56=" << g_config.target_comp_id << "\x01"    // TargetCompID from config
-             << "34=" << m_seq_num++ << "\x01"                // MsgSeqNum
-             << "52=" << timestamp << "\x01"                  // SendingTime
-             << "57=" << g_config.target_sub_id << "\x01"     // TargetSubID from config
-             << "98=0\x01"                                    // EncryptMethod
-             << "108=" << g_config.heartbeat_interval << "\x01"  // HeartBtInt from config
-             << "141=" << g_config.reset_seq_num << "\x01"    // ResetSeqNumFlag from config
-             << "553=" << g_config.username << "\x01"         // Username from config
-             << "554=" << g_config.password << "\x01";        // Password from config
+    // Static bytes of every outbound message, rendered once from config.ini
+    void buildTemplates() {
+        FixSessionIds ids = sessionIds();
         
-        std::string body_str = body.str();
-        int body_len = body_str.length();
+        m_logon_tmpl = FixMsgTemplate(ids, "A",
+            "98=0\x01"                                                        // EncryptMethod
+            "108=" + std::to_string(g_config.heartbeat_interval) + "\x01"     // HeartBtInt from config
+            "141=" + g_config.reset_seq_num + "\x01"                          // ResetSeqNumFlag from config
+            "553=" + g_config.username + "\x01"                               // Username from config
+            "554=" + g_config.password + "\x01");                             // Password from config
         
-        // Build complete message
-        std::stringstream msg;
-        msg << "8=FIX.4.4\x01"
-            << "9=" << body_len << "\x01"
-            << body_str;
+        // Symbol ids and digits, before subscribing; 320 is stamped per request
+        m_security_list_tmpl = FixMsgTemplate(ids, "x", "559=0\x01");      // SecurityListRequestType: all
         
-        std::string msg_str = msg.str();
-        int checksum = calculateChecksum(msg_str);
-        
-        msg << "10=" << std::setfill('0') << std::setw(3) << checksum << "\x01";
-        
-        return msg.str();
+        m_gap_fill_tmpl = FixMessageStore::gapFillTemplate(ids);
+        m_resend_tmpl = FixMsgTemplate(ids, "2");
+        m_heartbeat_tmpl = FixMsgTemplate(ids, "0");
     }
     
-    std::string buildMarketDataRequest() {
-        std::string timestamp = getTimestamp();
-        
-        std::stringstream body;
-        body << "35=V\x01"                                    // MarketDataRequest
-             << "49=" << g_config.sender_comp_id << "\x01"    // SenderCompID from config
-             << "56=" << g_config.target_comp_id << "\x01"    // TargetCompID from config
-             << "34=" << m_seq_num++ << "\x01"                // MsgSeqNum
-             << "52=" << timestamp << "\x01"                  // SendingTime
-             << "57=" << g_config.target_sub_id << "\x01"     // TargetSubID from config
-             << "262=XAUUSD_REQ\x01"                          // MDReqID
-             << "263=1\x01"                                   // SubscriptionRequestType
-             << "264=0\x01"                                   // MarketDepth
-             << "146=1\x01"                                   // NoRelatedSym
-             << "55=XAUUSD\x01"                               // Symbol
-             << "267=2\x01"                                   // NoMDEntryTypes
-             << "269=0\x01"                                   // Bid
-             << "269=1\x01";                                  // Offer
-        
-        std::string body_str = body.str();
-        int body_len = body_str.length();
-        
-        std::stringstream msg;
-        msg << "8=FIX.4.4\x01"
-            << "9=" << body_len << "\x01"
-            << body_str;
-        
-        std::string msg_str = msg.str();
-        int checksum = calculateChecksum(msg_str);
-        
-        msg << "10=" << std::setfill('0') << std::setw(3) << checksum << "\x01";
-        
-        return msg.str();
+    // Every listed symbol by SecurityID, so entries come back with the id
+    // the decoder has digits for, in as few requests as fit
+    void buildMdTemplates() {
+        FixSessionIds ids = sessionIds();
+        m_md_tmpls.clear();
+        for (size_t i = 0; i < g_symbols.requestCount(); ++i) {
+            m_md_tmpls.emplace_back(ids, "V",
+                "262=MD" + std::to_string(i) + "\x01"                  // MDReqID
+                "263=1\x01"                                           // SubscriptionRequestType
+                "264=0\x01"                                           // MarketDepth: full book
+                + g_symbols.relatedSymbols(i, true) +                 // NoRelatedSym, Symbol...
+                "267=2\x01"                                           // NoMDEntryTypes
+                "269=0\x01"                                           // Bid
+                "269=1\x01");                                         // Offer
+        }
     }
     
-    void parseMarketData(const std::string& msg) {
-        // Parse FIX message for bid/ask prices
-        // Format: ...269=0|270=PRICE|... (bid) ...269=1|270=PRICE|... (ask)
-        
-        size_t pos = 0;
-        while (pos < msg.length()) {
-            // Look for MDEntryType (269)
-            size_t type_pos = msg.find("\x01""269=", pos);
-            if (type_pos == std::string::npos) break;
-            
-            type_pos += 5; // Skip past "269="
-            char entry_type = msg[type_pos];
-            
-            // Look for price (270) after this entry type
-            size_t price_pos = msg.find("\x01""270=", type_pos);
-            if (price_pos == std::string::npos) break;
-            
-            price_pos += 5; // Skip past "270="
-            size_t price_end = msg.find('\x01', price_pos);
-            if (price_end == std::string::npos) break;
-            
-            std::string price_str = msg.substr(price_pos, price_end - price_pos);
-            double price = std::stod(price_str);
-            
-            if (entry_type == '0') {
-                g_gold_bid.store(price);
-            } else if (entry_type == '1') {
-                g_gold_ask.store(price);
-            }
-            
-            pos = price_end;
+    // Outbound history across restarts: without ResetSeqNumFlag the
+    // sequence continues from the store
+    void openStore() {
+        if (g_config.message_store.empty()) return;
+        int64_t started = static_cast<int64_t>(plat::monotonic_time_ns());
+        if (!m_store.open(g_config.message_store)) {
+            std::cerr << "[FIX] Cannot open message store " << g_config.message_store << "\n";
+            return;
         }
+        if (g_config.reset_seq_num != "Y") {
+            m_seq_num = static_cast<int>(m_store.nextOutSeq());
+            m_in_seq = static_cast<int>(m_store.nextInSeq());
+        }
+        for (FixSession& session : g_fix_sessions) session.attachStore(&m_store);
+        std::cout << "[FIX] Message store " << g_config.message_store << " open in "
+                  << (static_cast<int64_t>(plat::monotonic_time_ns()) - started) / 1000
+                  << "us, next seq " << m_seq_num << "\n";
+    }
+    
+    std::string_view buildLogon() {
+        return m_enc.begin(m_logon_tmpl, m_seq_num++).body(m_logon_tmpl).finish();
+    }
+    
+    // Queues msg on the session; urgent writes it (and anything ahead) now,
+    // the rest goes out when the reactor flushes before blocking
+    bool send(std::string_view msg, bool urgent) {
+        m_store.append(msg);
+        return m_active->sslWrite(msg.data(), static_cast<int>(msg.size()), urgent);
+    }
+    
+    // Writes bytes that must not enter the store: echoes and replays
+    bool sendUnstored(std::string_view msg, bool urgent) {
+        return m_active->sslWrite(msg.data(), static_cast<int>(msg.size()), urgent);
+    }
+    
+    // ResendRequest (35=2): BeginSeqNo (7) to EndSeqNo (16, 0 = all) from the
+    // store, application messages as PossDup, admin runs as one GapFill
+    void resend(const FixTagIndex& idx) {
+        int64_t begin = 0, end = 0;
+        if (parseFixInt(idx.get(7), begin) != FixNumError::None ||
+            parseFixInt(idx.get(16), end) != FixNumError::None) {
+            std::cerr << "[FIX] Malformed ResendRequest\n";
+            return;
+        }
+        if (!m_store.isOpen()) {
+            // Nothing kept: fill the whole range so the broker can move on
+            int64_t next = m_seq_num;
+            send(m_enc.begin(m_gap_fill_tmpl, begin).body(m_gap_fill_tmpl).field(36, next).finish(), true);
+            std::cerr << "[FIX] ResendRequest " << begin << "-" << end << " gap-filled (no message store)\n";
+            return;
+        }
+        FixReplayStats stats = m_store.replay(begin, end, m_enc, m_gap_fill_tmpl,
+            [this](std::string_view msg) { return sendUnstored(msg, false); });
+        m_active->flushOutbound();
+        std::cout << "[FIX] ResendRequest " << begin << "-" << end << ": " << stats.resent
+                  << " resent, " << stats.gap_fills << " gap fills\n";
+    }
+    
+    // Asks the broker for one hole; what arrived past it is held meanwhile
+    void requestResend(const FixResendRange& gap) {
+        std::string_view req = m_enc.begin(m_resend_tmpl, m_seq_num++)
+                                   .field(7, gap.begin).field(16, gap.end).finish();
+        if (!send(req, true)) return;
+        std::cout << "[FIX] Gap: ResendRequest " << gap.begin << "-" << gap.end << " sent\n";
+    }
+    
+    // Heartbeat (35=0) answering a TestRequest: TestReqID (112) echoed back
+    void sendTestResponse(std::string_view test_req_id) {
+        send(m_enc.begin(m_heartbeat_tmpl, m_seq_num++).field(112, test_req_id).finish(), true);
     }
     
-    bool connectToFIX() {
-        // Create SSL context if not exists
-        if (!m_ssl_ctx) {
-            m_ssl_ctx = SSL_CTX_new(TLS_client_method());
-            if (!m_ssl_ctx) {
-                std::cerr << "[FIX] Failed to create SSL context\n";
-                return false;
+    std::string_view buildSecurityListRequest() {
+        int seq = m_seq_num++;
+        return m_enc.begin(m_security_list_tmpl, seq)
+                   .field(320, "ListReq-", seq)
+                   .body(m_security_list_tmpl)
+                   .finish();
+    }
+    
+    std::string_view buildMarketDataRequest(const FixMsgTemplate& tmpl) {
+        return m_enc.begin(tmpl, m_seq_num++).body(tmpl).finish();
+    }
+    
+    // SecurityList (35=y): digits for the decoder and books, then subscribe
+    // to every configured symbol
+    void subscribe(const FixTagIndex& idx) {
+        size_t listed = m_precision.loadSecurityList(idx);
+        g_symbols.loadSecurityList(idx);
+        std::cout << "[FIX] Security list: " << listed << " symbols, " << g_symbols.listed()
+                  << " of " << g_symbols.size() << " configured\n";
+        buildMdTemplates();
+        for (const FixMsgTemplate& tmpl : m_md_tmpls) {
+            std::string_view mdReq = buildMarketDataRequest(tmpl);
+            if (!send(mdReq, true)) {
+                std::cerr << "[FIX] Failed to send market data subscription!\n";
+                return;
             }
+            std::cout << "[FIX] Market data subscription sent (" << mdReq.size() << " bytes)\n";
         }
-        
-        struct hostent* host = gethostbyname(g_config.host.c_str());
-        if (!host) {
-            std::cerr << "[FIX] DNS lookup failed for " << g_config.host << "\n";
-            return false;
+        std::cout << "[FIX] Subscribed to " << g_symbols.listed() << " symbols in "
+                  << m_md_tmpls.size() << " request(s)\n";
+    }
+    
+    void parseMarketData(const FixTagIndex& idx) {
+        if (!FixMdDecoder::decode(idx, m_precision, m_md)) return;
+        if (m_md.errors()) {
+            std::cerr << "[FIX] " << m_md.errors() << " MD entries dropped (bad number)\n";
         }
         
-        m_socket = socket(AF_INET, SOCK_STREAM, 0);
-        if (m_socket < 0) {
-            std::cerr << "[FIX] Socket creation failed\n";
-            return false;
+        // Book first, then one consistent quote store per symbol touched
+        FixSymbolHandle touched[FixSymbolDirectory::MAX_SYMBOLS];
+        size_t n = g_books.apply(m_md, touched, FixSymbolDirectory::MAX_SYMBOLS);
+        int64_t exchange_ns = 0;
+        if (!parseFixUtcTimestamp(idx.get(52), exchange_ns)) exchange_ns = 0;
+        for (size_t i = 0; i < n; ++i) {
+            g_quotes.update(touched[i], g_books.book(touched[i]).top(), exchange_ns, m_active->rxTimeNs());
         }
-        
+    }
+    
+    // Resolves the host (from cache after the first time) and starts a
+    // non-blocking connect of session; false if it could not be started
+    bool openSession(FixSession& session) {
         sockaddr_in addr{};
-        addr.sin_family = AF_INET;
-        addr.sin_port = htons(g_config.port);
-        memcpy(&addr.sin_addr, host->h_addr, host->h_length);
-        
-        if (connect(m_socket, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
-            std::cerr << "[FIX] TCP connection failed\n";
-            close(m_socket);
-            m_socket = -1;
+        bool cached = false;
+        int64_t dns_started = static_cast<int64_t>(plat::monotonic_time_ns());
+        if (!m_resolver.lookup(addr, cached)) {
+            std::cerr << "[FIX] DNS lookup failed for " << g_config.host << "\n";
             return false;
         }
+        int64_t dns_ns = static_cast<int64_t>(plat::monotonic_time_ns()) - dns_started;
         
-        // Create SSL connection
-        m_ssl = SSL_new(m_ssl_ctx);
-        if (!m_ssl) {
-            std::cerr << "[FIX] Failed to create SSL\n";
-            close(m_socket);
-            m_socket = -1;
+        session.setOutboundBudget(g_config.tx_budget);
+        if (!m_reactor.connect(session, *this, addr, m_tls, g_config.host)) {
+            std::cerr << "[FIX] TCP connection failed\n";
             return false;
         }
-        
-        SSL_set_fd(m_ssl, m_socket);
-        
-        if (SSL_connect(m_ssl) <= 0) {
-            std::cerr << "[FIX] SSL handshake failed\n";
-            ERR_print_errors_fp(stderr);
-            SSL_free(m_ssl);
-            m_ssl = nullptr;
-            close(m_socket);
-            m_socket = -1;
-            return false;
+        // connect() resets the timing; DNS happened before it
+        session.connectTiming().dns_ns = dns_ns;
+        session.connectTiming().dns_cached = cached;
+        return true;
+    }
+    
+    // Starts the QUOTE connection; on failure retries from a timer
+    void connectToFIX() {
+        if (!m_running || promoteStandby()) return;
+        std::cout << "[FIX] Connecting to " << g_config.host << ":" << g_config.port << "...\n";
+        m_active_up = false;
+        if (!openSession(*m_active)) scheduleReconnect();
+    }
+    
+    void scheduleReconnect() {
+        if (!m_running) return;
+        std::cerr << "[FIX] Retrying in " << RECONNECT_DELAY_SEC << "s...\n";
+        m_reactor.addTimer(RECONNECT_DELAY_SEC * 1000000000LL, 0, [this]() { connectToFIX(); });
+    }
+    
+    // Connects the spare through TLS and stops there; it logs on only when
+    // promoted. Called once the active session is logged in.
+    void warmStandby() {
+        if (!m_running || !g_config.standby_connection) return;
+        if (m_spare_busy) return;
+        m_spare_busy = openSession(*m_spare);
+        if (!m_spare_busy) scheduleStandby();
+    }
+    
+    void scheduleStandby() {
+        if (!m_running || !g_config.standby_connection) return;
+        m_reactor.addTimer(RECONNECT_DELAY_SEC * 1000000000LL, 0, [this]() { warmStandby(); });
+    }
+    
+    void onConnected(FixSession& session) override {
+        if (&session == m_spare) {
+            m_spare_ready = true;
+            std::cout << "[FIX] Standby connected"
+                      << (session.connectTiming().tls_resumed ? " (TLS resumed)" : "") << "\n";
+            return;
         }
-        
         std::cout << "[FIX] SSL connected to " << g_config.host << ":" << g_config.port << "!\n";
-        return true;
+        if (g_config.socket_tuning.ktls) {
+            std::cout << "[FIX] kTLS: send " << (session.ktlsSend() ? "kernel" : "openssl")
+                      << ", recv " << (session.ktlsRecv() ? "kernel" : "openssl") << "\n";
+        }
+        m_active_up = true;
+        logon(session);
     }
     
-    void run() {
-        while (m_running) {
-            std::cout << "[FIX] Connecting to " << g_config.host << ":" << g_config.port << "...\n";
-            
-            if (!connectToFIX()) {
-                std::cerr << "[FIX] Failed to connect, retrying in 5s...\n";
-                sleep(5);
-                continue;
-            }
-            
-            std::cout << "[FIX] Connected!\n";
-            
-            // Send logon
-            std::string logon = buildLogon();
-            int sent = SSL_write(m_ssl, logon.c_str(), logon.length());
-            if (sent <= 0) {
-                std::cerr << "[FIX] Logon send failed\n";
-                SSL_free(m_ssl);
-                m_ssl = nullptr;
-                close(m_socket);
-                m_socket = -1;
-                sleep(5);
-                continue;
+    // Sends the Logon on the active session and arms its supervision timers
+    void logon(FixSession& session) {
+        // ResetSeqNumFlag: both sides start again at 1 and old history is void
+        if (g_config.reset_seq_num == "Y") {
+            m_seq_num = 1;
+            m_in_seq = 1;
+            m_store.reset(1);
+        }
+        session.setExpectedSeq(m_in_seq);
+        m_logon_sent_ns = static_cast<int64_t>(plat::monotonic_time_ns());
+        if (!send(buildLogon(), true)) {
+            std::cerr << "[FIX] Logon send failed\n";
+            m_reactor.disconnect(session);
+            return;
+        }
+        std::cout << "[FIX] Logon sent, waiting for response...\n";
+        
+        m_logon_timer = m_reactor.addTimer(LOGON_TIMEOUT_SEC * 1000000000LL, 0, [this, &session]() {
+            m_logon_timer = 0;
+            std::cerr << "[FIX] No logon response\n";
+            m_reactor.disconnect(session);
+        });
+        // The broker heartbeats every HeartBtInt; silence for two of them is a
+        // dead link, and a gap stuck for one is asked for again
+        m_hb_timer = m_reactor.addTimer(1000000000LL, 1000000000LL, [this, &session]() {
+            if (session.heartbeatTimeout(g_config.heartbeat_interval)) {
+                std::cerr << "[FIX] Heartbeat timeout\n";
+                m_reactor.disconnect(session);
+                return;
             }
-            
-            std::cout << "[FIX] Logon sent, waiting for response...\n";
-            
-            // Read logon response
-            char buffer[4096];
-            int received = SSL_read(m_ssl, buffer, sizeof(buffer));
-            if (received <= 0) {
-                std::cerr << "[FIX] No logon response\n";
-                SSL_free(m_ssl);
-                m_ssl = nullptr;
-                close(m_socket);
-                m_socket = -1;
-                sleep(5);
-                continue;
+            FixResendRange gap;
+            if (&session == m_active && session.resendIfStalled(g_config.heartbeat_interval * 1000000000LL, gap)) {
+                std::cerr << "[FIX] Gap stalled at " << gap.begin << ", asking again\n";
+                requestResend(gap);
             }
-            
-            std::string response(buffer, received);
-            
+        });
+    }
+    
+    void onMessage(FixSession& session, std::string_view msg, const FixTagIndex& idx) override {
+        // The standby has not logged on; nothing it receives is ours yet
+        if (&session != m_active) return;
+        g_feed_latency.record(idx.get(52), session.rxTimeNs());
+        
+        if (session.getState() != FixSession::State::LoggedIn) {
             // Check for logon acceptance (35=A)
-            if (response.find("\x01""35=A\x01") != std::string::npos) {
-                std::cout << "[FIX] LOGON SUCCESSFUL!\n";
-                g_fix_connected.store(true);
-                
-                // Subscribe to XAUUSD
-                std::string mdReq = buildMarketDataRequest();
-                int md_sent = SSL_write(m_ssl, mdReq.c_str(), mdReq.length());
-                if (md_sent > 0) {
-                    std::cout << "[FIX] Market data subscription sent for XAUUSD (sent " << md_sent << " bytes)\n";
-                } else {
-                    std::cerr << "[FIX] Failed to send market data subscription!\n";
-                }
-                
-                // Read market data
-                while (m_running) {
-                    received = SSL_read(m_ssl, buffer, sizeof(buffer));
-                    if (received <= 0) {
-                        std::cerr << "[FIX] Connection lost\n";
-                        g_fix_connected.store(false);
-                        break;
-                    }
-                    
-                    std::string msg(buffer, received);
-                    
-                    // DEBUG: Show what message type we got
-                    size_t msg_type_pos = msg.find("\x01""35=");
-                    if (msg_type_pos != std::string::npos) {
-                        char msg_type = msg[msg_type_pos + 4];
-                        std::cout << "[FIX] Received message type: " << msg_type << "\n";
-                    }
-                    
-                    // Market Data Snapshot (35=W)
-                    if (msg.find("\x01""35=W\x01") != std::string::npos) {
-                        std::cout << "[FIX] Market data snapshot received!\n";
-                        parseMarketData(msg);
-                        double bid = g_gold_bid.load();
-                        double ask = g_gold_ask.load();
-                        std::cout << "[FIX] Gold: " << std::fixed << std::setprecision(2) 
-                                  << bid << " / " << ask << "\n";
-                    }
-                    
-                    // Heartbeat (35=0) - respond
-                    if (msg.find("\x01""35=0\x01") != std::string::npos) {
-                        std::cout << "[FIX] Heartbeat received, sending response\n";
-                        // Echo heartbeat back
-                        SSL_write(m_ssl, msg.c_str(), msg.length());
-                    }
-                }
-            } else {
-                std::cerr << "[FIX] Logon failed: " << response << "\n";
-                g_fix_connected.store(false);
+            if (fixMsgType(idx.get(35)) != FixMsgType::Logon) {
+                std::cerr << "[FIX] Logon failed: " << msg << "\n";
+                m_reactor.disconnect(session);
+                return;
             }
+            std::cout << "[FIX] LOGON SUCCESSFUL!\n";
+            m_reactor.cancelTimer(m_logon_timer);
+            m_logon_timer = 0;
+            session.setState(FixSession::State::LoggedIn);
             
-            if (m_ssl) {
-                SSL_shutdown(m_ssl);
-                SSL_free(m_ssl);
-                m_ssl = nullptr;
+            // A Logon above the expected seq opens a gap; the Logon itself
+            // is handled now and only its seq is held
+            int64_t seq = 0;
+            FixResendRange gap;
+            if (session.checkResetSeqNumFlag(idx)) session.setExpectedSeq(1);
+            if (parseFixInt(idx.get(34), seq) == FixNumError::None &&
+                session.sequenceInbound(seq, msg, gap, false) != FixSeqAction::Process && gap.begin) {
+                requestResend(gap);
             }
-            close(m_socket);
-            m_socket = -1;
+            g_fix_connected.store(true);
+            publishTiming(session);
             
-            if (m_running) {
-                sleep(5);
+            // Subscriptions go out once the SecurityList has the digits
+            if (!send(buildSecurityListRequest(), true)) {
+                std::cerr << "[FIX] Failed to send security list request!\n";
+            } else {
+                std::cout << "[FIX] Security list request sent\n";
             }
+            warmStandby();
+            return;
+        }
+        
+        // SequenceReset-Reset ignores MsgSeqNum (34) altogether
+        if (fixMsgType(idx.get(35)) == FixMsgType::SequenceReset && idx.getChar(123) != 'Y') {
+            dispatch(msg, idx);
+            return;
+        }
+        
+        int64_t seq = 0;
+        if (parseFixInt(idx.get(34), seq) != FixNumError::None) {
+            std::cerr << "[FIX] Message without MsgSeqNum dropped\n";
+            return;
+        }
+        FixResendRange gap;
+        switch (session.sequenceInbound(seq, msg, gap)) {
+        case FixSeqAction::Process:
+            break;
+        case FixSeqAction::Duplicate:
+            if (!session.checkPossDupFlag(idx)) {
+                std::cerr << "[FIX] MsgSeqNum " << seq << " below expected " << session.getExpectedSeq() << "\n";
+            }
+            return;
+        case FixSeqAction::Held:
+        case FixSeqAction::Overflow:
+            if (gap.begin) requestResend(gap);
+            return;
+        }
+        
+        dispatch(msg, idx);
+        // The hole may just have closed: replay what waited behind it, in order
+        std::string_view held;
+        while (session.nextHeld(held)) {
+            if (held.empty() || !m_held_idx.parse(held)) continue;
+            dispatch(held, m_held_idx);
+        }
+    }
+    
+    void dispatch(std::string_view msg, const FixTagIndex& idx) {
+        MarketDataHandler handler{*this};
+        if (!fixDispatch(handler, msg, idx)) {
+            std::cout << "[FIX] Unhandled message type: " << idx.get(35) << "\n";
         }
     }
     
+    void onDisconnected(FixSession& session) override {
+        if (&session == m_spare) {
+            m_spare_ready = false;
+            m_spare_busy = false;
+            std::cerr << "[FIX] Standby connection lost\n";
+            scheduleStandby();
+            return;
+        }
+        std::cerr << "[FIX] Connection lost\n";
+        g_fix_connected.store(false);
+        m_in_seq = session.getExpectedSeq();
+        m_store.setNextInSeq(m_in_seq);
+        if (m_logon_timer) m_reactor.cancelTimer(m_logon_timer);
+        if (m_hb_timer) m_reactor.cancelTimer(m_hb_timer);
+        m_logon_timer = 0;
+        m_hb_timer = 0;
+        if (!m_running) return;
+        
+        if (promoteStandby()) return;
+        // Never got through TCP/TLS: the cached address may be stale
+        if (!m_active_up) m_resolver.invalidate();
+        scheduleReconnect();
+    }
+    
+    // Logs on over the warm spare, if there is one; the dropped session
+    // becomes the spare and is re-warmed once the logon completes
+    bool promoteStandby() {
+        if (!m_spare_ready) return false;
+        std::swap(m_active, m_spare);
+        m_spare_ready = false;
+        m_spare_busy = false;
+        m_active_up = true;
+        m_active->connectTiming() = FixConnectTiming();
+        m_active->connectTiming().standby = true;
+        m_active->updateLastInbound();      // idle until now; start the heartbeat clock
+        std::cout << "[FIX] Promoting standby connection\n";
+        logon(*m_active);
+        return true;
+    }
+    
+    void publishTiming(FixSession& session) {
+        FixConnectTiming& t = session.connectTiming();
+        t.logon_ns = static_cast<int64_t>(plat::monotonic_time_ns()) - m_logon_sent_ns;
+        {
+            std::lock_guard<std::mutex> lg(g_connect_timing_mtx);
+            g_connect_timing = t;
+        }
+        std::cout << std::fixed << std::setprecision(3)
+                  << "[FIX] Connect timing: dns " << t.dns_ns / 1e6 << "ms" << (t.dns_cached ? " (cached)" : "")
+                  << ", tcp " << t.tcp_ns / 1e6 << "ms"
+                  << ", tls " << t.tls_ns / 1e6 << "ms" << (t.tls_resumed ? " (resumed)" : "")
+                  << ", logon " << t.logon_ns / 1e6 << "ms"
+                  << ", total " << t.totalNs() / 1e6 << "ms" << (t.standby ? " (standby)" : "") << "\n";
+    }
+    
+    // Typed handlers for the market data loop, bound through fixDispatch
+    struct MarketDataHandler {
+        BlackBullFIX& fix;
+
+        void onSecurityList(std::string_view, const FixTagIndex& idx) {
+            fix.subscribe(idx);
+        }
+
+        void onMarketDataSnapshot(std::string_view, const FixTagIndex& idx) {
+            std::cout << "[FIX] Market data snapshot received!\n";
+            fix.parseMarketData(idx);
+            FixQuote gold = g_quotes.load(g_gold);
+            std::cout << "[FIX] Gold: " << std::fixed << std::setprecision(2) 
+                      << gold.bid << " / " << gold.ask << "\n";
+        }
+
+        void onMarketDataIncremental(std::string_view, const FixTagIndex& idx) {
+            fix.parseMarketData(idx);
+        }
+
+        void onHeartbeat(std::string_view msg, const FixTagIndex&) {
+            std::cout << "[FIX] Heartbeat received, sending response\n";
+            // Echo heartbeat back; coalesced with whatever else this batch produces
+            fix.sendUnstored(msg, false);
+        }
+
+        void onTestRequest(std::string_view, const FixTagIndex& idx) {
+            if (!idx.has(112)) return;
+            fix.sendTestResponse(idx.get(112));
+        }
+
+        void onResendRequest(std::string_view, const FixTagIndex& idx) {
+            fix.resend(idx);
+        }
+
+        // GapFill or Reset: NewSeqNo (36) is the next seq to expect
+        void onSequenceReset(std::string_view, const FixTagIndex& idx) {
+            int64_t new_seq = 0;
+            if (parseFixInt(idx.get(36), new_seq) == FixNumError::None) {
+                fix.m_active->applySequenceReset(new_seq);
+            }
+        }
+    };
+    
     std::atomic<bool> m_running;
     std::thread m_thread;
-    int m_socket;
+    FixReactor m_reactor;
     int m_seq_num;
-    SSL_CTX* m_ssl_ctx;
-    SSL* m_ssl;
+    int m_in_seq;                   // next seq expected from the broker, across connections
+    FixResolver m_resolver;
+    FixTlsClient m_tls;
+    FixSession* m_active;           // carries the logon and market data
+    FixSession* m_spare;            // standby, or idle
+    bool m_spare_busy;              // m_spare is connecting or connected
+    bool m_spare_ready;             // m_spare is through TLS and can be promoted
+    bool m_active_up;               // m_active got through TLS this attempt
+    int64_t m_logon_sent_ns;
+    uint64_t m_logon_timer;
+    uint64_t m_hb_timer;
+    FixPricePrecision m_precision;
+    FixMdBatch m_md;
+    FixEncoder m_enc;
+    FixMsgTemplate m_logon_tmpl;
+    FixMsgTemplate m_security_list_tmpl;
+    std::vector<FixMsgTemplate> m_md_tmpls;
+    FixMsgTemplate m_gap_fill_tmpl;
+    FixMsgTemplate m_resend_tmpl;
+    FixMsgTemplate m_heartbeat_tmpl;
+    FixTagIndex m_held_idx;         // for messages replayed from the gap buffer
+    FixMessageStore m_store;
 };
 
 class TradingDashboard {
 public:
-    TradingDashboard(int port) : m_port(port), m_running(false), m_server_fd(-1) {}
+    TradingDashboard(int port) : m_port(port), m_running(false), m_server_fd(INVALID_SOCKET_FD) {}
     
     ~TradingDashboard() {
         stop();
@@ -464,10 +715,10 @@ public:
     void stop() {
         if (!m_running) return;
         m_running = false;
-        if (m_server_fd >= 0) {
-            shutdown(m_server_fd, SHUT_RDWR);
-            close(m_server_fd);
-            m_server_fd = -1;
+        if (m_server_fd != INVALID_SOCKET_FD) {
+            plat::socket_shutdown(m_server_fd);
+            plat::socket_close(m_server_fd);
+            m_server_fd = INVALID_SOCKET_FD;
         }
         if (m_thread.joinable()) {
             m_thread.join();
@@ -483,25 +734,84 @@ private:
     }
     
     std::string buildDataJSON() {
-        double bid = g_gold_bid.load();
-        double ask = g_gold_ask.load();
-        double mid = (bid + ask) / 2.0;
+        FixQuote gold = g_quotes.load(g_gold);
         bool connected = g_fix_connected.load();
         
         std::stringstream ss;
         ss << std::fixed << std::setprecision(2);
         ss << "{\"time\":\"" << getCurrentTime() << "\""
-           << ",\"price\":" << mid
-           << ",\"bid\":" << bid
-           << ",\"ask\":" << ask
-           << ",\"spread\":" << (ask - bid)
+           << ",\"price\":" << gold.mid()
+           << ",\"bid\":" << gold.bid
+           << ",\"ask\":" << gold.ask
+           << ",\"spread\":" << gold.spread()
+           << ",\"bid_size\":" << gold.bid_size
+           << ",\"ask_size\":" << gold.ask_size
+           << ",\"quote_updates\":" << gold.updates
            << ",\"connected\":" << (connected ? "true" : "false")
-           << "}";
+           << ",\"feed_latency_p50_ms\":" << g_feed_latency.percentileMs(0.50)
+           << ",\"feed_latency_p99_ms\":" << g_feed_latency.percentileMs(0.99)
+           << ",\"clock_offset_ms\":" << g_feed_latency.clockOffsetNs() / 1e6;
+        
+        // TLS records/s and SSL_write calls per message since the last poll
+        auto now = std::chrono::steady_clock::now();
+        FixOutboundStats tx = g_fix_sessions[0].outboundStats();
+        tx += g_fix_sessions[1].outboundStats();
+        FixOutboundRates rates = FixOutboundRates::between(
+            m_tx_prev, tx, std::chrono::duration<double>(now - m_tx_prev_time).count());
+        m_tx_prev = tx;
+        m_tx_prev_time = now;
+        ss << ",\"tx_records_per_sec\":" << rates.records_per_sec
+           << ",\"tx_writes_per_msg\":" << rates.writes_per_message;
+        
+        // Stage timing of the last logon, ms
+        FixConnectTiming ct;
+        {
+            std::lock_guard<std::mutex> lg(g_connect_timing_mtx);
+            ct = g_connect_timing;
+        }
+        ss << std::setprecision(3)
+           << ",\"connect_dns_ms\":" << ct.dns_ns / 1e6
+           << ",\"connect_tcp_ms\":" << ct.tcp_ns / 1e6
+           << ",\"connect_tls_ms\":" << ct.tls_ns / 1e6
+           << ",\"connect_logon_ms\":" << ct.logon_ns / 1e6
+           << ",\"connect_total_ms\":" << ct.totalNs() / 1e6
+           << ",\"connect_dns_cached\":" << (ct.dns_cached ? "true" : "false")
+           << ",\"connect_tls_resumed\":" << (ct.tls_resumed ? "true" : "false")
+           << ",\"connect_standby\":" << (ct.standby ? "true" : "false");
+        
+        // Inbound gap recovery: held depth and how long holes took to fill
+        FixGapStats gaps = g_fix_sessions[0].gapStats();
+        gaps += g_fix_sessions[1].gapStats();
+        ss << ",\"gap_count\":" << gaps.gaps
+           << ",\"gap_depth\":" << gaps.depth
+           << ",\"gap_max_depth\":" << gaps.max_depth
+           << ",\"gap_held\":" << gaps.held
+           << ",\"gap_requested\":" << gaps.requested
+           << ",\"gap_rerequests\":" << gaps.rerequests
+           << ",\"gap_overflows\":" << gaps.overflows
+           << ",\"gap_last_recovery_ms\":" << gaps.last_recovery_ns / 1e6
+           << ",\"gap_max_recovery_ms\":" << gaps.max_recovery_ns / 1e6;
+        
+        // Every subscribed symbol, in handle order; names are settled once
+        // the first SecurityList is in
+        ss << std::setprecision(5) << ",\"quotes\":[";
+        size_t symbols = g_symbols.ready() ? g_symbols.size() : 0;
+        for (FixSymbolHandle h = 0; h < symbols; ++h) {
+            FixQuote q = g_quotes.load(h);
+            FixDepth d = g_books.depth(h);
+            ss << (h ? "," : "") << "{\"symbol\":\"" << g_symbols[h].name << "\""
+               << ",\"bid\":" << q.bid << ",\"ask\":" << q.ask
+               << ",\"updates\":" << q.updates
+               << ",\"depth_top\":" << d.depth_top
+               << ",\"bid_depth\":" << d.bid_depth << ",\"ask_depth\":" << d.ask_depth
+               << ",\"imbalance\":" << d.imbalance << "}";
+        }
+        ss << "]}";
         return ss.str();
     }
     
     std::string buildDashboard() {
-        double price = (g_gold_bid.load() + g_gold_ask.load()) / 2.0;
+        double price = g_quotes.load(g_gold).mid();
         std::stringstream priceStr;
         priceStr << std::fixed << std::setprecision(2) << price;
         
@@ -648,50 +958,39 @@ updateData();
     }
     
     void run() {
-        m_server_fd = socket(AF_INET, SOCK_STREAM, 0);
-        if (m_server_fd < 0) {
+        plat::set_thread_name("dashboard");
+        m_server_fd = plat::create_tcp();
+        if (m_server_fd == INVALID_SOCKET_FD) {
             std::cerr << "[GUI] Failed to create socket\n";
             return;
         }
         
-        int opt = 1;
-        setsockopt(m_server_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
-        
-        sockaddr_in addr{};
-        addr.sin_family = AF_INET;
-        addr.sin_addr.s_addr = INADDR_ANY;
-        addr.sin_port = htons(m_port);
+        plat::set_reuseaddr(m_server_fd);
         
-        if (bind(m_server_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        if (!plat::socket_listen(m_server_fd, static_cast<uint16_t>(m_port), 5)) {
             std::cerr << "[GUI] Failed to bind to port " << m_port << "\n";
-            close(m_server_fd);
-            m_server_fd = -1;
+            plat::socket_close(m_server_fd);
+            m_server_fd = INVALID_SOCKET_FD;
             return;
         }
         
-        listen(m_server_fd, 5);
         std::cout << "[GUI] Dashboard server listening on port " << m_port << "\n";
         
         while (m_running) {
-            fd_set readfds;
-            FD_ZERO(&readfds);
-            FD_SET(m_server_fd, &readfds);
-            
-            timeval tv{1, 0};
-            int activity = select(m_server_fd + 1, &readfds, nullptr, nullptr, &tv);
+            int activity = plat::wait_readable(m_server_fd, 1000);
             
             if (activity < 0 && m_running) break;
             if (activity == 0) continue;
             if (!m_running) break;
             
-            int client_fd = accept(m_server_fd, nullptr, nullptr);
-            if (client_fd < 0) {
+            socket_t client_fd = plat::socket_accept(m_server_fd);
+            if (client_fd == INVALID_SOCKET_FD) {
                 if (m_running) std::cerr << "[GUI] Accept failed\n";
                 break;
             }
             
             char buffer[4096] = {0};
-            ssize_t bytes_read = read(client_fd, buffer, sizeof(buffer) - 1);
+            int bytes_read = plat::socket_recv(client_fd, buffer, sizeof(buffer) - 1);
             (void)bytes_read;
             
             std::string request(buffer);
@@ -711,10 +1010,10 @@ updateData();
                     "Connection: close\r\n\r\n" + html;
             }
             
-            ssize_t bytes_written = write(client_fd, response.c_str(), response.length());
+            int bytes_written = plat::socket_send(client_fd, response.c_str(), static_cast<int>(response.length()));
             (void)bytes_written;
             
-            close(client_fd);
+            plat::socket_close(client_fd);
         }
         
         std::cout << "[GUI] Dashboard server stopped\n";
@@ -723,7 +1022,9 @@ updateData();
     int m_port;
     std::atomic<bool> m_running;
     std::thread m_thread;
-    int m_server_fd;
+    socket_t m_server_fd;
+    FixOutboundStats m_tx_prev;
+    std::chrono::steady_clock::time_point m_tx_prev_time = std::chrono::steady_clock::now();
 };
 
 }
@@ -738,6 +1039,7 @@ void sig(int){
 int main(int argc, char* argv[]) {
     signal(SIGINT, sig);
     signal(SIGTERM, sig);
+    plat::init();
     
     // Load configuration
     std::string config_file = (argc > 1) ? argv[1] : "config.ini";
@@ -751,14 +1053,21 @@ int main(int argc, char* argv[]) {
     std::cout << "  CHIMERA v7.0 - LIVE Gold Trading\n";
     std::cout << "  Configuration loaded from: " << config_file << "\n";
     std::cout << "?????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????\n";
+    chimera::g_symbols.configure(chimera::g_config.symbols);
+    chimera::g_gold = chimera::g_symbols.byName("XAUUSD");
+    
     std::cout << "  FIX Settings:\n";
     std::cout << "  Host: " << chimera::g_config.host << ":" << chimera::g_config.port << "\n";
     std::cout << "  SenderCompID: " << chimera::g_config.sender_comp_id << "\n";
     std::cout << "  TargetCompID: " << chimera::g_config.target_comp_id << "\n";
     std::cout << "  TargetSubID: " << chimera::g_config.target_sub_id << "\n";
+    std::cout << "  Symbols: " << chimera::g_config.symbols << " (" << chimera::g_symbols.size() << ")\n";
     std::cout << "  Username: " << chimera::g_config.username << "\n";
     std::cout << "  Password: " << chimera::g_config.password << "\n";
     std::cout << "  Dashboard: http://185.167.119.59:" << chimera::g_config.dashboard_port << "\n";
+    std::cout << "  FIX kernels: " << chimera::simdLevelName(chimera::fixSimd().level) << "\n";
+    std::cout << "  Quote thread: " << (chimera::g_config.quote_spin.enabled ? "spin" : "blocking")
+              << ", cpu " << chimera::g_config.quote_cpu << "\n";
     std::cout << "?????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????\n\n";
     
     chimera::BlackBullFIX fix;
@@ -770,12 +1079,13 @@ int main(int argc, char* argv[]) {
     std::cout << "[CHIMERA] Press Ctrl+C to stop\n\n";
     
     while (run) {
-        sleep(1);
+        plat::sleep_us(1000000);
     }
     
     std::cout << "[CHIMERA] Shutting down...\n";
     fix.stop();
     dashboard.stop();
+    plat::cleanup();
     std::cout << "[CHIMERA] Shutdown complete\n";
     
     return 0;
@@ -0,0 +1,765 @@
+// ChimeraMetals tools
+// fix_acceptor_sim.cpp - Local TLS FIX 4.4 acceptor for load and latency tests
+//
+// Plays the cTrader side of the QUOTE and TRADE sessions on one box so the
+// client (FixSession, BlackBullFIX, the BASELINE dual-session loops) can be
+// driven end to end without the live endpoint:
+//   Logon          answered in kind; 141=Y resets both sequence numbers,
+//                  otherwise they carry over from the last connection
+//   Heartbeat      sent when idle; TestRequest answered with 112 echoed
+//   ResendRequest  ExecutionReports resent with 43=Y, everything else
+//                  (market data, admin, scripted gaps) SequenceReset-GapFill
+//   SecurityListRequest  -> SecurityList of the configured symbols
+//   MarketDataRequest    -> W snapshot, then a W or X stream at --rate;
+//                           each X deletes (279=2) the entries before it
+//   NewOrderSingle       -> ExecutionReport New, then Fill at the sim price
+// An inbound sequence gap is answered with a ResendRequest.
+//
+// Scripted events run at a time after each session's logon, so a drop
+// repeats on every reconnect:
+//   --at SEC:gap:N     skip N outbound sequence numbers
+//   --at SEC:drop      close the socket without Logout (a broker drop)
+//   --at SEC:logout    send Logout, then close
+//   --at SEC:rate:N    change the stream rate
+//
+// Usage: fix_acceptor_sim [options]
+//   --port N           listen port, repeatable (default 9443)
+//   --cert F --key F   PEM pair; an ephemeral self-signed P-256 one otherwise
+//   --rate N           market data messages/s per subscription (default 1000)
+//   --entries N        MD entries per X message (default 2)
+//   --stream W|X       stream full snapshots or incrementals (default X)
+//   --symbols LIST     id:name:digits:price,... (default
+//                      41:XAUUSD:2:2650.00,42:XAGUSD:3:31.000)
+//   --time seconds|ms|us  SendingTime precision (default us)
+//   --duration SEC     exit after SEC seconds (default: until SIGINT)
+//
+// SendingTime is stamped just before the write, so the client's
+// feed_latency is a direct loopback wire + TLS + parse measurement. Totals
+// are printed every second.
+
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "platform/platform.hpp"
+
+#include "core/FixDispatch.hpp"
+#include "core/FixEncoder.hpp"
+#include "core/FixNumeric.hpp"
+#include "core/FixRecvRing.hpp"
+#include "core/FixTagIndex.hpp"
+#include "core/FixTime.hpp"
+
+namespace {
+
+using namespace chimera;
+
+struct SimSymbol {
+    std::string id;             // cTrader SecurityID, e.g. 41
+    std::string name;           // e.g. XAUUSD
+    int digits = 2;
+    int64_t start_ticks = 0;
+};
+
+enum class SimAction { Gap, Drop, Logout, Rate };
+
+struct SimEvent {
+    int64_t at_ns = 0;
+    SimAction action = SimAction::Drop;
+    int64_t value = 0;
+};
+
+struct SimConfig {
+    std::vector<uint16_t> ports;
+    std::string cert_file;
+    std::string key_file;
+    int64_t rate = 1000;
+    int entries = 2;
+    bool stream_snapshots = false;
+    std::vector<SimSymbol> symbols;
+    FixTimePrecision precision = FixTimePrecision::Micros;
+    int64_t duration_sec = 0;
+    std::vector<SimEvent> script;
+};
+
+struct SimTotals {
+    std::atomic<uint64_t> md_messages{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> orders{0};
+    std::atomic<uint64_t> resend_requests{0};
+    std::atomic<uint64_t> inbound_gaps{0};
+    std::atomic<int> sessions{0};
+};
+
+SimConfig g_sim;
+SimTotals g_totals;
+std::atomic<bool> g_running{true};
+
+// Sequence numbers and resendable ExecutionReports per counterparty,
+// kept across connections for logons without 141=Y
+struct SimSeqState {
+    int64_t next_out = 1;
+    int64_t next_in = 1;
+    std::map<int64_t, std::string> exec_reports;   // seq -> body after SendingTime
+};
+
+std::mutex g_seq_lock;
+std::map<std::string, SimSeqState> g_seq_states;
+
+int64_t nowNs() {
+    return static_cast<int64_t>(plat::monotonic_time_ns());
+}
+
+// Deterministic random walk of one tick per step
+class SimPrice {
+public:
+    explicit SimPrice(int64_t start, uint64_t seed) : bid_(start), state_(seed | 1) {}
+
+    int64_t step() {
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 7;
+        state_ ^= state_ << 17;
+        bid_ += (state_ & 1) ? 1 : -1;
+        if (bid_ < 1) bid_ = 1;
+        return bid_;
+    }
+
+    int64_t bid() const { return bid_; }
+    int64_t ask(int digits) const { return bid_ + (digits >= 3 ? 20 : 15); }
+
+private:
+    int64_t bid_;
+    uint64_t state_;
+};
+
+// One accepted connection, served on its own thread
+class SimSession {
+public:
+    static const size_t FLUSH_BYTES = 16384;
+    static const size_t MAX_BATCH = 4096;
+
+    SimSession(SSL* ssl, socket_t fd, uint16_t port)
+        : ssl_(ssl), fd_(fd), port_(port), state_(nullptr), logged_on_(false), open_(true),
+          heartbeat_ns_(30LL * 1000000000LL), logon_ns_(0), last_out_ns_(0), last_in_ns_(0),
+          rate_(g_sim.rate), stream_start_ns_(0), streamed_(0), next_event_(0), order_id_(0)
+    {
+        for (size_t i = 0; i < g_sim.symbols.size(); ++i) {
+            prices_.emplace_back(g_sim.symbols[i].start_ticks, 0x9E3779B97F4A7C15ull + i);
+        }
+    }
+
+    void run() {
+        g_totals.sessions.fetch_add(1);
+        last_in_ns_ = nowNs();
+        while (open_ && g_running.load(std::memory_order_relaxed)) {
+            bool streaming = !subscriptions_.empty() && rate_ > 0;
+            if (SSL_pending(ssl_) > 0 || plat::wait_readable(fd_, streaming ? 1 : 100) > 0) {
+                if (!readSome()) break;
+            }
+            int64_t now = nowNs();
+            runScript(now);
+            if (!open_) break;
+            if (streaming) stream(now);
+            idleChecks(now);
+            if (!flush()) break;
+        }
+        close();
+        g_totals.sessions.fetch_sub(1);
+    }
+
+    // fixDispatch handlers
+    void onLogon(std::string_view, const FixTagIndex& idx) {
+        if (logged_on_) return;
+        ids_.begin_string = "FIX.4.4";
+        ids_.sender_comp_id = std::string(idx.get(56));
+        ids_.target_comp_id = std::string(idx.get(49));
+        ids_.sender_sub_id = std::string(idx.get(57));
+        ids_.target_sub_id = std::string(idx.get(50));
+        ids_.sending_time_precision = g_sim.precision;
+        buildTemplates();
+
+        std::string key = ids_.target_comp_id + "/" + ids_.sender_sub_id;
+        bool reset = idx.get(141) == "Y";
+        {
+            std::lock_guard<std::mutex> lock(g_seq_lock);
+            state_ = &g_seq_states[key];
+            if (reset) *state_ = SimSeqState();
+        }
+        int64_t seq = 0;
+        parseFixInt(idx.get(34), seq);
+        state_->next_in = seq + 1;
+
+        int hb = 30;
+        if (parseFixInt(idx.get(108), hb) == FixNumError::None && hb > 0) {
+            heartbeat_ns_ = static_cast<int64_t>(hb) * 1000000000LL;
+        }
+        std::string logon_body = "98=0\x01" "108=" + std::to_string(hb) + "\x01";
+        if (reset) logon_body += "141=Y\x01";
+        out(enc_.begin(t_logon_, nextOut()).fields(FixStaticFields(logon_body)).finish());
+
+        logged_on_ = true;
+        logon_ns_ = nowNs();
+        last_out_ns_ = logon_ns_;
+        next_event_ = 0;
+        std::printf("[SIM %u] logon %s%s seq in %lld out %lld\n", port_, key.c_str(),
+                    reset ? " (reset)" : "", static_cast<long long>(state_->next_in),
+                    static_cast<long long>(state_->next_out));
+    }
+
+    void onLogout(std::string_view, const FixTagIndex&) {
+        out(enc_.begin(t_logout_, nextOut()).finish());
+        open_ = false;
+    }
+
+    void onTestRequest(std::string_view, const FixTagIndex& idx) {
+        out(enc_.begin(t_heartbeat_, nextOut()).field(112, idx.get(112)).finish());
+    }
+
+    void onSequenceReset(std::string_view, const FixTagIndex& idx) {
+        int64_t new_seq = 0;
+        if (parseFixInt(idx.get(36), new_seq) == FixNumError::None) state_->next_in = new_seq;
+    }
+
+    void onResendRequest(std::string_view, const FixTagIndex& idx) {
+        int64_t begin = 0, end = 0;
+        parseFixInt(idx.get(7), begin);
+        parseFixInt(idx.get(16), end);
+        g_totals.resend_requests.fetch_add(1, std::memory_order_relaxed);
+
+        int64_t last = state_->next_out - 1;
+        if (end == 0 || end > last) end = last;
+        if (begin < 1) begin = 1;
+        int64_t gap_from = 0;
+        for (int64_t seq = begin; seq <= end; ++seq) {
+            auto it = state_->exec_reports.find(seq);
+            if (it == state_->exec_reports.end()) {
+                if (!gap_from) gap_from = seq;
+                continue;
+            }
+            if (gap_from) gapFill(gap_from, seq);
+            gap_from = 0;
+            out(enc_.begin(t_exec_, seq).field(43, 'Y').fields(FixStaticFields(it->second)).finish());
+        }
+        if (gap_from) gapFill(gap_from, end + 1);
+        std::printf("[SIM %u] resend %lld-%lld\n", port_,
+                    static_cast<long long>(begin), static_cast<long long>(end));
+    }
+
+    void onSecurityListRequest(std::string_view, const FixTagIndex& idx) {
+        std::string body = "320=" + std::string(idx.get(320)) + "\x01"
+                           "322=" + std::to_string(++order_id_) + "\x01"
+                           "560=0\x01"
+                           "146=" + std::to_string(g_sim.symbols.size()) + "\x01";
+        for (const SimSymbol& s : g_sim.symbols) {
+            body += "55=" + s.id + "\x01" "1007=" + s.name + "\x01"
+                    "1008=" + std::to_string(s.digits) + "\x01";
+        }
+        out(enc_.begin(t_security_list_, nextOut()).fields(FixStaticFields(body)).finish());
+    }
+
+    void onMarketDataRequest(std::string_view, const FixTagIndex& idx) {
+        std::string req_id(idx.get(262));
+        bool unsubscribe = idx.get(263) == "2";
+        for (size_t i = 0; i < idx.fieldCount(); ++i) {
+            if (idx.field(i).tag != 55) continue;
+            int sym = findSymbol(idx.value(i));
+            if (sym < 0) {
+                std::printf("[SIM %u] unknown symbol %.*s\n", port_,
+                            static_cast<int>(idx.value(i).size()), idx.value(i).data());
+                continue;
+            }
+            auto it = std::find_if(subscriptions_.begin(), subscriptions_.end(),
+                                   [sym](const Subscription& s) { return s.symbol == sym; });
+            if (unsubscribe) {
+                if (it != subscriptions_.end()) subscriptions_.erase(it);
+                continue;
+            }
+            if (it == subscriptions_.end()) {
+                subscriptions_.push_back(Subscription{sym, std::string(idx.value(i)), req_id, {}});
+                it = subscriptions_.end() - 1;
+            }
+            snapshot(*it);
+        }
+        stream_start_ns_ = nowNs();
+        streamed_ = 0;
+    }
+
+    void onNewOrderSingle(std::string_view, const FixTagIndex& idx) {
+        g_totals.orders.fetch_add(1, std::memory_order_relaxed);
+        int sym = findSymbol(idx.get(55));
+        const SimSymbol* s = sym >= 0 ? &g_sim.symbols[static_cast<size_t>(sym)] : nullptr;
+        std::string order_id = "SIM" + std::to_string(++order_id_);
+        std::string common = "37=" + order_id + "\x01"
+                             "11=" + std::string(idx.get(11)) + "\x01"
+                             "55=" + std::string(idx.get(55)) + "\x01"
+                             "54=" + std::string(idx.get(54)) + "\x01"
+                             "38=" + std::string(idx.get(38)) + "\x01"
+                             "40=" + std::string(idx.get(40)) + "\x01";
+        if (!s) {
+            execReport(common + "17=" + order_id + "R\x01" "150=8\x01" "39=8\x01"
+                       "14=0\x01" "151=0\x01" "6=0\x01" "58=Unknown symbol\x01");
+            return;
+        }
+        const SimPrice& p = prices_[static_cast<size_t>(sym)];
+        int64_t px = idx.get(54) == "1" ? p.ask(s->digits) : p.bid();
+        std::string price = formatTicks(px, s->digits);
+        std::string qty(idx.get(38));
+        execReport(common + "17=" + order_id + "N\x01" "150=0\x01" "39=0\x01"
+                   "14=0\x01" "151=" + qty + "\x01" "6=0\x01");
+        execReport(common + "17=" + order_id + "F\x01" "150=F\x01" "39=2\x01"
+                   "31=" + price + "\x01" "32=" + qty + "\x01"
+                   "14=" + qty + "\x01" "151=0\x01" "6=" + price + "\x01");
+    }
+
+    void onHeartbeat(std::string_view, const FixTagIndex&) {}
+
+private:
+    struct Subscription {
+        int symbol;
+        std::string wire_symbol;    // as requested: name or SecurityID
+        std::string req_id;
+        std::vector<std::pair<int64_t, bool>> live;     // 278 and side (offer) on the client's book
+    };
+
+    void buildTemplates() {
+        t_logon_ = FixMsgTemplate(ids_, "A");
+        t_logout_ = FixMsgTemplate(ids_, "5");
+        t_heartbeat_ = FixMsgTemplate(ids_, "0");
+        t_resend_ = FixMsgTemplate(ids_, "2");
+        t_seq_reset_ = FixMsgTemplate(ids_, "4");
+        t_security_list_ = FixMsgTemplate(ids_, "y");
+        t_snapshot_ = FixMsgTemplate(ids_, "W");
+        t_incremental_ = FixMsgTemplate(ids_, "X");
+        t_exec_ = FixMsgTemplate(ids_, "8");
+    }
+
+    int64_t nextOut() {
+        return state_->next_out++;
+    }
+
+    // Sim prices are positive
+    static std::string formatTicks(int64_t ticks, int digits) {
+        char buf[32];
+        if (digits <= 0) {
+            std::snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(ticks));
+        } else {
+            int64_t scale = fixPow10(digits);
+            std::snprintf(buf, sizeof(buf), "%lld.%0*lld", static_cast<long long>(ticks / scale),
+                          digits, static_cast<long long>(ticks % scale));
+        }
+        return buf;
+    }
+
+    int findSymbol(std::string_view v) const {
+        for (size_t i = 0; i < g_sim.symbols.size(); ++i) {
+            if (g_sim.symbols[i].id == v || g_sim.symbols[i].name == v) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    void gapFill(int64_t from, int64_t new_seq) {
+        out(enc_.begin(t_seq_reset_, from).field(43, 'Y').field(123, 'Y').field(36, new_seq).finish());
+    }
+
+    void execReport(const std::string& body) {
+        int64_t seq = nextOut();
+        state_->exec_reports[seq] = body;
+        out(enc_.begin(t_exec_, seq).fields(FixStaticFields(body)).finish());
+    }
+
+    // The whole book as cTrader sends it for full depth: one 278 per entry
+    void snapshot(Subscription& sub) {
+        const SimSymbol& s = g_sim.symbols[static_cast<size_t>(sub.symbol)];
+        const SimPrice& p = prices_[static_cast<size_t>(sub.symbol)];
+        int64_t bid_id = static_cast<int64_t>(++entry_id_), ask_id = static_cast<int64_t>(++entry_id_);
+        out(enc_.begin(t_snapshot_, nextOut())
+                .field(262, sub.req_id)
+                .field(55, sub.wire_symbol)
+                .field(268, 2)
+                .field(269, '0').field(278, bid_id).price(270, p.bid(), s.digits).field(271, 1000000)
+                .field(269, '1').field(278, ask_id).price(270, p.ask(s.digits), s.digits).field(271, 1000000)
+                .finish());
+        sub.live.assign({{bid_id, false}, {ask_id, true}});
+        g_totals.md_messages.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Deletes what the last message added, then adds --entries new quotes
+    void incremental(Subscription& sub) {
+        const SimSymbol& s = g_sim.symbols[static_cast<size_t>(sub.symbol)];
+        SimPrice& p = prices_[static_cast<size_t>(sub.symbol)];
+        enc_.begin(t_incremental_, nextOut()).field(268, static_cast<int64_t>(sub.live.size()) + g_sim.entries);
+        for (const std::pair<int64_t, bool>& e : sub.live) {
+            enc_.field(279, '2').field(269, e.second ? '1' : '0')
+                .field(278, e.first)
+                .field(55, sub.wire_symbol);
+        }
+        sub.live.clear();
+        for (int i = 0; i < g_sim.entries; ++i) {
+            bool offer = (i & 1) != 0;
+            int64_t px = offer ? p.ask(s.digits) : p.step();
+            int64_t id = static_cast<int64_t>(++entry_id_);
+            enc_.field(279, '0').field(269, offer ? '1' : '0')
+                .field(278, id)
+                .field(55, sub.wire_symbol)
+                .price(270, px, s.digits)
+                .field(271, static_cast<int64_t>(100000 * (i / 2 + 1)));
+            sub.live.emplace_back(id, offer);
+        }
+        out(enc_.finish());
+        g_totals.md_messages.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Emits every message due since the stream started, round-robin over
+    // the subscriptions, at most MAX_BATCH per call so reads are not starved
+    void stream(int64_t now) {
+        int64_t due = static_cast<int64_t>(
+            static_cast<double>(now - stream_start_ns_) * static_cast<double>(rate_) / 1e9) - streamed_;
+        if (due <= 0) return;
+        int64_t n = std::min<int64_t>(due, MAX_BATCH);
+        for (int64_t i = 0; i < n; ++i) {
+            Subscription& sub = subscriptions_[static_cast<size_t>(streamed_ + i) % subscriptions_.size()];
+            if (g_sim.stream_snapshots) {
+                prices_[static_cast<size_t>(sub.symbol)].step();
+                snapshot(sub);
+            } else {
+                incremental(sub);
+            }
+            if (pending_.size() >= FLUSH_BYTES && !flush()) return;
+        }
+        streamed_ += n;
+    }
+
+    void runScript(int64_t now) {
+        if (!logged_on_) return;
+        while (next_event_ < g_sim.script.size() &&
+               now - logon_ns_ >= g_sim.script[next_event_].at_ns) {
+            const SimEvent& e = g_sim.script[next_event_++];
+            switch (e.action) {
+            case SimAction::Gap:
+                std::printf("[SIM %u] gap of %lld at seq %lld\n", port_,
+                            static_cast<long long>(e.value), static_cast<long long>(state_->next_out));
+                state_->next_out += e.value;
+                break;
+            case SimAction::Drop:
+                std::printf("[SIM %u] drop\n", port_);
+                open_ = false;
+                return;
+            case SimAction::Logout:
+                std::printf("[SIM %u] logout\n", port_);
+                out(enc_.begin(t_logout_, nextOut()).field(58, "scripted").finish());
+                flush();
+                open_ = false;
+                return;
+            case SimAction::Rate:
+                std::printf("[SIM %u] rate %lld/s\n", port_, static_cast<long long>(e.value));
+                rate_ = e.value;
+                stream_start_ns_ = now;
+                streamed_ = 0;
+                break;
+            }
+        }
+    }
+
+    void idleChecks(int64_t now) {
+        if (!logged_on_) return;
+        if (now - last_out_ns_ >= heartbeat_ns_) {
+            out(enc_.begin(t_heartbeat_, nextOut()).finish());
+        }
+        if (now - last_in_ns_ >= 3 * heartbeat_ns_) {
+            std::printf("[SIM %u] client silent, closing\n", port_);
+            open_ = false;
+        }
+    }
+
+    bool readSome() {
+        int n = SSL_read(ssl_, ring_.writePtr(), static_cast<int>(std::min<size_t>(ring_.writable(), 1 << 30)));
+        if (n <= 0) return false;
+        ring_.commit(static_cast<size_t>(n));
+        last_in_ns_ = nowNs();
+
+        std::string_view msg;
+        FixRecvRing::Frame f;
+        while ((f = ring_.next(msg)) == FixRecvRing::Frame::Complete) {
+            if (!idx_.parse(msg)) continue;
+            if (!checkInboundSeq(idx_)) return false;
+            fixDispatch(*this, msg, idx_);
+            if (!open_) return true;
+        }
+        return f != FixRecvRing::Frame::Malformed;
+    }
+
+    // Before logon only a Logon is accepted. A gap is answered with a
+    // ResendRequest and the message still processed; a seq below the
+    // expected one without PossDup ends the session.
+    bool checkInboundSeq(const FixTagIndex& idx) {
+        FixMsgType type = fixMsgType(idx.get(35));
+        if (!logged_on_) return type == FixMsgType::Logon;
+        int64_t seq = 0;
+        if (parseFixInt(idx.get(34), seq) != FixNumError::None) return true;
+        if (type == FixMsgType::SequenceReset) return true;
+        if (seq > state_->next_in) {
+            g_totals.inbound_gaps.fetch_add(1, std::memory_order_relaxed);
+            out(enc_.begin(t_resend_, nextOut()).field(7, state_->next_in).field(16, 0).finish());
+        } else if (seq < state_->next_in) {
+            if (idx.get(43) == "Y") return true;
+            out(enc_.begin(t_logout_, nextOut()).field(58, "MsgSeqNum too low").finish());
+            flush();
+            return false;
+        }
+        state_->next_in = seq + 1;
+        return true;
+    }
+
+    void out(std::string_view msg) {
+        pending_.append(msg.data(), msg.size());
+    }
+
+    bool flush() {
+        size_t off = 0;
+        while (off < pending_.size()) {
+            int n = SSL_write(ssl_, pending_.data() + off, static_cast<int>(pending_.size() - off));
+            if (n <= 0) {
+                pending_.clear();
+                open_ = false;
+                return false;
+            }
+            off += static_cast<size_t>(n);
+        }
+        if (off) {
+            g_totals.bytes.fetch_add(off, std::memory_order_relaxed);
+            last_out_ns_ = nowNs();
+        }
+        pending_.clear();
+        return true;
+    }
+
+    void close() {
+        if (!open_ && logged_on_) std::printf("[SIM %u] session closed\n", port_);
+        SSL_free(ssl_);
+        plat::socket_close(fd_);
+    }
+
+    SSL* ssl_;
+    socket_t fd_;
+    uint16_t port_;
+    SimSeqState* state_;
+    bool logged_on_;
+    bool open_;
+    int64_t heartbeat_ns_;
+    int64_t logon_ns_;
+    int64_t last_out_ns_;
+    int64_t last_in_ns_;
+    int64_t rate_;
+    int64_t stream_start_ns_;
+    int64_t streamed_;
+    size_t next_event_;
+    uint64_t order_id_;
+    uint64_t entry_id_ = 0;
+
+    FixSessionIds ids_;
+    FixEncoder enc_;
+    FixMsgTemplate t_logon_, t_logout_, t_heartbeat_, t_resend_, t_seq_reset_;
+    FixMsgTemplate t_security_list_, t_snapshot_, t_incremental_, t_exec_;
+    FixRecvRing ring_;
+    FixTagIndex idx_;
+    std::string pending_;
+    std::vector<Subscription> subscriptions_;
+    std::vector<SimPrice> prices_;
+};
+
+// Ephemeral self-signed certificate so the simulator needs no files
+bool useSelfSigned(SSL_CTX* ctx) {
+    EVP_PKEY* key = EVP_EC_gen("P-256");
+    X509* cert = X509_new();
+    if (!key || !cert) return false;
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 86400);
+    X509_set_pubkey(cert, key);
+    X509_NAME* name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                               reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    bool ok = X509_sign(cert, key, EVP_sha256()) > 0 &&
+              SSL_CTX_use_certificate(ctx, cert) == 1 &&
+              SSL_CTX_use_PrivateKey(ctx, key) == 1;
+    X509_free(cert);
+    EVP_PKEY_free(key);
+    return ok;
+}
+
+void acceptLoop(SSL_CTX* ctx, uint16_t port) {
+    socket_t lfd = plat::create_tcp();
+    plat::set_reuseaddr(lfd);
+    if (!plat::socket_listen(lfd, port, 16)) {
+        std::fprintf(stderr, "[SIM] cannot listen on %u\n", port);
+        g_running = false;
+        return;
+    }
+    std::printf("[SIM] listening on %u\n", port);
+    while (g_running.load()) {
+        if (plat::wait_readable(lfd, 200) <= 0) continue;
+        socket_t fd = plat::socket_accept(lfd);
+        if (fd == INVALID_SOCKET_FD) continue;
+        plat::set_nodelay(fd);
+        SSL* ssl = SSL_new(ctx);
+        SSL_set_fd(ssl, static_cast<int>(fd));
+        if (SSL_accept(ssl) <= 0) {
+            SSL_free(ssl);
+            plat::socket_close(fd);
+            continue;
+        }
+        std::thread([ssl, fd, port]() {
+            SimSession session(ssl, fd, port);
+            session.run();
+        }).detach();
+    }
+    plat::socket_close(lfd);
+}
+
+bool parseSymbols(const std::string& list, std::vector<SimSymbol>& out) {
+    out.clear();
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos) end = list.size();
+        std::string item = list.substr(pos, end - pos);
+        pos = end + 1;
+
+        SimSymbol s;
+        size_t a = item.find(':'), b = item.find(':', a + 1), c = item.find(':', b + 1);
+        if (a == std::string::npos || b == std::string::npos || c == std::string::npos) return false;
+        s.id = item.substr(0, a);
+        s.name = item.substr(a + 1, b - a - 1);
+        if (parseFixInt(std::string_view(item).substr(b + 1, c - b - 1), s.digits) != FixNumError::None ||
+            parseFixPrice(std::string_view(item).substr(c + 1), s.digits, s.start_ticks) != FixNumError::None) {
+            return false;
+        }
+        out.push_back(s);
+    }
+    return !out.empty();
+}
+
+bool parseEvent(const std::string& spec, SimEvent& e) {
+    size_t a = spec.find(':');
+    if (a == std::string::npos) return false;
+    e.at_ns = static_cast<int64_t>(std::atof(spec.substr(0, a).c_str()) * 1e9);
+    std::string rest = spec.substr(a + 1);
+    size_t b = rest.find(':');
+    std::string action = rest.substr(0, b);
+    e.value = b == std::string::npos ? 0 : std::atoll(rest.c_str() + b + 1);
+    if (action == "gap" && e.value > 0) e.action = SimAction::Gap;
+    else if (action == "drop") e.action = SimAction::Drop;
+    else if (action == "logout") e.action = SimAction::Logout;
+    else if (action == "rate" && e.value >= 0) e.action = SimAction::Rate;
+    else return false;
+    return true;
+}
+
+bool parseArgs(int argc, char** argv) {
+    parseSymbols("41:XAUUSD:2:2650.00,42:XAGUSD:3:31.000", g_sim.symbols);
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+            return false;
+        }
+        std::string v = argv[++i];
+        if (arg == "--port") g_sim.ports.push_back(static_cast<uint16_t>(std::atoi(v.c_str())));
+        else if (arg == "--cert") g_sim.cert_file = v;
+        else if (arg == "--key") g_sim.key_file = v;
+        else if (arg == "--rate") g_sim.rate = std::atoll(v.c_str());
+        else if (arg == "--entries") g_sim.entries = std::max(1, std::atoi(v.c_str()));
+        else if (arg == "--stream") g_sim.stream_snapshots = (v == "W");
+        else if (arg == "--duration") g_sim.duration_sec = std::atoll(v.c_str());
+        else if (arg == "--time") {
+            if (!parseFixTimePrecision(v, g_sim.precision)) {
+                std::fprintf(stderr, "bad --time %s\n", v.c_str());
+                return false;
+            }
+        } else if (arg == "--symbols") {
+            if (!parseSymbols(v, g_sim.symbols)) {
+                std::fprintf(stderr, "bad --symbols %s\n", v.c_str());
+                return false;
+            }
+        } else if (arg == "--at") {
+            SimEvent e;
+            if (!parseEvent(v, e)) {
+                std::fprintf(stderr, "bad --at %s\n", v.c_str());
+                return false;
+            }
+            g_sim.script.push_back(e);
+        } else {
+            std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+            return false;
+        }
+    }
+    if (g_sim.ports.empty()) g_sim.ports.push_back(9443);
+    std::stable_sort(g_sim.script.begin(), g_sim.script.end(),
+                     [](const SimEvent& a, const SimEvent& b) { return a.at_ns < b.at_ns; });
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (!parseArgs(argc, argv)) return 2;
+    plat::init();
+    std::signal(SIGINT, [](int) { g_running = false; });
+    std::signal(SIGTERM, [](int) { g_running = false; });
+
+    SSL_CTX* ctx = SSL_CTX_new(TLS_server_method());
+    bool cert_ok = g_sim.cert_file.empty()
+        ? useSelfSigned(ctx)
+        : SSL_CTX_use_certificate_chain_file(ctx, g_sim.cert_file.c_str()) == 1 &&
+          SSL_CTX_use_PrivateKey_file(ctx, g_sim.key_file.c_str(), SSL_FILETYPE_PEM) == 1;
+    if (!cert_ok) {
+        std::fprintf(stderr, "[SIM] certificate setup failed\n");
+        ERR_print_errors_fp(stderr);
+        return 1;
+    }
+
+    std::vector<std::thread> acceptors;
+    for (uint16_t port : g_sim.ports) acceptors.emplace_back(acceptLoop, ctx, port);
+
+    uint64_t prev_md = 0, prev_bytes = 0;
+    int64_t started = nowNs();
+    while (g_running.load()) {
+        plat::sleep_us(1000000);
+        uint64_t md = g_totals.md_messages.load(), bytes = g_totals.bytes.load();
+        std::printf("[SIM] sessions %d  md %llu/s  %.2f MB/s  orders %llu  resends %llu  inbound gaps %llu\n",
+                    g_totals.sessions.load(),
+                    static_cast<unsigned long long>(md - prev_md),
+                    static_cast<double>(bytes - prev_bytes) / 1e6,
+                    static_cast<unsigned long long>(g_totals.orders.load()),
+                    static_cast<unsigned long long>(g_totals.resend_requests.load()),
+                    static_cast<unsigned long long>(g_totals.inbound_gaps.load()));
+        std::fflush(stdout);
+        prev_md = md;
+        prev_bytes = bytes;
+        if (g_sim.duration_sec && nowNs() - started >= g_sim.duration_sec * 1000000000LL) g_running = false;
+    }
+
+    for (std::thread& t : acceptors) t.join();
+    // Session threads notice g_running within one poll interval
+    plat::sleep_us(200000);
+    SSL_CTX_free(ctx);
+    plat::cleanup();
+    return 0;
+}
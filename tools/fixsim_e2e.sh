@@ -0,0 +1,64 @@
+#!/usr/bin/env bash
+# fixsim_e2e.sh - Run ChimeraMetal against fix_acceptor_sim on loopback and
+# report what the client measured: feed latency and connect timing from the
+# dashboard, throughput from the simulator.
+#
+# Usage: tools/fixsim_e2e.sh [ChimeraMetal] [fix_acceptor_sim] [rate] [seconds] [sim options...]
+#   tools/fixsim_e2e.sh build/ChimeraMetal build/tools/fix_acceptor_sim 100000 10
+#   tools/fixsim_e2e.sh ... 10000 20 --at 5:drop          # reconnect every 5s
+# Exit status: 0 if the client logged on at least once.
+
+set -u
+
+BIN=${1:-build/ChimeraMetal}
+SIM=${2:-build/tools/fix_acceptor_sim}
+RATE=${3:-10000}
+SECS=${4:-10}
+shift $(( $# < 4 ? $# : 4 ))
+PORT=${FIXSIM_PORT:-19443}
+DASH=${FIXSIM_DASHBOARD_PORT:-18080}
+WORK=$(mktemp -d)
+trap 'kill $SIM_PID 2>/dev/null; rm -rf "$WORK"' EXIT
+
+for f in "$BIN" "$SIM"; do
+  if [ ! -x "$f" ]; then
+    echo "binary not found: $f" >&2
+    exit 1
+  fi
+done
+
+"$SIM" --port "$PORT" --rate "$RATE" "$@" > "$WORK/sim.log" 2>&1 &
+SIM_PID=$!
+sleep 0.5
+
+cat > "$WORK/config.ini" <<CFG
+[fix]
+host = 127.0.0.1
+port = $PORT
+sender_comp_id = E2E
+target_comp_id = FIXSIM
+target_sub_id = QUOTE
+username = e2e
+password = e2e
+heartbeat_interval = 30
+reset_seq_num = Y
+${FIXSIM_FIX_EXTRA:-}
+
+[dashboard]
+port = $DASH
+CFG
+
+"$BIN" "$WORK/config.ini" > "$WORK/client.log" 2>&1 &
+CLIENT_PID=$!
+sleep "$SECS"
+DATA=$(curl -s --max-time 2 "http://127.0.0.1:$DASH/data" || true)
+kill -INT $CLIENT_PID 2>/dev/null
+wait $CLIENT_PID 2>/dev/null
+
+echo "simulator:"
+grep -a '^\[SIM' "$WORK/sim.log" | tail -n 4 | sed 's/^/  /'
+echo "client:"
+grep -a 'Connect timing' "$WORK/client.log" | sed 's/^/  /'
+echo "  dashboard: ${DATA:-<no response>}"
+
+grep -aq 'LOGON SUCCESSFUL' "$WORK/client.log"
@@ -0,0 +1,87 @@
+#!/usr/bin/env bash
+# ktls_smoke.sh - Connect ChimeraMetal to a local `openssl s_server` with
+# ktls = true and report whether send/recv ran in the kernel or in OpenSSL.
+#
+# Usage: tools/ktls_smoke.sh [path/to/ChimeraMetal] [port]
+# Exit status: 0 logon reached the server (either path), 1 otherwise.
+# KTLS_REQUIRE=1 additionally fails unless both directions were offloaded.
+# KTLS_TLS13=1 runs TLS 1.3, whose post-handshake NewSessionTicket must not
+# break an offloaded receive (needs OpenSSL 3.2+ for TLS 1.3 receive offload).
+#
+# kTLS needs the kernel `tls` module (modprobe tls), an OpenSSL built with
+# enable-ktls, and a TLS 1.2 AES-GCM cipher for receive offload in 3.0.
+
+set -u
+
+BIN=${1:-build/ChimeraMetal}
+PORT=${2:-14443}
+WORK=$(mktemp -d)
+trap 'kill $SERVER_PID 2>/dev/null; rm -rf "$WORK"' EXIT
+
+if [ ! -x "$BIN" ]; then
+  echo "ChimeraMetal binary not found: $BIN" >&2
+  exit 1
+fi
+
+if grep -qw tls /proc/sys/net/ipv4/tcp_available_ulp 2>/dev/null; then
+  echo "kernel: tls ULP available"
+else
+  echo "kernel: tls ULP not loaded (modprobe tls); expect the OpenSSL path"
+fi
+
+openssl req -x509 -newkey rsa:2048 -nodes -days 1 -subj /CN=localhost \
+  -keyout "$WORK/key.pem" -out "$WORK/cert.pem" >/dev/null 2>&1
+
+TLS_ARGS="-tls1_2 -cipher ECDHE-RSA-AES128-GCM-SHA256"
+if [ "${KTLS_TLS13:-0}" = "1" ]; then
+  TLS_ARGS="-tls1_3 -ciphersuites TLS_AES_128_GCM_SHA256"
+fi
+
+SERVER_KTLS=""
+if openssl s_server -help 2>&1 | grep -q -- '-ktls'; then
+  SERVER_KTLS="-ktls"
+fi
+
+# Held-open stdin so s_server does not see EOF and hang up
+mkfifo "$WORK/stdin"
+sleep 30 > "$WORK/stdin" &
+openssl s_server -accept "$PORT" -cert "$WORK/cert.pem" -key "$WORK/key.pem" \
+  $TLS_ARGS $SERVER_KTLS -quiet \
+  < "$WORK/stdin" > "$WORK/server.log" 2>&1 &
+SERVER_PID=$!
+sleep 1
+
+cat > "$WORK/config.ini" <<EOF
+[fix]
+host = 127.0.0.1
+port = $PORT
+sender_comp_id = KTLS_SMOKE
+target_comp_id = LOCAL
+target_sub_id = QUOTE
+username = smoke
+password = smoke
+heartbeat_interval = 30
+reset_seq_num = Y
+ktls = true
+
+[dashboard]
+port = 0
+EOF
+
+timeout -s INT 4 "$BIN" "$WORK/config.ini" > "$WORK/client.log" 2>&1
+
+grep -a '\[FIX\] kTLS:' "$WORK/client.log" || echo "client: no kTLS line (not connected?)"
+
+if ! grep -aq '35=A' "$WORK/server.log"; then
+  echo "FAIL: server did not receive the Logon"
+  sed -n '1,20p' "$WORK/client.log"
+  exit 1
+fi
+echo "OK: Logon received by s_server"
+
+if [ "${KTLS_REQUIRE:-0}" = "1" ] &&
+   ! grep -aq 'kTLS: send kernel, recv kernel' "$WORK/client.log"; then
+  echo "FAIL: KTLS_REQUIRE=1 but not fully offloaded"
+  exit 1
+fi
+exit 0